@@ -0,0 +1,157 @@
+#include "Benchmark.h"
+#include "CoreLogic.h"
+#include "Configuration.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <cmath>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+Benchmark::Benchmark(CoreLogic& pCoreLogic):
+    mCoreLogic(pCoreLogic),
+    mCircuitGenerator(&pCoreLogic)
+{}
+
+bool Benchmark::Run(const QString& pOutputPath, uint32_t pScale)
+{
+    Q_ASSERT(pScale > 0);
+
+    QJsonArray results;
+
+    results.append(RunCircuit("ripple_adder", benchmark::RIPPLE_ADDER_BIT_WIDTH * pScale, [&]()
+    {
+        return mCircuitGenerator.GenerateRippleAdder(benchmark::RIPPLE_ADDER_BIT_WIDTH * pScale);
+    }));
+
+    results.append(RunCircuit("counter_chain", benchmark::COUNTER_CHAIN_LENGTH * pScale, [&]()
+    {
+        return mCircuitGenerator.GenerateCounterChain(benchmark::COUNTER_CHAIN_LENGTH * pScale);
+    }));
+
+    results.append(RunCircuit("lfsr_array", benchmark::LFSR_COUNT * pScale, [&]()
+    {
+        return mCircuitGenerator.GenerateLfsrArray(benchmark::LFSR_COUNT * pScale);
+    }));
+
+    // The mesh grows quadratically, so its edge length is only scaled by the square root
+    const uint32_t meshSize = benchmark::WIRE_MESH_SIZE * std::sqrt(pScale);
+    results.append(RunCircuit("wire_mesh", meshSize, [&]()
+    {
+        return mCircuitGenerator.GenerateWireMesh(meshSize);
+    }));
+
+    QJsonObject json;
+    json["version"] = QString(FULL_VERSION);
+    json["scale"] = static_cast<int32_t>(pScale);
+    json["ticks"] = static_cast<int32_t>(benchmark::SIMULATION_TICKS);
+    json["results"] = results;
+
+    const auto data = QJsonDocument(json).toJson(QJsonDocument::Indented);
+
+    QFile outputFile(pOutputPath);
+    bool isOpen = false;
+
+    if (pOutputPath == "-")
+    {
+        isOpen = outputFile.open(stdout, QIODevice::WriteOnly);
+    }
+    else
+    {
+        isOpen = outputFile.open(QIODevice::WriteOnly);
+    }
+
+    return isOpen && (outputFile.write(data) == data.size());
+}
+
+QJsonObject Benchmark::RunCircuit(const QString& pName, uint32_t pSize, const std::function<QJsonObject(void)>& pGenerate)
+{
+    QJsonObject result;
+    result["circuit"] = pName;
+    result["size"] = static_cast<int32_t>(pSize);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto circuit = pGenerate();
+    result["components"] = circuit[file::JSON_COMPONENTS_IDENTIFIER].toArray().size();
+    result["generate_ms"] = timer.nsecsElapsed() / 1e6;
+
+    const QFileInfo fileInfo(QDir::temp().filePath(benchmark::TEMPORARY_FILE_NAME));
+    const auto lastFilePath = mCoreLogic.GetRuntimeConfigParser().GetLastFilePath();
+
+    // The generated circuit only exists as JSON, it has to be written once to be loaded into the scene
+    mCoreLogic.GetCircuitFileParser().SaveJsonAs(fileInfo, circuit);
+
+    timer.restart();
+    mCoreLogic.GetCircuitFileParser().LoadJson(fileInfo);
+    result["load_ms"] = timer.nsecsElapsed() / 1e6;
+
+    // Save the loaded circuit the same way the save action does
+    timer.restart();
+    mCoreLogic.SaveCircuitAs(fileInfo);
+    result["save_ms"] = timer.nsecsElapsed() / 1e6;
+    result["file_bytes"] = QFileInfo(fileInfo.absoluteFilePath()).size();
+
+    mCoreLogic.EnterControlMode(ControlMode::SIMULATION);
+    mCoreLogic.PauseSimulation(); // Entering the simulation starts the propagation timer, ticks are stepped manually below
+
+    const auto& setupTimings = mCoreLogic.GetSimulationSetupTimings();
+    result["enter_simulation_ms"] = setupTimings.total.count() / 1e6;
+    result["parse_wire_groups_ms"] = setupTimings.parseWireGroups.count() / 1e6;
+    result["create_wire_logic_cells_ms"] = setupTimings.createWireLogicCells.count() / 1e6;
+    result["connect_logic_cells_ms"] = setupTimings.connectLogicCells.count() / 1e6;
+    result["netlist_cached"] = setupTimings.isNetlistCached;
+
+    timer.restart();
+    for (uint32_t tick = 0; tick < benchmark::SIMULATION_TICKS; tick++)
+    {
+        mCoreLogic.StepSimulation();
+    }
+    result["ticks_per_second"] = benchmark::SIMULATION_TICKS / std::max(timer.nsecsElapsed() / 1e9, 1e-9);
+
+    // The peak is process-wide, so it includes all circuits benchmarked before this one
+    result["cumulative_peak_rss_kb"] = static_cast<qint64>(GetPeakResidentSetSize());
+
+    mCoreLogic.EnterControlMode(ControlMode::EDIT);
+    mCoreLogic.NewCircuit();
+
+    // Do not leave traces of the benchmark in the recent files
+    QFile::remove(fileInfo.absoluteFilePath());
+    QFile::remove(NetlistCache::GetSidecarPath(fileInfo));
+    mCoreLogic.GetRuntimeConfigParser().RemoveRecentFilePath(fileInfo);
+    mCoreLogic.GetRuntimeConfigParser().SetLastFilePath(lastFilePath);
+
+    return result;
+}
+
+uint64_t Benchmark::GetPeakResidentSetSize() const
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss; // Kilobytes on Linux
+#endif
+#endif
+}
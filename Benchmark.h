@@ -0,0 +1,45 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "CircuitGenerator.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <functional>
+
+class CoreLogic;
+
+///
+/// \brief The Benchmark class measures file I/O, simulation setup and tick throughput on generated circuits
+///
+class Benchmark
+{
+public:
+    /// \brief Constructor for the Benchmark
+    /// \param pCoreLogic: Reference to the core logic to run the benchmark on
+    Benchmark(CoreLogic& pCoreLogic);
+
+    /// \brief Runs the benchmark on all generated circuits and writes the results as JSON
+    /// \param pOutputPath: The path of the result file, or "-" to write to stdout
+    /// \param pScale: Factor by which the default circuit sizes are multiplied
+    /// \return False, if the results could not be written
+    bool Run(const QString& pOutputPath, uint32_t pScale);
+
+protected:
+    /// \brief Generates, saves, loads and simulates one circuit
+    /// \param pName: The name of the circuit in the results
+    /// \param pSize: The size parameter that has been passed to the generator
+    /// \param pGenerate: Function that generates the circuit JSON
+    /// \return The measurements as JSON object
+    QJsonObject RunCircuit(const QString& pName, uint32_t pSize, const std::function<QJsonObject(void)>& pGenerate);
+
+    /// \brief Returns the peak resident set size of this process since it has been started, not per circuit
+    /// \return The peak resident set size in kilobytes, or 0 if unsupported on this platform
+    uint64_t GetPeakResidentSetSize(void) const;
+
+protected:
+    CoreLogic& mCoreLogic;
+    CircuitGenerator mCircuitGenerator;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,133 @@
+#include "ChunkedCompressionDevice.h"
+#include "Configuration.h"
+
+#include <QtEndian>
+#include <algorithm>
+#include <memory>
+
+ChunkedCompressionDevice::ChunkedCompressionDevice(QIODevice& pTarget):
+    mTarget(pTarget)
+{}
+
+ChunkedCompressionDevice::~ChunkedCompressionDevice()
+{
+    if (isOpen())
+    {
+        close();
+    }
+}
+
+bool ChunkedCompressionDevice::open(OpenMode pMode)
+{
+    if (pMode != QIODevice::WriteOnly || !mTarget.isWritable())
+    {
+        return false;
+    }
+
+    char version[4];
+    qToBigEndian<uint32_t>(file::CONTAINER_VERSION, version);
+
+    mIsWritten = (mTarget.write(file::CONTAINER_MAGIC, 4) == 4) && (mTarget.write(version, sizeof(version)) == sizeof(version));
+    mChunk.reserve(file::CONTAINER_CHUNK_SIZE);
+
+    return mIsWritten && QIODevice::open(pMode);
+}
+
+void ChunkedCompressionDevice::close()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    if (!mChunk.isEmpty())
+    {
+        SubmitChunk();
+    }
+
+    WritePendingChunks(0);
+
+    // An empty chunk marks the end of the container
+    const char end[8] = {};
+    mIsWritten &= (mTarget.write(end, sizeof(end)) == sizeof(end));
+
+    QIODevice::close();
+}
+
+bool ChunkedCompressionDevice::isSequential() const
+{
+    return true;
+}
+
+bool ChunkedCompressionDevice::IsWritten() const
+{
+    return mIsWritten;
+}
+
+qint64 ChunkedCompressionDevice::readData(char *pData, qint64 pMaxSize)
+{
+    Q_UNUSED(pData);
+    Q_UNUSED(pMaxSize);
+    return -1;
+}
+
+qint64 ChunkedCompressionDevice::writeData(const char *pData, qint64 pSize)
+{
+    qint64 written = 0;
+
+    while (written < pSize)
+    {
+        const auto size = std::min<qint64>(pSize - written, file::CONTAINER_CHUNK_SIZE - mChunk.size());
+        mChunk.append(pData + written, size);
+        written += size;
+
+        if (mChunk.size() == file::CONTAINER_CHUNK_SIZE)
+        {
+            SubmitChunk();
+        }
+    }
+
+    return mIsWritten ? pSize : -1;
+}
+
+void ChunkedCompressionDevice::SubmitChunk()
+{
+    auto promise = std::make_shared<std::promise<QByteArray>>();
+    mPendingChunks.push_back(PendingChunk{static_cast<uint32_t>(mChunk.size()), promise->get_future()});
+
+    mThreadPool.start([promise, chunk = mChunk]()
+    {
+        promise->set_value(qCompress(chunk, file::CONTAINER_COMPRESSION_LEVEL));
+    });
+
+    mChunk = QByteArray(); // The compressing thread holds the only reference to the full chunk now
+    mChunk.reserve(file::CONTAINER_CHUNK_SIZE);
+
+    // A few chunks per thread keep all threads busy while the writer fills the next chunk
+    WritePendingChunks(2 * std::max(1, mThreadPool.maxThreadCount()));
+}
+
+void ChunkedCompressionDevice::WritePendingChunks(size_t pMaxPendingChunks)
+{
+    while (!mPendingChunks.empty())
+    {
+        auto& chunk = mPendingChunks.front();
+
+        // Chunks are written in order, so only the oldest chunk is waited for
+        if (mPendingChunks.size() <= pMaxPendingChunks && chunk.compressed.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            break;
+        }
+
+        const auto compressed = chunk.compressed.get();
+
+        char sizes[8];
+        qToBigEndian<uint32_t>(compressed.size(), sizes);
+        qToBigEndian<uint32_t>(chunk.uncompressedSize, sizes + 4);
+
+        mIsWritten &= (mTarget.write(sizes, sizeof(sizes)) == sizeof(sizes));
+        mIsWritten &= (mTarget.write(compressed) == compressed.size());
+
+        mPendingChunks.pop_front();
+    }
+}
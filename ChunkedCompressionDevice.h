@@ -0,0 +1,78 @@
+#ifndef CHUNKEDCOMPRESSIONDEVICE_H
+#define CHUNKEDCOMPRESSIONDEVICE_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QThreadPool>
+#include <deque>
+#include <future>
+
+///
+/// \brief The ChunkedCompressionDevice class compresses all data written to it into the chunked container format
+/// and writes the container to a target device on the fly. Full chunks are compressed in parallel while writing continues,
+/// only a few chunks per thread are kept in memory, so that the memory usage does not depend on the amount of data.
+///
+class ChunkedCompressionDevice : public QIODevice
+{
+public:
+    /// \brief Constructor for the ChunkedCompressionDevice
+    /// \param pTarget: The opened device to write the container into, it must outlive this device
+    ChunkedCompressionDevice(QIODevice& pTarget);
+
+    /// \brief Destructor for the ChunkedCompressionDevice, finishes the container if the device is still open
+    ~ChunkedCompressionDevice(void) override;
+
+    /// \brief Opens the device and writes the container header to the target, only write-only mode is supported
+    /// \param pMode: The open mode
+    /// \return False, if the mode is not write-only or the header could not be written
+    bool open(OpenMode pMode) override;
+
+    /// \brief Compresses the remaining data, writes the end of the container and closes the device
+    void close(void) override;
+
+    /// \brief Returns true, because the compressed data cannot be read back or seeked
+    /// \return True
+    bool isSequential(void) const override;
+
+    /// \brief Returns whether all data has been written into the target so far, check it after close()
+    /// \return True, if no write to the target has failed
+    bool IsWritten(void) const;
+
+protected:
+    /// \brief Reading is not supported
+    /// \param pData: Unused
+    /// \param pMaxSize: Unused
+    /// \return Always -1
+    qint64 readData(char *pData, qint64 pMaxSize) override;
+
+    /// \brief Appends the data to the current chunk, full chunks are passed on for compression
+    /// \param pData: The data to write
+    /// \param pSize: The size of the data
+    /// \return The size of the data, or -1 if writing to the target has failed
+    qint64 writeData(const char *pData, qint64 pSize) override;
+
+    /// \brief Starts the compression of the current chunk on the thread pool and starts a new chunk
+    void SubmitChunk(void);
+
+    /// \brief Writes the compressed chunks into the target in order, waits for the oldest chunks while too many are pending
+    /// \param pMaxPendingChunks: The amount of chunks that may remain pending
+    void WritePendingChunks(size_t pMaxPendingChunks);
+
+protected:
+    /// \brief PendingChunk contains a chunk that is being compressed on the thread pool
+    struct PendingChunk
+    {
+        uint32_t uncompressedSize;
+        std::future<QByteArray> compressed;
+    };
+
+    QIODevice& mTarget;
+
+    QByteArray mChunk;
+    std::deque<PendingChunk> mPendingChunks;
+    QThreadPool mThreadPool;
+
+    bool mIsWritten = true;
+};
+
+#endif // CHUNKEDCOMPRESSIONDEVICE_H
@@ -0,0 +1,253 @@
+#include "CircuitExporter.h"
+#include "PngStreamWriter.h"
+#include "Configuration.h"
+#include "Components/IBaseComponent.h"
+#include "Components/LogicWire.h"
+
+#include <QFileInfo>
+#include <QStyleOptionGraphicsItem>
+#include <QSvgGenerator>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+CircuitExporter::CircuitExporter(const QGraphicsScene& pScene, std::function<void(void)> pHeartbeat):
+    mScene(pScene),
+    mHeartbeat(pHeartbeat)
+{}
+
+bool CircuitExporter::Export(const QString& pFilePath, double pScale, bool pOnlySelection)
+{
+    mError.clear();
+    mOnlySelection = pOnlySelection;
+    mSelectedItems.clear();
+
+    const auto suffix = QFileInfo(pFilePath).suffix().toLower();
+
+    if (suffix != image_export::PNG_SUFFIX && suffix != image_export::SVG_SUFFIX)
+    {
+        mError = QString("Unsupported image format \"%0\", use .%1 or .%2").arg(suffix).arg(image_export::PNG_SUFFIX).arg(image_export::SVG_SUFFIX);
+        return false;
+    }
+
+    if (!(pScale >= image_export::MIN_SCALE && pScale <= image_export::MAX_SCALE))
+    {
+        mError = QString("The scale must be between %0 and %1").arg(image_export::MIN_SCALE).arg(image_export::MAX_SCALE);
+        return false;
+    }
+
+    QRectF sourceRect;
+
+    for (const auto& item : (pOnlySelection ? mScene.selectedItems() : mScene.items()))
+    {
+        if (nullptr == dynamic_cast<IBaseComponent*>(item))
+        {
+            continue;
+        }
+
+        if (pOnlySelection)
+        {
+            mSelectedItems.insert(item);
+        }
+
+        sourceRect = sourceRect.united(item->sceneBoundingRect());
+    }
+
+    if (sourceRect.isNull())
+    {
+        mError = pOnlySelection ? QString("No components are selected") : QString("The circuit is empty");
+        return false;
+    }
+
+    sourceRect.adjust(-image_export::MARGIN, -image_export::MARGIN, image_export::MARGIN, image_export::MARGIN);
+
+    const QSize size(static_cast<int32_t>(std::ceil(sourceRect.width() * pScale)), static_cast<int32_t>(std::ceil(sourceRect.height() * pScale)));
+
+    if (suffix == image_export::SVG_SUFFIX)
+    {
+        return ExportSvg(pFilePath, sourceRect, size, pScale);
+    }
+
+    if (size.width() > image_export::MAX_RASTER_SIZE || size.height() > image_export::MAX_RASTER_SIZE)
+    {
+        mError = QString("The image would be %0 x %1 pixels, PNG images are limited to %2 pixels per side. Use a smaller scale or export as .%3")
+                .arg(size.width()).arg(size.height()).arg(image_export::MAX_RASTER_SIZE).arg(image_export::SVG_SUFFIX);
+        return false;
+    }
+
+    return ExportPng(pFilePath, sourceRect, size, pScale);
+}
+
+const QString& CircuitExporter::GetError() const
+{
+    return mError;
+}
+
+bool CircuitExporter::ExportPng(const QString& pFilePath, const QRectF& pSourceRect, QSize pSize, double pScale)
+{
+    PngStreamWriter writer;
+
+    if (!writer.Open(pFilePath, pSize.width(), pSize.height()))
+    {
+        mError = QString("Could not create %0").arg(pFilePath);
+        return false;
+    }
+
+    // One row of tiles is rendered before its pixel rows are written, the tiles are reused for every row
+    const int32_t tileColumns = (pSize.width() + image_export::TILE_SIZE - 1) / image_export::TILE_SIZE;
+    std::vector<QImage> tiles(tileColumns);
+    std::vector<QRgb> pixelRow(pSize.width());
+
+    for (int32_t tileTop = 0; tileTop < pSize.height(); tileTop += image_export::TILE_SIZE)
+    {
+        const int32_t tileHeight = std::min(image_export::TILE_SIZE, pSize.height() - tileTop);
+
+        for (int32_t column = 0; column < tileColumns; column++)
+        {
+            const int32_t tileLeft = column * image_export::TILE_SIZE;
+            RenderTile(tiles[column], QRect(tileLeft, tileTop, std::min(image_export::TILE_SIZE, pSize.width() - tileLeft), tileHeight), pSourceRect, pScale);
+            Heartbeat();
+        }
+
+        for (int32_t y = 0; y < tileHeight; y++)
+        {
+            for (int32_t column = 0; column < tileColumns; column++)
+            {
+                std::memcpy(&pixelRow[column * image_export::TILE_SIZE], tiles[column].constScanLine(y), tiles[column].width() * sizeof(QRgb));
+            }
+
+            if (!writer.WriteRow(pixelRow.data()))
+            {
+                mError = QString("Could not write %0").arg(pFilePath);
+                return false;
+            }
+        }
+    }
+
+    if (!writer.Finish())
+    {
+        mError = QString("Could not write %0").arg(pFilePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool CircuitExporter::ExportSvg(const QString& pFilePath, const QRectF& pSourceRect, QSize pSize, double pScale)
+{
+    // Vector output is not tiled, components crossing tile borders would be written once per tile
+    QSvgGenerator generator;
+    generator.setFileName(pFilePath);
+    generator.setSize(pSize);
+    generator.setViewBox(QRect(QPoint(0, 0), pSize));
+    generator.setTitle(QFileInfo(pFilePath).completeBaseName());
+    generator.setDescription("Exported from Linkuit Studio");
+
+    QPainter painter;
+
+    if (!painter.begin(&generator))
+    {
+        mError = QString("Could not create %0").arg(pFilePath);
+        return false;
+    }
+
+    painter.fillRect(QRect(QPoint(0, 0), pSize), canvas::BACKGROUND_COLOR);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+    painter.scale(pScale, pScale);
+    painter.translate(-pSourceRect.topLeft());
+
+    PaintItems(painter, pSourceRect);
+
+    if (!painter.end())
+    {
+        mError = QString("Could not write %0").arg(pFilePath);
+        return false;
+    }
+
+    return true;
+}
+
+void CircuitExporter::RenderTile(QImage& pTile, const QRect& pPixelRect, const QRectF& pSourceRect, double pScale)
+{
+    if (pTile.size() != pPixelRect.size())
+    {
+        pTile = QImage(pPixelRect.size(), QImage::Format_RGB32);
+    }
+
+    pTile.fill(canvas::BACKGROUND_COLOR);
+
+    QPainter painter(&pTile);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+    painter.translate(-pPixelRect.topLeft());
+    painter.scale(pScale, pScale);
+    painter.translate(-pSourceRect.topLeft());
+
+    PaintItems(painter, QRectF(pSourceRect.topLeft() + QPointF(pPixelRect.topLeft()) / pScale, QSizeF(pPixelRect.size()) / pScale));
+}
+
+void CircuitExporter::PaintItems(QPainter& pPainter, const QRectF& pRect)
+{
+    // Wider than the rectangle by the wire width, so that line caps reaching into it are drawn as well
+    const auto items = mScene.items(pRect.adjusted(-components::wires::WIRE_WIDTH, -components::wires::WIRE_WIDTH,
+                                                   components::wires::WIRE_WIDTH, components::wires::WIRE_WIDTH),
+                                    Qt::IntersectsItemBoundingRect, Qt::AscendingOrder);
+
+    // Wires have no contents of their own, they are drawn below all other components like the wire layer does
+    for (const auto& item : items)
+    {
+        const auto wire = dynamic_cast<const LogicWire*>(item);
+
+        if (nullptr != wire && wire->isVisible() && IsExported(wire))
+        {
+            pPainter.setPen(QPen(wire->GetColor(false), components::wires::WIRE_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+            pPainter.drawLine(wire->GetLine());
+        }
+    }
+
+    QStyleOptionGraphicsItem option;
+    option.state = QStyle::State_None; // Exported components are drawn unselected
+    uint32_t paintedItems = 0;
+
+    for (const auto& item : items)
+    {
+        // Child items like the text editor of text labels are painted after their parents, at their own transform
+        if ((item->flags() & QGraphicsItem::ItemHasNoContents) || !item->isVisible() || !IsExported(item))
+        {
+            continue;
+        }
+
+        option.exposedRect = item->boundingRect();
+        option.rect = option.exposedRect.toAlignedRect();
+
+        pPainter.save();
+        pPainter.setTransform(item->sceneTransform(), true);
+        pPainter.setOpacity(item->effectiveOpacity());
+        item->paint(&pPainter, &option, nullptr);
+        pPainter.restore();
+
+        if (++paintedItems % image_export::ITEMS_PER_HEARTBEAT == 0)
+        {
+            Heartbeat();
+        }
+    }
+}
+
+bool CircuitExporter::IsExported(const QGraphicsItem* pItem) const
+{
+    const auto component = pItem->topLevelItem();
+
+    if (mOnlySelection)
+    {
+        return (mSelectedItems.find(component) != mSelectedItems.end());
+    }
+
+    return (nullptr != dynamic_cast<const IBaseComponent*>(component));
+}
+
+void CircuitExporter::Heartbeat()
+{
+    if (mHeartbeat)
+    {
+        mHeartbeat();
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef CIRCUITEXPORTER_H
+#define CIRCUITEXPORTER_H
+
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QString>
+#include <functional>
+#include <unordered_set>
+
+///
+/// \brief The CircuitExporter class renders the circuit of a scene, or its selection, to a PNG or SVG image.
+/// PNG images are rendered tile by tile into small offscreen images and streamed to the file row by row,
+/// so that the memory usage only depends on the image width. Components are drawn unselected and independent of the view.
+///
+class CircuitExporter
+{
+public:
+    /// \brief Constructor for the CircuitExporter
+    /// \param pScene: The scene containing the circuit
+    /// \param pHeartbeat: Called regularly during the export, e.g. to keep the GUI responsive, may be empty
+    CircuitExporter(const QGraphicsScene& pScene, std::function<void(void)> pHeartbeat = nullptr);
+
+    /// \brief Renders the circuit to the given file, the format is chosen by the suffix (.png or .svg)
+    /// \param pFilePath: The path of the image file to write
+    /// \param pScale: The size of one scene unit in pixels
+    /// \param pOnlySelection: If true, only the selected components are exported
+    /// \return False, if the image could not be exported, the reason is returned by GetError()
+    bool Export(const QString& pFilePath, double pScale, bool pOnlySelection);
+
+    /// \brief Getter for the reason the last export failed
+    /// \return The error message, or an empty string if the last export succeeded
+    const QString& GetError(void) const;
+
+protected:
+    /// \brief Writes the given area of the scene to a PNG file, tile by tile
+    /// \param pFilePath: The path of the PNG file to write
+    /// \param pSourceRect: The exported area in scene coordinates
+    /// \param pSize: The size of the image in pixels
+    /// \param pScale: The size of one scene unit in pixels
+    /// \return False, if the file could not be written
+    bool ExportPng(const QString& pFilePath, const QRectF& pSourceRect, QSize pSize, double pScale);
+
+    /// \brief Writes the given area of the scene to an SVG file in a single vector pass
+    /// \param pFilePath: The path of the SVG file to write
+    /// \param pSourceRect: The exported area in scene coordinates
+    /// \param pSize: The size of the image in pixels
+    /// \param pScale: The size of one scene unit in pixels
+    /// \return False, if the file could not be written
+    bool ExportSvg(const QString& pFilePath, const QRectF& pSourceRect, QSize pSize, double pScale);
+
+    /// \brief Renders one tile of the image
+    /// \param pTile: The image to render into, it is reallocated if its size doesn't match the tile
+    /// \param pPixelRect: The area of the tile in image pixels
+    /// \param pSourceRect: The exported area in scene coordinates
+    /// \param pScale: The size of one scene unit in pixels
+    void RenderTile(QImage& pTile, const QRect& pPixelRect, const QRectF& pSourceRect, double pScale);
+
+    /// \brief Paints all exported items intersecting the given rectangle, wires below all other components
+    /// \param pPainter: The painter to use, transformed to scene coordinates
+    /// \param pRect: The rectangle in scene coordinates
+    void PaintItems(QPainter& pPainter, const QRectF& pRect);
+
+    /// \brief Returns whether the given item belongs to an exported component
+    /// \param pItem: A component or a child item of a component
+    /// \return True, if the item is exported
+    bool IsExported(const QGraphicsItem* pItem) const;
+
+    /// \brief Calls the heartbeat function, if any
+    void Heartbeat(void);
+
+protected:
+    const QGraphicsScene& mScene;
+    std::function<void(void)> mHeartbeat;
+
+    bool mOnlySelection = false;
+    std::unordered_set<const QGraphicsItem*> mSelectedItems;
+
+    QString mError;
+};
+
+#endif // CIRCUITEXPORTER_H
@@ -1,5 +1,14 @@
 #include "CircuitFileParser.h"
 #include "Configuration.h"
+#include "ColumnarCircuitCodec.h"
+#include "ChunkedCompressionDevice.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QDebug>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <algorithm>
 
 CircuitFileParser::CircuitFileParser(RuntimeConfigParser& pRuntimeConfigParser):
     mIsCircuitModified(false),
@@ -16,11 +25,12 @@ void CircuitFileParser::LoadJson(const QFileInfo& pFileInfo, bool pIsFromRecents
         return;
     }
 
-    QByteArray rawData = loadFile.readAll();
+    // Mapped data is only read until it has been decompressed or parsed, while loadFile is still open
+    QByteArray rawData = MapFile(loadFile);
 
     if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
     {
-        rawData = qUncompress(rawData);
+        rawData = DecompressCircuit(rawData).value_or(QByteArray());
 
         if (rawData.isEmpty())
         {
@@ -29,11 +39,17 @@ void CircuitFileParser::LoadJson(const QFileInfo& pFileInfo, bool pIsFromRecents
             return;
         }
 
-        auto jsonDoc = QJsonDocument(QCborValue::fromCbor(rawData).toMap().toJsonObject());
+        const auto header = ReadCborHeader(rawData);
+
+        if (!header.has_value())
+        {
+            emit LoadCircuitFileFailedSignal(pFileInfo, pIsFromRecents);
+            return;
+        }
 
         mCurrentFile = pFileInfo;
         mRuntimeConfigParser.AddRecentFilePath(mCurrentFile.value());
-        emit LoadCircuitFileSuccessSignal(mCurrentFile.value(), jsonDoc.object());
+        emit LoadCircuitCborSuccessSignal(mCurrentFile.value(), header.value(), rawData);
     }
     else
     {
@@ -47,6 +63,284 @@ void CircuitFileParser::LoadJson(const QFileInfo& pFileInfo, bool pIsFromRecents
     mRuntimeConfigParser.SetLastFilePath(pFileInfo.path());
 }
 
+std::optional<QJsonObject> CircuitFileParser::ReadCborHeader(const QByteArray& pCbor)
+{
+    QCborStreamReader reader(pCbor);
+
+    if (!reader.isMap() || !reader.enterContainer())
+    {
+        return std::nullopt;
+    }
+
+    QJsonObject header;
+
+    while (reader.hasNext())
+    {
+        const auto key = QCborValue::fromCbor(reader).toString();
+
+        if (key == file::JSON_COMPONENTS_IDENTIFIER || key == file::JSON_COLUMNAR_IDENTIFIER)
+        {
+            reader.next(); // Skips the whole array without decoding it
+        }
+        else
+        {
+            header[key] = QCborValue::fromCbor(reader).toJsonValue();
+        }
+    }
+
+    if (reader.lastError() != QCborError::NoError)
+    {
+        return std::nullopt;
+    }
+
+    return header;
+}
+
+file::ComponentReadResult CircuitFileParser::ReadCborComponents(const QByteArray& pCbor, const std::function<bool(const QJsonObject&)>& pComponentHandler)
+{
+    QCborStreamReader reader(pCbor);
+
+    bool isStopped = false;
+    const auto handleComponent = [&isStopped, &pComponentHandler](const QJsonObject& pComponent)
+    {
+        isStopped = !pComponentHandler(pComponent);
+        return !isStopped;
+    };
+
+    // A reader error means that the data ends early or is damaged, otherwise it does not follow the format
+    const auto getFailure = [&isStopped, &reader]()
+    {
+        if (isStopped)
+        {
+            return file::ComponentReadResult::STOPPED;
+        }
+        return (reader.lastError() != QCborError::NoError) ? file::ComponentReadResult::TRUNCATED : file::ComponentReadResult::INVALID;
+    };
+
+    if (!reader.isMap() || !reader.enterContainer())
+    {
+        return getFailure();
+    }
+
+    std::optional<quint64> columnarVersion;
+
+    while (reader.hasNext())
+    {
+        const auto key = QCborValue::fromCbor(reader).toString();
+
+        if (key == file::JSON_COLUMNAR_VERSION_IDENTIFIER && reader.isUnsignedInteger())
+        {
+            columnarVersion = reader.toUnsignedInteger();
+            reader.next();
+            continue;
+        }
+
+        if (key == file::JSON_COLUMNAR_IDENTIFIER)
+        {
+            // The version is written before the groups, groups of unknown versions cannot be decoded
+            if (!columnarVersion.has_value() || columnarVersion.value() == 0 || columnarVersion.value() > file::COLUMNAR_VERSION)
+            {
+                qDebug() << "Columnar encoding version missing or unknown";
+                return file::ComponentReadResult::INVALID;
+            }
+
+            if (!ColumnarCircuitCodec::Read(reader, handleComponent))
+            {
+                return getFailure();
+            }
+            continue;
+        }
+
+        if (key != file::JSON_COMPONENTS_IDENTIFIER || !reader.isArray())
+        {
+            reader.next();
+            continue;
+        }
+
+        reader.enterContainer();
+        while (reader.hasNext())
+        {
+            if (!handleComponent(QCborValue::fromCbor(reader).toMap().toJsonObject()))
+            {
+                return file::ComponentReadResult::STOPPED;
+            }
+        }
+        reader.leaveContainer();
+    }
+
+    return (reader.lastError() == QCborError::NoError) ? file::ComponentReadResult::COMPLETE : file::ComponentReadResult::TRUNCATED;
+}
+
+QByteArray CircuitFileParser::CompressChunked(const QByteArray& pData)
+{
+    QByteArray container;
+    QBuffer buffer(&container);
+    buffer.open(QIODevice::WriteOnly);
+
+    ChunkedCompressionDevice compressor(buffer);
+    compressor.open(QIODevice::WriteOnly);
+    compressor.write(pData);
+    compressor.close();
+
+    return container;
+}
+
+std::optional<QByteArray> CircuitFileParser::DecompressChunked(const QByteArray& pContainer)
+{
+    QDataStream stream(pContainer);
+    stream.skipRawData(4); // Magic
+
+    uint32_t version = 0;
+    stream >> version;
+
+    if (stream.status() != QDataStream::Ok || version == 0 || version > file::CONTAINER_VERSION)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint32_t> compressedSizes;
+    std::vector<uint32_t> uncompressedSizes;
+    std::vector<qsizetype> compressedOffsets;
+
+    if (version == 1)
+    {
+        uint32_t chunkCount = 0;
+        stream >> chunkCount;
+
+        // Every chunk has an 8 byte index entry, which limits the chunk count of valid containers
+        if (stream.status() != QDataStream::Ok || chunkCount > pContainer.size() / 8)
+        {
+            return std::nullopt;
+        }
+
+        compressedSizes.resize(chunkCount);
+        uncompressedSizes.resize(chunkCount);
+
+        for (uint32_t i = 0; i < chunkCount; i++)
+        {
+            stream >> compressedSizes[i] >> uncompressedSizes[i];
+        }
+
+        qsizetype offset = stream.device()->pos();
+        for (uint32_t i = 0; i < chunkCount; i++)
+        {
+            compressedOffsets.push_back(offset);
+            offset += compressedSizes[i];
+        }
+
+        if (stream.status() != QDataStream::Ok || offset > pContainer.size())
+        {
+            return std::nullopt;
+        }
+    }
+    else
+    {
+        // The sizes precede every chunk, the chunks are skipped to collect the index before decompressing them in parallel
+        while (true)
+        {
+            uint32_t compressedSize = 0;
+            uint32_t uncompressedSize = 0;
+            stream >> compressedSize >> uncompressedSize;
+
+            if (stream.status() != QDataStream::Ok)
+            {
+                return std::nullopt; // Truncated before the end of the container
+            }
+
+            if (compressedSize == 0 && uncompressedSize == 0)
+            {
+                break;
+            }
+
+            compressedOffsets.push_back(stream.device()->pos());
+            compressedSizes.push_back(compressedSize);
+            uncompressedSizes.push_back(uncompressedSize);
+
+            if (stream.skipRawData(compressedSize) != static_cast<int32_t>(compressedSize))
+            {
+                return std::nullopt;
+            }
+        }
+    }
+
+    const uint32_t chunkCount = compressedSizes.size();
+    std::vector<qsizetype> uncompressedOffsets(chunkCount);
+    qsizetype uncompressedTotal = 0;
+
+    for (uint32_t i = 0; i < chunkCount; i++)
+    {
+        // The sizes are read from the file, they must be validated before the output buffer is allocated.
+        // All chunks lie within the container, so bounding every chunk by its compressed size bounds the total by the file size.
+        if (uncompressedSizes[i] > file::CONTAINER_CHUNK_SIZE
+                || uncompressedSizes[i] > static_cast<uint64_t>(compressedSizes[i]) * file::CONTAINER_MAX_COMPRESSION_RATIO)
+        {
+            return std::nullopt;
+        }
+
+        uncompressedOffsets[i] = uncompressedTotal;
+        uncompressedTotal += uncompressedSizes[i];
+    }
+
+    QByteArray data(uncompressedTotal, Qt::Uninitialized);
+    char* const target = data.data(); // Taken before the workers start, so no thread can trigger a detach
+    std::vector<uint8_t> isChunkValid(chunkCount, false); // Not std::vector<bool>, whose elements cannot be written concurrently
+
+    QThreadPool pool;
+    for (uint32_t i = 0; i < chunkCount; i++)
+    {
+        pool.start([&, i]()
+        {
+            const auto chunk = qUncompress(QByteArray::fromRawData(pContainer.constData() + compressedOffsets[i], compressedSizes[i]));
+
+            if (chunk.size() == uncompressedSizes[i])
+            {
+                std::copy(chunk.cbegin(), chunk.cend(), target + uncompressedOffsets[i]);
+                isChunkValid[i] = true;
+            }
+        });
+    }
+    pool.waitForDone();
+
+    if (std::find(isChunkValid.cbegin(), isChunkValid.cend(), false) != isChunkValid.cend())
+    {
+        return std::nullopt;
+    }
+
+    return data;
+}
+
+std::optional<QByteArray> CircuitFileParser::DecompressCircuit(const QByteArray& pRawData)
+{
+    const auto data = IsChunkedContainer(pRawData) ? DecompressChunked(pRawData) : std::optional<QByteArray>(qUncompress(pRawData));
+
+    if (!data.has_value() || data->isEmpty())
+    {
+        return std::nullopt;
+    }
+
+    return data;
+}
+
+QByteArray CircuitFileParser::MapFile(QFile& pFile)
+{
+    if (file::USE_MEMORY_MAPPED_LOADING && pFile.size() > 0)
+    {
+        const auto data = pFile.map(0, pFile.size());
+
+        if (nullptr != data)
+        {
+            return QByteArray::fromRawData(reinterpret_cast<const char*>(data), pFile.size());
+        }
+    }
+
+    return pFile.readAll(); // Fallback for devices and file systems that don't support mapping
+}
+
+bool CircuitFileParser::IsChunkedContainer(const QByteArray& pData)
+{
+    return pData.startsWith(file::CONTAINER_MAGIC);
+}
+
 void CircuitFileParser::SaveJson(const QJsonObject& pJson)
 {
     if (mCurrentFile.has_value())
@@ -57,7 +351,8 @@ void CircuitFileParser::SaveJson(const QJsonObject& pJson)
 
 void CircuitFileParser::SaveJsonAs(const QFileInfo& pFileInfo, const QJsonObject& pJson)
 {
-    QFile saveFile(pFileInfo.absoluteFilePath());
+    // The file is only replaced once it has been written completely, the journal may read it for compaction meanwhile
+    QSaveFile saveFile(pFileInfo.absoluteFilePath());
 
     if (!saveFile.open(QIODevice::WriteOnly))
     {
@@ -68,7 +363,7 @@ void CircuitFileParser::SaveJsonAs(const QFileInfo& pFileInfo, const QJsonObject
     if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
     {
         auto bin = QCborValue::fromJsonValue(pJson).toCbor();
-        saveFile.write(qCompress(bin, 9));
+        saveFile.write(CompressChunked(bin));
     }
     else
     {
@@ -76,13 +371,67 @@ void CircuitFileParser::SaveJsonAs(const QFileInfo& pFileInfo, const QJsonObject
         saveFile.write(json);
     }
 
+    if (!saveFile.commit())
+    {
+        emit SaveCircuitFileFailedSignal(pFileInfo);
+        return;
+    }
+
+    mCurrentFile = pFileInfo;
+    mIsCircuitModified = false;
+
+    mRuntimeConfigParser.AddRecentFilePath(mCurrentFile.value());
+    mRuntimeConfigParser.SetLastFilePath(pFileInfo.path());
+
+    emit SaveCircuitFileSuccessSignal(mCurrentFile.value());
+}
+
+void CircuitFileParser::SaveCircuit(const std::function<void(QCborStreamWriter&)>& pCircuitWriter)
+{
+    if (mCurrentFile.has_value())
+    {
+        SaveCircuitAs(mCurrentFile.value(), pCircuitWriter);
+    }
+}
+
+void CircuitFileParser::SaveCircuitAs(const QFileInfo& pFileInfo, const std::function<void(QCborStreamWriter&)>& pCircuitWriter)
+{
+    Q_ASSERT(file::SAVE_FORMAT == file::SaveFormat::BINARY);
+
+    // The file is only replaced once it has been written completely
+    QSaveFile saveFile(pFileInfo.absoluteFilePath());
+
+    if (!saveFile.open(QIODevice::WriteOnly))
+    {
+        emit SaveCircuitFileFailedSignal(pFileInfo);
+        return;
+    }
+
+    // The circuit is compressed while it is serialized, neither the CBOR data nor the compressed data is held as a whole
+    ChunkedCompressionDevice compressor(saveFile);
+
+    if (compressor.open(QIODevice::WriteOnly))
+    {
+        QCborStreamWriter writer(&compressor);
+        pCircuitWriter(writer);
+    }
+
+    compressor.close();
+
+    if (!compressor.IsWritten() || !saveFile.commit())
+    {
+        emit SaveCircuitFileFailedSignal(pFileInfo);
+        return;
+    }
+
     mCurrentFile = pFileInfo;
     mIsCircuitModified = false;
 
     mRuntimeConfigParser.AddRecentFilePath(mCurrentFile.value());
     mRuntimeConfigParser.SetLastFilePath(pFileInfo.path());
 
-    emit SaveCircuitFileSuccessSignal(mCurrentFile.value());}
+    emit SaveCircuitFileSuccessSignal(mCurrentFile.value());
+}
 
 void CircuitFileParser::ResetCurrentFileInfo()
 {
@@ -90,6 +439,14 @@ void CircuitFileParser::ResetCurrentFileInfo()
     mIsCircuitModified = false;
 }
 
+void CircuitFileParser::SetCurrentFile(const QFileInfo& pFileInfo)
+{
+    mCurrentFile = pFileInfo;
+    mIsCircuitModified = false;
+
+    mRuntimeConfigParser.SetLastFilePath(pFileInfo.path());
+}
+
 bool CircuitFileParser::IsFileOpen() const
 {
     return mCurrentFile.has_value();
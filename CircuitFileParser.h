@@ -2,6 +2,7 @@
 #define CIRCUITFILEPARSER_H
 
 #include "RuntimeConfigParser.h"
+#include "HelperStructures.h"
 
 #include <QFile>
 #include <QFileInfo>
@@ -9,6 +10,9 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <functional>
 
 ///
 /// \brief The CircuitFileParser handles all circuit file loading and saving operations
@@ -35,8 +39,23 @@ public:
     /// \param pJson: The JSON to save into the file
     void SaveJsonAs(const QFileInfo& pFileInfo, const QJsonObject& pJson);
 
+    /// \brief Saves the circuit to the current binary file
+    /// \param pCircuitWriter: Function that writes the circuit into the given CBOR stream
+    void SaveCircuit(const std::function<void(QCborStreamWriter&)>& pCircuitWriter);
+
+    /// \brief Saves the circuit to the given binary file, the circuit is compressed and written while it is streamed
+    /// Only used for the binary save format, JSON files are saved with SaveJsonAs()
+    /// \param pFileInfo: The file to save into
+    /// \param pCircuitWriter: Function that writes the circuit into the given CBOR stream
+    void SaveCircuitAs(const QFileInfo& pFileInfo, const std::function<void(QCborStreamWriter&)>& pCircuitWriter);
+
     void ResetCurrentFileInfo(void);
 
+    /// \brief Sets the given file as the current file, used when the circuit is loaded outside of LoadJson
+    /// The file is not added to the recent files, because the load may still be canceled
+    /// \param pFileInfo: The loaded file
+    void SetCurrentFile(const QFileInfo& pFileInfo);
+
     /// \brief Returns true, if there is a known file path to save the current circuit into
     /// \return True, if there is a known file path to save the current circuit into
     bool IsFileOpen(void) const;
@@ -52,12 +71,57 @@ public:
     /// \brief Emits a signal if the circuit is newly modified
     void MarkAsModified(void);
 
+    /// \brief Reads all top level entries of a CBOR circuit except for the components, which are skipped without decoding
+    /// \param pCbor: The uncompressed CBOR circuit data
+    /// \return The top level entries (versions etc.) as JSON object, or nothing if the data is not a valid circuit
+    static std::optional<QJsonObject> ReadCborHeader(const QByteArray& pCbor);
+
+    /// \brief Decodes the components of a CBOR circuit one by one and passes each to the given handler
+    /// Only one component at a time is converted to JSON, the component array is never materialized
+    /// \param pCbor: The uncompressed CBOR circuit data
+    /// \param pComponentHandler: Function that is called with the JSON object of every component, returns false to stop decoding
+    /// \return Whether all components have been read, reading has been stopped, the data is truncated or does not follow the format
+    static file::ComponentReadResult ReadCborComponents(const QByteArray& pCbor, const std::function<bool(const QJsonObject&)>& pComponentHandler);
+
+    /// \brief Compresses the given data into the chunked container format, chunks are compressed in parallel
+    /// \param pData: The uncompressed data
+    /// \return The container, consisting of a header followed by the compressed chunks
+    static QByteArray CompressChunked(const QByteArray& pData);
+
+    /// \brief Decompresses the given chunked container, chunks are decompressed in parallel
+    /// Containers of version 1 (chunk index in the header) and version 2 (sizes in front of every chunk) are supported
+    /// \param pContainer: The container data
+    /// \return The uncompressed data, or nothing if the container is invalid or of a newer container version
+    static std::optional<QByteArray> DecompressChunked(const QByteArray& pContainer);
+
+    /// \brief Decompresses the raw data of a binary circuit file, either a chunked container or a single qCompress blob
+    /// \param pRawData: The raw file data
+    /// \return The uncompressed CBOR data, or nothing if the data could not be decompressed
+    static std::optional<QByteArray> DecompressCircuit(const QByteArray& pRawData);
+
+    /// \brief Returns the content of the given opened file, mapped into memory if possible so that it is read from the page cache without a heap copy
+    /// The returned data does not own the mapped memory, it must not be used after pFile has been closed or destroyed
+    /// \param pFile: The opened file
+    /// \return The file content, which is a copy on the heap only if the file could not be mapped
+    static QByteArray MapFile(QFile& pFile);
+
+    /// \brief Checks if the given file data is a chunked container, otherwise it is a single qCompress blob
+    /// \param pData: The raw file data
+    /// \return True, if the data starts with the container magic
+    static bool IsChunkedContainer(const QByteArray& pData);
+
 signals:
     /// \brief Emitted when a circuit file has been opened successfully
     /// \param pFileInfo: Info about the opened file
     /// \param pJson: The file content as a QJsonObject reference
     void LoadCircuitFileSuccessSignal(const QFileInfo& pFileInfo, const QJsonObject& pJson);
 
+    /// \brief Emitted when a binary circuit file has been opened successfully
+    /// \param pFileInfo: Info about the opened file
+    /// \param pHeader: The top level entries of the circuit, without components
+    /// \param pCbor: The uncompressed CBOR data to stream the components from
+    void LoadCircuitCborSuccessSignal(const QFileInfo& pFileInfo, const QJsonObject& pHeader, const QByteArray& pCbor);
+
     /// \brief Emitted when a circuit file could not be opened
     /// \param pFileInfo: Info about the file
     /// \param pIsFromRecents: Whether the file is from the recent files list
@@ -0,0 +1,298 @@
+#include "CircuitGenerator.h"
+#include "CoreLogic.h"
+#include "Configuration.h"
+
+#include "Components/Gates/XorGate.h"
+#include "Components/Inputs/LogicClock.h"
+#include "Components/Inputs/LogicConstant.h"
+#include "Components/Inputs/LogicCells/LogicClockCell.h"
+#include "Components/Outputs/LogicOutput.h"
+#include "Components/ComplexLogic/FullAdder.h"
+#include "Components/ComplexLogic/Counter.h"
+#include "Components/ComplexLogic/ShiftRegister.h"
+
+CircuitGenerator::CircuitGenerator(const CoreLogic* pCoreLogic):
+    mCoreLogic(pCoreLogic),
+    mMinVersion(0, 0, 0)
+{
+    Q_ASSERT(mCoreLogic);
+}
+
+QJsonObject CircuitGenerator::GenerateRippleAdder(uint32_t pBitWidth)
+{
+    constexpr uint32_t g = canvas::GRID_SIZE;
+    constexpr uint32_t stageWidth = 12 * g;
+    constexpr uint32_t rowHeight = 8 * g;
+    const uint32_t stagesPerRow = std::max(1u, benchmark::MAX_ROW_WIDTH / stageWidth);
+
+    QPointF previousCarry;
+
+    for (uint32_t i = 0; i < pBitWidth; i++)
+    {
+        const uint32_t column = i % stagesPerRow;
+        const uint32_t row = i / stagesPerRow;
+
+        FullAdder adder(mCoreLogic, Direction::RIGHT);
+        adder.setPos(benchmark::ORIGIN + QPointF(column * stageWidth + 8 * g, row * rowHeight));
+
+        const auto a = GetInputPin(adder, 0);
+        const auto b = GetInputPin(adder, 1);
+        const auto carryIn = GetInputPin(adder, 2);
+        const auto sum = GetOutputPin(adder, 0);
+
+        // Operand A toggles with a different period on every bit, operand B is constant
+        AddClock(a - QPointF(4 * g, 0), 1 + i % 8);
+        AddWirePath({a - QPointF(4 * g, 0), a});
+
+        LogicConstant constant(mCoreLogic, (i % 2 == 0) ? LogicState::LOW : LogicState::HIGH);
+        constant.setPos(b - QPointF(2 * g, 0));
+        AddComponent(constant);
+        AddWirePath({b - QPointF(2 * g, 0), b});
+
+        LogicOutput output(mCoreLogic);
+        output.setPos(sum + QPointF(2 * g, 0));
+        AddComponent(output);
+        AddWirePath({sum, sum + QPointF(2 * g, 0)});
+
+        if (i > 0)
+        {
+            if (column > 0)
+            {
+                AddWirePath({previousCarry, carryIn});
+            }
+            else // Route the carry below the previous row back to the first stage of this row
+            {
+                const double below = previousCarry.y() + 3 * g;
+                AddWirePath({previousCarry, previousCarry + QPointF(g, 0), QPointF(previousCarry.x() + g, below),
+                             QPointF(carryIn.x() - 8 * g, below), QPointF(carryIn.x() - 8 * g, carryIn.y()), carryIn});
+            }
+        }
+
+        previousCarry = GetOutputPin(adder, 1);
+        AddComponent(adder);
+    }
+
+    return TakeCircuit();
+}
+
+QJsonObject CircuitGenerator::GenerateCounterChain(uint32_t pCounterCount)
+{
+    constexpr uint32_t g = canvas::GRID_SIZE;
+    constexpr uint8_t bitWidth = benchmark::COUNTER_BIT_WIDTH;
+    constexpr uint32_t stageWidth = 8 * g;
+    constexpr uint32_t rowHeight = (bitWidth + 5) * g;
+    const uint32_t stagesPerRow = std::max(1u, benchmark::MAX_ROW_WIDTH / stageWidth);
+
+    QPointF previousMsb;
+
+    for (uint32_t i = 0; i < pCounterCount; i++)
+    {
+        const uint32_t column = i % stagesPerRow;
+        const uint32_t row = i / stagesPerRow;
+
+        Counter counter(mCoreLogic, Direction::RIGHT, bitWidth);
+        counter.setPos(benchmark::ORIGIN + QPointF(column * stageWidth + 6 * g, row * rowHeight + 2 * g));
+
+        const auto clock = GetInputPin(counter, 2); // Inputs 0 and 1 are reset and preset on top
+
+        if (i == 0)
+        {
+            AddClock(clock - QPointF(2 * g, 0), 1);
+            AddWirePath({clock - QPointF(2 * g, 0), clock});
+        }
+        else if (column > 0)
+        {
+            AddWirePath({previousMsb, previousMsb + QPointF(g, 0), QPointF(previousMsb.x() + g, clock.y()), clock});
+        }
+        else // Route the MSB below the previous row back to the first counter of this row
+        {
+            const double below = previousMsb.y() + 2 * g;
+            AddWirePath({previousMsb, previousMsb + QPointF(g, 0), QPointF(previousMsb.x() + g, below),
+                         QPointF(clock.x() - 3 * g, below), QPointF(clock.x() - 3 * g, clock.y()), clock});
+        }
+
+        previousMsb = GetOutputPin(counter, bitWidth - 1);
+        AddComponent(counter);
+    }
+
+    return TakeCircuit();
+}
+
+QJsonObject CircuitGenerator::GenerateLfsrArray(uint32_t pLfsrCount)
+{
+    constexpr uint32_t g = canvas::GRID_SIZE;
+    constexpr uint8_t bitWidth = benchmark::LFSR_SHIFT_REGISTER_BIT_WIDTH;
+    constexpr uint32_t stageWidth = (2 * (bitWidth + 1) + 22) * g;
+    constexpr uint32_t rowHeight = 12 * g;
+    const uint32_t stagesPerRow = std::max(1u, benchmark::MAX_ROW_WIDTH / stageWidth);
+
+    for (uint32_t i = 0; i < pLfsrCount; i++)
+    {
+        const auto origin = benchmark::ORIGIN + QPointF((i % stagesPerRow) * stageWidth + 6 * g, (i / stagesPerRow) * rowHeight + 3 * g);
+
+        ShiftRegister first(mCoreLogic, Direction::RIGHT, bitWidth);
+        first.setPos(origin);
+
+        ShiftRegister second(mCoreLogic, Direction::RIGHT, bitWidth);
+        second.setPos(QPointF(GetOutputPin(first, bitWidth - 1).x() + 4 * g, origin.y()));
+
+        XorGate xnor(mCoreLogic, 2, Direction::RIGHT);
+        xnor.setPos(QPointF(GetOutputPin(second, bitWidth - 1).x() + 4 * g, origin.y()));
+        xnor.GetLogicCell()->SetOutputInversions(std::vector<bool>{true}); // XNOR feedback leaves the all-zero state
+
+        const auto firstData = GetInputPin(first, 0);
+        const auto firstClock = GetInputPin(first, 1);
+        const auto firstOut = GetOutputPin(first, bitWidth - 1);
+        const auto secondData = GetInputPin(second, 0);
+        const auto secondClock = GetInputPin(second, 1);
+        const auto secondOut = GetOutputPin(second, bitWidth - 1);
+        const auto xnorOut = GetOutputPin(xnor, 0);
+
+        // Shift chain and tap of the first register's output
+        const auto tap = firstOut + QPointF(g, 0);
+        AddWirePath({firstOut, secondData});
+        AddConPoint(tap);
+        AddWirePath({tap, tap - QPointF(0, 3 * g), QPointF(secondOut.x() + 2 * g, tap.y() - 3 * g),
+                     QPointF(secondOut.x() + 2 * g, GetInputPin(xnor, 1).y()), GetInputPin(xnor, 1)});
+        AddWirePath({secondOut, GetInputPin(xnor, 0)});
+
+        // Feedback below the registers
+        AddWirePath({xnorOut, xnorOut + QPointF(g, 0), QPointF(xnorOut.x() + g, origin.y() + 7 * g),
+                     QPointF(firstData.x() - g, origin.y() + 7 * g), firstData - QPointF(g, 0), firstData});
+
+        // Shared clock, branched off with a ConPoint
+        const auto branch = firstClock - QPointF(3 * g, 0);
+        AddClock(firstClock - QPointF(4 * g, 0), 1 + i % 4);
+        AddWirePath({firstClock - QPointF(4 * g, 0), firstClock});
+        AddConPoint(branch);
+        AddWirePath({branch, branch + QPointF(0, 3 * g), QPointF(secondClock.x() - 2 * g, branch.y() + 3 * g),
+                     secondClock - QPointF(2 * g, 0), secondClock});
+
+        AddComponent(first);
+        AddComponent(second);
+        AddComponent(xnor);
+    }
+
+    return TakeCircuit();
+}
+
+QJsonObject CircuitGenerator::GenerateWireMesh(uint32_t pSize)
+{
+    constexpr uint32_t g = canvas::GRID_SIZE;
+    const auto origin = benchmark::ORIGIN + QPointF(4 * g, 2 * g);
+    const double length = 2 * g * pSize;
+
+    for (uint32_t i = 0; i < pSize; i++)
+    {
+        const QPointF start = origin + QPointF(0, 2 * g * i);
+        AddWirePath({start, start + QPointF(length, 0)});
+
+        if (i % 8 == 0)
+        {
+            AddClock(start, 1 + (i / 8) % 8);
+        }
+    }
+
+    for (uint32_t j = 0; j < pSize; j++)
+    {
+        const QPointF start = origin + QPointF(2 * g * j + g, -1.0 * g);
+        AddWirePath({start, start + QPointF(0, length)});
+
+        if (j % 8 == 0)
+        {
+            LogicOutput output(mCoreLogic);
+            output.setPos(start + QPointF(0, length));
+            AddComponent(output);
+        }
+
+        for (uint32_t i = j % 2; i < pSize; i += 2) // ConPoints on every second crossing
+        {
+            AddConPoint(QPointF(start.x(), origin.y() + 2 * g * i));
+        }
+    }
+
+    return TakeCircuit();
+}
+
+void CircuitGenerator::AddComponent(const IBaseComponent& pComponent)
+{
+    mComponents.append(pComponent.GetJson());
+    mMinVersion = GetNewerVersion(mMinVersion, pComponent.GetMinVersion());
+}
+
+void CircuitGenerator::AddWirePath(const std::vector<QPointF>& pPoints)
+{
+    Q_ASSERT(pPoints.size() >= 2);
+
+    for (size_t i = 1; i < pPoints.size(); i++)
+    {
+        const auto& a = pPoints[i - 1];
+        const auto& b = pPoints[i];
+        Q_ASSERT(a.x() == b.x() || a.y() == b.y()); // Path segments must be axis-aligned
+
+        if (a == b)
+        {
+            continue;
+        }
+
+        if (a.y() == b.y())
+        {
+            LogicWire wire(mCoreLogic, WireDirection::HORIZONTAL, static_cast<uint32_t>(std::abs(b.x() - a.x())));
+            wire.setPos(std::min(a.x(), b.x()), a.y());
+            AddComponent(wire);
+        }
+        else
+        {
+            LogicWire wire(mCoreLogic, WireDirection::VERTICAL, static_cast<uint32_t>(std::abs(b.y() - a.y())));
+            wire.setPos(a.x(), std::min(a.y(), b.y()));
+            AddComponent(wire);
+        }
+    }
+}
+
+void CircuitGenerator::AddConPoint(QPointF pPos)
+{
+    ConPoint conPoint(mCoreLogic);
+    conPoint.setPos(pPos);
+    AddComponent(conPoint);
+}
+
+void CircuitGenerator::AddClock(QPointF pOutputPin, uint32_t pToggleTicks)
+{
+    LogicClock clock(mCoreLogic, Direction::RIGHT);
+    clock.setPos(pOutputPin - clock.GetOutConnectors()[0].pos);
+    std::static_pointer_cast<LogicClockCell>(clock.GetLogicCell())->SetToggleTicks(pToggleTicks);
+    AddComponent(clock);
+}
+
+QPointF CircuitGenerator::GetInputPin(const IBaseComponent& pComponent, uint32_t pInput) const
+{
+    Q_ASSERT(pComponent.GetInConnectors().size() > pInput);
+    return pComponent.pos() + pComponent.GetInConnectors()[pInput].pos;
+}
+
+QPointF CircuitGenerator::GetOutputPin(const IBaseComponent& pComponent, uint32_t pOutput) const
+{
+    Q_ASSERT(pComponent.GetOutConnectors().size() > pOutput);
+    return pComponent.pos() + pComponent.GetOutConnectors()[pOutput].pos;
+}
+
+QJsonObject CircuitGenerator::TakeCircuit()
+{
+    QJsonObject json;
+
+    json[file::JSON_COMPONENTS_IDENTIFIER] = mComponents;
+
+    json[file::JSON_MAJOR_VERSION_IDENTIFIER] = MAJOR_VERSION;
+    json[file::JSON_MINOR_VERSION_IDENTIFIER] = MINOR_VERSION;
+    json[file::JSON_PATCH_VERSION_IDENTIFIER] = PATCH_VERSION;
+
+    json[file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER] = mMinVersion.major;
+    json[file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER] = mMinVersion.minor;
+    json[file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER] = mMinVersion.patch;
+
+    mComponents = QJsonArray();
+    mMinVersion = SwVersion(0, 0, 0);
+
+    return json;
+}
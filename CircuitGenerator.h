@@ -0,0 +1,85 @@
+#ifndef CIRCUITGENERATOR_H
+#define CIRCUITGENERATOR_H
+
+#include "HelperStructures.h"
+
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QPointF>
+
+class CoreLogic;
+class IBaseComponent;
+
+///
+/// \brief The CircuitGenerator class programmatically creates scalable circuits in the circuit file JSON format
+/// All components are created using the same constructors as when they are placed by the user
+///
+class CircuitGenerator
+{
+public:
+    /// \brief Constructor for the CircuitGenerator
+    /// \param pCoreLogic: Pointer to the core logic, used to construct the components
+    CircuitGenerator(const CoreLogic* pCoreLogic);
+
+    /// \brief Generates a ripple carry adder built from full adders, driven by clocks and constants
+    /// \param pBitWidth: The number of full adders in the carry chain
+    /// \return The circuit as JSON object
+    QJsonObject GenerateRippleAdder(uint32_t pBitWidth);
+
+    /// \brief Generates a chain of counters, each clocked by the MSB of its predecessor
+    /// \param pCounterCount: The number of counters in the chain
+    /// \return The circuit as JSON object
+    QJsonObject GenerateCounterChain(uint32_t pCounterCount);
+
+    /// \brief Generates an array of independent LFSRs, each made of two shift registers and a XNOR feedback
+    /// \param pLfsrCount: The number of LFSRs to generate
+    /// \return The circuit as JSON object
+    QJsonObject GenerateLfsrArray(uint32_t pLfsrCount);
+
+    /// \brief Generates a mesh of crossing wires, connected by ConPoints on every second crossing and driven by clocks
+    /// \param pSize: The number of horizontal and vertical wires
+    /// \return The circuit as JSON object
+    QJsonObject GenerateWireMesh(uint32_t pSize);
+
+protected:
+    /// \brief Appends the JSON representation of the given component to the current circuit
+    /// \param pComponent: The component to add, it is not taken ownership of
+    void AddComponent(const IBaseComponent& pComponent);
+
+    /// \brief Adds wires along the given axis-aligned path, consecutive wires form L-crossings
+    /// \param pPoints: The corner points of the path, at least two
+    void AddWirePath(const std::vector<QPointF>& pPoints);
+
+    /// \brief Adds a full ConPoint at the given position
+    /// \param pPos: The position of the ConPoint
+    void AddConPoint(QPointF pPos);
+
+    /// \brief Adds a toggling clock whose output pin is located at the given position
+    /// \param pOutputPin: The position of the clock output
+    /// \param pToggleTicks: The amount of ticks between two clock edges
+    void AddClock(QPointF pOutputPin, uint32_t pToggleTicks);
+
+    /// \brief Returns the scene position of the given input connector
+    /// \param pComponent: The component
+    /// \param pInput: The index of the input connector
+    /// \return The position of the input connector
+    QPointF GetInputPin(const IBaseComponent& pComponent, uint32_t pInput) const;
+
+    /// \brief Returns the scene position of the given output connector
+    /// \param pComponent: The component
+    /// \param pOutput: The index of the output connector
+    /// \return The position of the output connector
+    QPointF GetOutputPin(const IBaseComponent& pComponent, uint32_t pOutput) const;
+
+    /// \brief Wraps the components added since the last call into a circuit JSON object and resets the generator
+    /// \return The circuit as JSON object
+    QJsonObject TakeCircuit(void);
+
+protected:
+    const CoreLogic* mCoreLogic;
+
+    QJsonArray mComponents;
+    SwVersion mMinVersion;
+};
+
+#endif // CIRCUITGENERATOR_H
@@ -0,0 +1,479 @@
+#include "CircuitJournal.h"
+#include "CircuitFileParser.h"
+#include "Configuration.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <algorithm>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+CircuitJournal::CircuitJournal():
+    mCompactionTimer(this)
+{
+    QObject::connect(&mCompactionTimer, &QTimer::timeout, this, &CircuitJournal::OnCompactionTimeout);
+}
+
+CircuitJournal::~CircuitJournal()
+{
+    Stop();
+}
+
+void CircuitJournal::Start(const QFileInfo& pCircuitFile)
+{
+    Stop();
+    RemoveJournalFiles(pCircuitFile);
+
+    mCircuitFile = pCircuitFile;
+    mGeneration = QDateTime::currentMSecsSinceEpoch();
+    mDeltaCount = 0;
+
+    mCompactionTimer.start(file::JOURNAL_COMPACTION_INTERVAL);
+}
+
+void CircuitJournal::Resume(const QFileInfo& pCircuitFile)
+{
+    mCompactionTimer.stop();
+    WaitForCompaction();
+    mJournal.close();
+
+    mCircuitFile = pCircuitFile;
+    mDeltaCount = 0;
+
+    const auto journalGeneration = ReadJournalGeneration(GetJournalPath(pCircuitFile));
+    const auto compactingGeneration = ReadJournalGeneration(GetCompactingJournalPath(pCircuitFile));
+
+    if (journalGeneration.has_value())
+    {
+        mGeneration = journalGeneration.value(); // Continue appending to the existing journal
+    }
+    else
+    {
+        mGeneration = std::max(QDateTime::currentMSecsSinceEpoch(), compactingGeneration.value_or(0) + 1);
+    }
+
+    if (compactingGeneration.has_value())
+    {
+        StartCompaction(); // Compaction has been interrupted in the previous session
+    }
+
+    mCompactionTimer.start(file::JOURNAL_COMPACTION_INTERVAL);
+}
+
+void CircuitJournal::Stop()
+{
+    mCompactionTimer.stop();
+    WaitForCompaction();
+    mJournal.close();
+
+    if (mCircuitFile.has_value())
+    {
+        RemoveJournalFiles(mCircuitFile.value());
+        mCircuitFile.reset();
+    }
+}
+
+bool CircuitJournal::IsActive() const
+{
+    return mCircuitFile.has_value();
+}
+
+void CircuitJournal::AppendDelta(const QStringList& pRemovedKeys, const std::vector<QJsonObject>& pAddedComponents)
+{
+    if (!IsActive() || (pRemovedKeys.isEmpty() && pAddedComponents.empty()))
+    {
+        return;
+    }
+
+    if (!mJournal.isOpen() && !OpenJournal())
+    {
+        qDebug() << "Could not open circuit journal";
+        return;
+    }
+
+    QJsonArray added;
+    for (const auto& component : pAddedComponents)
+    {
+        added.append(component);
+    }
+
+    QJsonObject delta;
+    delta[file::JSON_JOURNAL_REMOVE_IDENTIFIER] = QJsonArray::fromStringList(pRemovedKeys);
+    delta[file::JSON_JOURNAL_ADD_IDENTIFIER] = added;
+
+    mJournal.write(QJsonDocument(delta).toJson(QJsonDocument::Compact) + '\n');
+
+    if (!SyncJournal())
+    {
+        qDebug() << "Could not sync circuit journal";
+    }
+
+    if (++mDeltaCount >= file::JOURNAL_COMPACTION_DELTA_THRESHOLD)
+    {
+        OnCompactionTimeout();
+    }
+}
+
+QString CircuitJournal::GetComponentKey(const QJsonObject& pComponent, QPointF pShift)
+{
+    const auto type = pComponent[file::JSON_TYPE_IDENTIFIER].toInt();
+    auto key = QString("%0:%1:%2").arg(type)
+            .arg(QString::number(pComponent["x"].toDouble() - pShift.x(), 'g', 10),
+                 QString::number(pComponent["y"].toDouble() - pShift.y(), 'g', 10));
+
+    // A horizontal and a vertical wire may start at the same position
+    if (type == file::ComponentId::WIRE)
+    {
+        key += QString(":%0").arg(pComponent["dir"].toInt());
+    }
+
+    return key;
+}
+
+bool CircuitJournal::HasJournal(const QFileInfo& pCircuitFile)
+{
+    return QFile::exists(GetJournalPath(pCircuitFile))
+            || QFile::exists(GetCompactingJournalPath(pCircuitFile))
+            || QFile::exists(GetSnapshotPath(pCircuitFile));
+}
+
+std::optional<std::vector<QJsonObject>> CircuitJournal::Recover(const QFileInfo& pCircuitFile)
+{
+    auto state = ReadBaseState(pCircuitFile);
+
+    if (!state.has_value())
+    {
+        return std::nullopt;
+    }
+
+    // The rotated journal is always older than the current one
+    ApplyJournal(GetCompactingJournalPath(pCircuitFile), state.value());
+    ApplyJournal(GetJournalPath(pCircuitFile), state.value());
+
+    std::vector<QJsonObject> components;
+    for (const auto& component : state->components)
+    {
+        if (component.has_value())
+        {
+            components.push_back(component.value());
+        }
+    }
+
+    return components;
+}
+
+void CircuitJournal::RemoveJournalFiles(const QFileInfo& pCircuitFile)
+{
+    QFile::remove(GetJournalPath(pCircuitFile));
+    QFile::remove(GetCompactingJournalPath(pCircuitFile));
+    QFile::remove(GetSnapshotPath(pCircuitFile));
+}
+
+void CircuitJournal::OnCompactionTimeout()
+{
+    if (!IsActive() || (mCompactionThread && !mCompactionThread->isFinished()))
+    {
+        return;
+    }
+
+    if (QFile::exists(GetCompactingJournalPath(mCircuitFile.value())))
+    {
+        StartCompaction(); // Retry a failed compaction before rotating again
+        return;
+    }
+
+    if (mDeltaCount == 0)
+    {
+        return;
+    }
+
+    // Rotate the journal, new deltas are appended to a journal of the next generation while the old one is compacted
+    mJournal.close();
+    if (!QFile::rename(GetJournalPath(mCircuitFile.value()), GetCompactingJournalPath(mCircuitFile.value())))
+    {
+        return;
+    }
+
+    mGeneration = std::max(QDateTime::currentMSecsSinceEpoch(), mGeneration + 1);
+    mDeltaCount = 0;
+
+    StartCompaction();
+}
+
+void CircuitJournal::AddComponent(CircuitState& pState, const QJsonObject& pComponent)
+{
+    pState.index.insert(GetComponentKey(pComponent), pState.components.size());
+    pState.components.push_back(pComponent);
+}
+
+void CircuitJournal::RemoveComponent(CircuitState& pState, const QString& pKey)
+{
+    const auto entry = pState.index.find(pKey);
+
+    if (entry != pState.index.end())
+    {
+        pState.components[entry.value()].reset();
+        pState.index.erase(entry);
+    }
+}
+
+bool CircuitJournal::OpenJournal()
+{
+    Q_ASSERT(mCircuitFile.has_value());
+
+    mJournal.setFileName(GetJournalPath(mCircuitFile.value()));
+
+    if (!mJournal.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        return false;
+    }
+
+    if (mJournal.size() == 0)
+    {
+        QJsonObject header;
+        header[file::JSON_JOURNAL_GENERATION_IDENTIFIER] = mGeneration;
+        mJournal.write(QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n');
+        return SyncJournal();
+    }
+
+    return true;
+}
+
+bool CircuitJournal::SyncJournal()
+{
+    // Flushing only hands the data to the OS, it is synced to disk so that it also survives a crash of the system
+    if (!mJournal.flush())
+    {
+        return false;
+    }
+
+#if defined(Q_OS_WIN)
+    return (_commit(mJournal.handle()) == 0);
+#else
+    return (fsync(mJournal.handle()) == 0);
+#endif
+}
+
+void CircuitJournal::StartCompaction()
+{
+    Q_ASSERT(mCircuitFile.has_value());
+
+    const auto circuitFile = mCircuitFile.value();
+
+    mCompactionThread = QThread::create([circuitFile]()
+    {
+        if (!Compact(circuitFile))
+        {
+            qDebug() << "Could not compact circuit journal, retrying later";
+        }
+    });
+
+    QObject::connect(mCompactionThread, &QThread::finished, mCompactionThread, &QObject::deleteLater);
+    mCompactionThread->start(QThread::LowPriority);
+}
+
+void CircuitJournal::WaitForCompaction()
+{
+    if (mCompactionThread)
+    {
+        mCompactionThread->wait();
+    }
+}
+
+bool CircuitJournal::Compact(const QFileInfo& pCircuitFile)
+{
+    auto state = ReadBaseState(pCircuitFile);
+
+    if (!state.has_value())
+    {
+        return false;
+    }
+
+    ApplyJournal(GetCompactingJournalPath(pCircuitFile), state.value());
+
+    if (!WriteSnapshot(GetSnapshotPath(pCircuitFile), state.value()))
+    {
+        return false;
+    }
+
+    // The snapshot contains the generation, so a crash before this point only replays deltas that are skipped anyway
+    QFile::remove(GetCompactingJournalPath(pCircuitFile));
+    return true;
+}
+
+std::optional<CircuitJournal::CircuitState> CircuitJournal::ReadBaseState(const QFileInfo& pCircuitFile)
+{
+    if (QFile::exists(GetSnapshotPath(pCircuitFile)))
+    {
+        auto snapshot = ReadCircuitFile(GetSnapshotPath(pCircuitFile));
+
+        if (snapshot.has_value())
+        {
+            snapshot->generation = snapshot->header.take(file::JSON_JOURNAL_GENERATION_IDENTIFIER).toInteger();
+            return snapshot;
+        }
+    }
+
+    return ReadCircuitFile(pCircuitFile.absoluteFilePath());
+}
+
+std::optional<CircuitJournal::CircuitState> CircuitJournal::ReadCircuitFile(const QString& pPath)
+{
+    QFile circuitFile(pPath);
+
+    if (!circuitFile.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+
+    CircuitState state;
+
+    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    {
+        const auto cbor = CircuitFileParser::DecompressCircuit(circuitFile.readAll());
+        const auto header = cbor.has_value() ? CircuitFileParser::ReadCborHeader(cbor.value()) : std::nullopt;
+
+        if (!header.has_value())
+        {
+            return std::nullopt;
+        }
+
+        state.header = header.value();
+        const auto result = CircuitFileParser::ReadCborComponents(cbor.value(), [&state](const QJsonObject& pComponent)
+        {
+            AddComponent(state, pComponent);
+            return true;
+        });
+
+        if (result == file::ComponentReadResult::INVALID)
+        {
+            return std::nullopt;
+        }
+    }
+    else
+    {
+        state.header = QJsonDocument::fromJson(circuitFile.readAll()).object();
+
+        for (const auto& component : state.header.take(file::JSON_COMPONENTS_IDENTIFIER).toArray())
+        {
+            AddComponent(state, component.toObject());
+        }
+    }
+
+    return state;
+}
+
+void CircuitJournal::ApplyJournal(const QString& pPath, CircuitState& pState)
+{
+    QFile journal(pPath);
+
+    if (!journal.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    const auto generation = QJsonDocument::fromJson(journal.readLine()).object()[file::JSON_JOURNAL_GENERATION_IDENTIFIER].toInteger();
+
+    if (generation <= pState.generation)
+    {
+        return; // Already contained in the snapshot
+    }
+
+    while (!journal.atEnd())
+    {
+        QJsonParseError error;
+        const auto delta = QJsonDocument::fromJson(journal.readLine(), &error).object();
+
+        if (error.error != QJsonParseError::NoError)
+        {
+            break; // The last delta may be incomplete after a crash
+        }
+
+        for (const auto& key : delta[file::JSON_JOURNAL_REMOVE_IDENTIFIER].toArray())
+        {
+            RemoveComponent(pState, key.toString());
+        }
+
+        for (const auto& component : delta[file::JSON_JOURNAL_ADD_IDENTIFIER].toArray())
+        {
+            AddComponent(pState, component.toObject());
+        }
+    }
+
+    pState.generation = generation;
+}
+
+bool CircuitJournal::WriteSnapshot(const QString& pPath, const CircuitState& pState)
+{
+    QJsonArray components;
+    for (const auto& component : pState.components)
+    {
+        if (component.has_value())
+        {
+            components.append(component.value());
+        }
+    }
+
+    auto json = pState.header;
+    json[file::JSON_COMPONENTS_IDENTIFIER] = components;
+    json[file::JSON_JOURNAL_GENERATION_IDENTIFIER] = pState.generation;
+
+    QSaveFile snapshot(pPath);
+
+    if (!snapshot.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    {
+        snapshot.write(CircuitFileParser::CompressChunked(QCborValue::fromJsonValue(json).toCbor()));
+    }
+    else
+    {
+        snapshot.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+    }
+
+    return snapshot.commit(); // Replaces the previous snapshot only if the new one has been written completely
+}
+
+std::optional<qint64> CircuitJournal::ReadJournalGeneration(const QString& pPath)
+{
+    QFile journal(pPath);
+
+    if (!journal.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+
+    const auto header = QJsonDocument::fromJson(journal.readLine()).object();
+
+    if (!header.contains(file::JSON_JOURNAL_GENERATION_IDENTIFIER))
+    {
+        return std::nullopt;
+    }
+
+    return header[file::JSON_JOURNAL_GENERATION_IDENTIFIER].toInteger();
+}
+
+QString CircuitJournal::GetJournalPath(const QFileInfo& pCircuitFile)
+{
+    return pCircuitFile.absoluteFilePath() + file::JOURNAL_FILE_SUFFIX;
+}
+
+QString CircuitJournal::GetCompactingJournalPath(const QFileInfo& pCircuitFile)
+{
+    return pCircuitFile.absoluteFilePath() + file::JOURNAL_COMPACTING_FILE_SUFFIX;
+}
+
+QString CircuitJournal::GetSnapshotPath(const QFileInfo& pCircuitFile)
+{
+    return pCircuitFile.absoluteFilePath() + file::AUTOSAVE_FILE_SUFFIX;
+}
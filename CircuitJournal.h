@@ -0,0 +1,168 @@
+#ifndef CIRCUITJOURNAL_H
+#define CIRCUITJOURNAL_H
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointF>
+#include <QPointer>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+#include <optional>
+
+///
+/// \brief The CircuitJournal class appends every edit of the open circuit as a compact delta to a journal file
+/// next to the circuit. The deltas are periodically compacted into an autosave snapshot on a worker thread.
+/// After a crash, the circuit file, the snapshot and the journals are combined to recover the unsaved edits.
+///
+/// Components are identified by their type and position (and direction for wires), which is unique in a valid circuit.
+/// Every delta removes the components with the given keys and adds the given components.
+///
+class CircuitJournal : public QObject
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the CircuitJournal
+    CircuitJournal(void);
+
+    /// \brief Destructor for the CircuitJournal, stops journaling and removes the journal files
+    ~CircuitJournal(void);
+
+    /// \brief Starts a new journal for the given circuit file, existing journal files of the file are removed
+    /// \param pCircuitFile: The circuit file, as it is stored on disk
+    void Start(const QFileInfo& pCircuitFile);
+
+    /// \brief Continues the existing journal of the given circuit file, after its edits have been recovered
+    /// \param pCircuitFile: The circuit file
+    void Resume(const QFileInfo& pCircuitFile);
+
+    /// \brief Stops journaling and removes the journal files, because the edits have been saved or discarded
+    void Stop(void);
+
+    /// \brief Returns true, if edits are currently being journaled
+    /// \return True, if a journal is open
+    bool IsActive(void) const;
+
+    /// \brief Waits until the worker thread has finished, compaction reads the circuit file, which must not be replaced meanwhile
+    void WaitForCompaction(void);
+
+    /// \brief Appends a delta to the journal and flushes it to the file
+    /// \param pRemovedKeys: The keys of all components that have been removed or changed
+    /// \param pAddedComponents: The JSON representation of all components that have been added or changed
+    void AppendDelta(const QStringList& pRemovedKeys, const std::vector<QJsonObject>& pAddedComponents);
+
+    /// \brief Returns the key that identifies the given component in the journal
+    /// \param pComponent: The JSON representation of the component
+    /// \param pShift: Offset to subtract from the position, to get the key of a previous position
+    /// \return The key of the component
+    static QString GetComponentKey(const QJsonObject& pComponent, QPointF pShift = QPointF());
+
+    /// \brief Returns true, if there are journal files of a previous session for the given circuit file
+    /// \param pCircuitFile: The circuit file
+    /// \return True, if unsaved edits can be recovered
+    static bool HasJournal(const QFileInfo& pCircuitFile);
+
+    /// \brief Combines the circuit file, the autosave snapshot and the journals to the last journaled state
+    /// \param pCircuitFile: The circuit file
+    /// \return The components of the recovered circuit, or nothing if the files could not be read
+    static std::optional<std::vector<QJsonObject>> Recover(const QFileInfo& pCircuitFile);
+
+    /// \brief Removes all journal files of the given circuit file
+    /// \param pCircuitFile: The circuit file
+    static void RemoveJournalFiles(const QFileInfo& pCircuitFile);
+
+protected slots:
+    /// \brief Rotates the journal and compacts it on the worker thread; invoked by mCompactionTimer
+    void OnCompactionTimeout(void);
+
+protected:
+    /// \brief CircuitState contains a circuit while it is being recovered or compacted
+    struct CircuitState
+    {
+        QJsonObject header;
+        std::vector<std::optional<QJsonObject>> components; // Removed components are reset instead of erased
+        QMultiHash<QString, size_t> index; // Component keys to positions in components
+        qint64 generation = 0; // The journal generation up to which all deltas are contained
+    };
+
+    /// \brief Adds a component to the state and its index
+    /// \param pState: The state to add the component to
+    /// \param pComponent: The JSON representation of the component
+    static void AddComponent(CircuitState& pState, const QJsonObject& pComponent);
+
+    /// \brief Removes the component with the given key from the state
+    /// \param pState: The state to remove the component from
+    /// \param pKey: The key of the component
+    static void RemoveComponent(CircuitState& pState, const QString& pKey);
+
+    /// \brief Opens the journal file for appending, a new file starts with a header line containing the current generation
+    /// \return False, if the journal could not be opened
+    bool OpenJournal(void);
+
+    /// \brief Writes the buffered journal entries to disk, called after every entry
+    /// \return False, if the journal could not be synced
+    bool SyncJournal(void);
+
+    /// \brief Starts compacting the journal of the previous generation on the worker thread
+    void StartCompaction(void);
+
+    /// \brief Combines the circuit file with the snapshot and the rotated journal and writes a new snapshot; runs on the worker thread
+    /// \param pCircuitFile: The circuit file
+    /// \return False, if the new snapshot could not be written
+    static bool Compact(const QFileInfo& pCircuitFile);
+
+    /// \brief Reads the autosave snapshot, or the circuit file if there is no snapshot
+    /// \param pCircuitFile: The circuit file
+    /// \return The circuit state, or nothing if the files could not be read
+    static std::optional<CircuitState> ReadBaseState(const QFileInfo& pCircuitFile);
+
+    /// \brief Reads a circuit file in the current save format
+    /// \param pPath: The path of the file
+    /// \return The circuit state, or nothing if the file could not be read
+    static std::optional<CircuitState> ReadCircuitFile(const QString& pPath);
+
+    /// \brief Applies all deltas of the given journal file to the state, if its generation is not yet contained
+    /// \param pPath: The path of the journal file
+    /// \param pState: The state to apply the deltas to
+    static void ApplyJournal(const QString& pPath, CircuitState& pState);
+
+    /// \brief Writes the state as autosave snapshot, the previous snapshot is replaced atomically
+    /// \param pPath: The path of the snapshot
+    /// \param pState: The state to write
+    /// \return False, if the snapshot could not be written
+    static bool WriteSnapshot(const QString& pPath, const CircuitState& pState);
+
+    /// \brief Returns the journal generation stored in the header line of the given journal file
+    /// \param pPath: The path of the journal file
+    /// \return The generation, or nothing if the journal could not be read
+    static std::optional<qint64> ReadJournalGeneration(const QString& pPath);
+
+    /// \brief Returns the path of the journal the edits are appended to
+    /// \param pCircuitFile: The circuit file
+    /// \return The path of the journal
+    static QString GetJournalPath(const QFileInfo& pCircuitFile);
+
+    /// \brief Returns the path of the rotated journal of the previous generation, which is being compacted
+    /// \param pCircuitFile: The circuit file
+    /// \return The path of the rotated journal
+    static QString GetCompactingJournalPath(const QFileInfo& pCircuitFile);
+
+    /// \brief Returns the path of the autosave snapshot
+    /// \param pCircuitFile: The circuit file
+    /// \return The path of the snapshot
+    static QString GetSnapshotPath(const QFileInfo& pCircuitFile);
+
+protected:
+    std::optional<QFileInfo> mCircuitFile;
+    QFile mJournal;
+    qint64 mGeneration = 0; // Generations are timestamps, so that they increase across sessions
+    uint32_t mDeltaCount = 0; // Deltas in the current generation
+
+    QTimer mCompactionTimer;
+    QPointer<QThread> mCompactionThread; // Deletes itself when finished
+};
+
+#endif // CIRCUITJOURNAL_H
@@ -0,0 +1,178 @@
+#include "CircuitLoader.h"
+#include "CircuitFileParser.h"
+#include "Configuration.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+
+CircuitLoader::CircuitLoader(const QFileInfo& pFileInfo):
+    mFileInfo(pFileInfo)
+{}
+
+CircuitLoader::~CircuitLoader()
+{
+    Cancel();
+
+    if (nullptr != mThread)
+    {
+        mThread->wait();
+        delete mThread;
+    }
+}
+
+void CircuitLoader::Start()
+{
+    Q_ASSERT(nullptr == mThread);
+
+    mThread = QThread::create([this]()
+    {
+        Decode();
+    });
+    mThread->start();
+}
+
+void CircuitLoader::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsCanceled = true;
+    }
+    mQueueNotFull.notify_all();
+}
+
+CircuitLoaderState CircuitLoader::GetState() const
+{
+    return mState;
+}
+
+std::optional<QJsonObject> CircuitLoader::GetHeader() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHeader;
+}
+
+std::vector<QJsonObject> CircuitLoader::TakeDecodedComponents(uint32_t pMaxCount)
+{
+    std::vector<QJsonObject> components;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto count = std::min<size_t>(pMaxCount, mDecodedComponents.size());
+        components.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            components.push_back(std::move(mDecodedComponents.front()));
+            mDecodedComponents.pop_front();
+        }
+    }
+
+    mQueueNotFull.notify_all();
+    return components;
+}
+
+uint32_t CircuitLoader::GetDecodedCount() const
+{
+    return mDecodedCount;
+}
+
+const QFileInfo& CircuitLoader::GetFileInfo() const
+{
+    return mFileInfo;
+}
+
+void CircuitLoader::Decode()
+{
+    QFile loadFile(mFileInfo.absoluteFilePath());
+
+    if (!loadFile.open(QIODevice::ReadOnly))
+    {
+        mState = CircuitLoaderState::FAILED;
+        return;
+    }
+
+    // Mapped data is only read until it has been decompressed or parsed, while loadFile is still open
+    QByteArray rawData = CircuitFileParser::MapFile(loadFile);
+
+    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    {
+        rawData = CircuitFileParser::DecompressCircuit(rawData).value_or(QByteArray());
+
+        const auto header = rawData.isEmpty() ? std::nullopt : CircuitFileParser::ReadCborHeader(rawData);
+
+        if (!header.has_value())
+        {
+            mState = CircuitLoaderState::FAILED;
+            return;
+        }
+
+        SetHeader(header.value());
+
+        const auto result = CircuitFileParser::ReadCborComponents(rawData, [this](const QJsonObject& pComponent)
+        {
+            return PushComponent(pComponent);
+        });
+
+        if (result == file::ComponentReadResult::INVALID)
+        {
+            mState = CircuitLoaderState::FAILED;
+            return;
+        }
+
+        if (result == file::ComponentReadResult::TRUNCATED)
+        {
+            qDebug() << "Circuit file truncated or corrupted, loaded the readable components";
+        }
+    }
+    else
+    {
+        auto json = QJsonDocument::fromJson(rawData).object();
+        rawData.clear();
+
+        auto components = json.take(file::JSON_COMPONENTS_IDENTIFIER).toArray();
+        SetHeader(json);
+
+        for (const auto& component : components)
+        {
+            if (!PushComponent(component.toObject()))
+            {
+                break;
+            }
+        }
+    }
+
+    mState = CircuitLoaderState::FINISHED;
+}
+
+bool CircuitLoader::PushComponent(const QJsonObject& pComponent)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    // Limits the memory of decoded but not yet created components, if the GUI thread falls behind
+    mQueueNotFull.wait(lock, [this]()
+    {
+        return mIsCanceled || mDecodedComponents.size() < file::LOAD_QUEUE_CAPACITY;
+    });
+
+    if (mIsCanceled)
+    {
+        return false;
+    }
+
+    mDecodedComponents.push_back(pComponent);
+    mDecodedCount++;
+    return true;
+}
+
+void CircuitLoader::SetHeader(const QJsonObject& pHeader)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mHeader = pHeader;
+    }
+    mState = CircuitLoaderState::DECODING_COMPONENTS;
+}
@@ -0,0 +1,91 @@
+#ifndef CIRCUITLOADER_H
+#define CIRCUITLOADER_H
+
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QThread>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/// \brief CircuitLoaderState contains the states of the worker thread of a CircuitLoader
+enum class CircuitLoaderState
+{
+    DECODING_HEADER = 0,    // The file is read, decompressed and the versions are decoded
+    DECODING_COMPONENTS,    // The header is available, components are being decoded
+    FINISHED,               // All components have been decoded
+    FAILED                  // The file could not be read or decoded
+};
+
+///
+/// \brief The CircuitLoader class reads, decompresses and decodes a circuit file on a worker thread.
+/// Decoded components are queued and taken by the GUI thread in batches, because QGraphicsItems
+/// can only be created there.
+///
+class CircuitLoader
+{
+public:
+    /// \brief Constructor for the CircuitLoader
+    /// \param pFileInfo: The circuit file to load
+    CircuitLoader(const QFileInfo& pFileInfo);
+
+    /// \brief Destructor for the CircuitLoader, cancels decoding and waits for the worker thread
+    ~CircuitLoader(void);
+
+    /// \brief Starts decoding the file on the worker thread
+    void Start(void);
+
+    /// \brief Stops the worker thread as soon as possible, queued components are discarded
+    void Cancel(void);
+
+    /// \brief Getter for the current state of the worker thread
+    /// \return The current state
+    CircuitLoaderState GetState(void) const;
+
+    /// \brief Getter for the top level entries (versions etc.) of the circuit
+    /// \return The header, or nothing if it has not been decoded yet
+    std::optional<QJsonObject> GetHeader(void) const;
+
+    /// \brief Takes decoded components out of the queue
+    /// \param pMaxCount: The maximum amount of components to take
+    /// \return The decoded components in file order, empty if none are ready yet
+    std::vector<QJsonObject> TakeDecodedComponents(uint32_t pMaxCount);
+
+    /// \brief Getter for the amount of components that have been decoded so far
+    /// \return The amount of decoded components
+    uint32_t GetDecodedCount(void) const;
+
+    /// \brief Getter for the loaded file
+    /// \return The file info of the loaded file
+    const QFileInfo& GetFileInfo(void) const;
+
+protected:
+    /// \brief Reads and decodes the file, runs on the worker thread
+    void Decode(void);
+
+    /// \brief Appends a decoded component to the queue, blocks while the queue is full
+    /// \param pComponent: The decoded component
+    /// \return False, if loading has been canceled
+    bool PushComponent(const QJsonObject& pComponent);
+
+    /// \brief Stores the decoded header and enters the DECODING_COMPONENTS state
+    /// \param pHeader: The top level entries of the circuit
+    void SetHeader(const QJsonObject& pHeader);
+
+protected:
+    QFileInfo mFileInfo;
+    QThread* mThread = nullptr;
+
+    std::atomic<CircuitLoaderState> mState{CircuitLoaderState::DECODING_HEADER};
+    std::atomic<bool> mIsCanceled{false};
+    std::atomic<uint32_t> mDecodedCount{0};
+
+    mutable std::mutex mMutex; // Guards the header and the queue
+    std::condition_variable mQueueNotFull;
+    std::optional<QJsonObject> mHeader;
+    std::deque<QJsonObject> mDecodedComponents;
+};
+
+#endif // CIRCUITLOADER_H
@@ -0,0 +1,260 @@
+#include "CircuitTracer.h"
+#include "CoreLogic.h"
+#include "View.h"
+#include "Configuration.h"
+#include "Components/LogicWire.h"
+#include "Components/ConPoint.h"
+#include "Components/Inputs/LogicInput.h"
+#include "Components/Inputs/LogicButton.h"
+#include "Components/Inputs/LogicCells/LogicInputCell.h"
+#include "Components/Inputs/LogicCells/LogicButtonCell.h"
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <algorithm>
+#include <map>
+#include <random>
+
+CircuitTracer::CircuitTracer(CoreLogic& pCoreLogic, const View& pView):
+    mCoreLogic(pCoreLogic),
+    mView(pView)
+{}
+
+bool CircuitTracer::Record(const QFileInfo& pCircuit, const QString& pTracePath, uint32_t pTicks, uint32_t pSeed)
+{
+    const auto trace = Trace(pCircuit, pTicks, pSeed);
+
+    if (trace.isEmpty())
+    {
+        return false;
+    }
+
+    QFile traceFile(pTracePath);
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        QTextStream(stderr) << "Could not write trace " << pTracePath << Qt::endl;
+        return false;
+    }
+
+    QTextStream stream(&traceFile);
+    for (const auto& line : trace)
+    {
+        stream << line << Qt::endl;
+    }
+
+    return true;
+}
+
+bool CircuitTracer::Compare(const QFileInfo& pCircuit, const QString& pReferencePath)
+{
+    QTextStream err(stderr);
+
+    QFile referenceFile(pReferencePath);
+    if (!referenceFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        err << "Could not open reference trace " << pReferencePath << Qt::endl;
+        return false;
+    }
+
+    const auto reference = QString(referenceFile.readAll()).split('\n', Qt::SkipEmptyParts);
+    const auto match = QRegularExpression("^# seed=(\\d+) ticks=(\\d+)$").match(reference.value(0));
+
+    if (reference.size() < 2 || !match.hasMatch())
+    {
+        err << "Invalid reference trace " << pReferencePath << Qt::endl;
+        return false;
+    }
+
+    const auto actual = Trace(pCircuit, match.captured(2).toUInt(), match.captured(1).toUInt());
+
+    if (actual.isEmpty())
+    {
+        err << "Could not load circuit " << pCircuit.absoluteFilePath() << Qt::endl;
+        return false;
+    }
+
+    const auto referenceProbes = reference[1].split(',');
+    const auto actualProbes = actual[1].split(',');
+
+    if (referenceProbes != actualProbes)
+    {
+        for (int32_t i = 0; i < std::max(referenceProbes.size(), actualProbes.size()); i++)
+        {
+            if (referenceProbes.value(i) != actualProbes.value(i))
+            {
+                err << "Circuit structure differs at column " << i << ": expected " << referenceProbes.value(i, "<none>")
+                    << ", got " << actualProbes.value(i, "<none>") << Qt::endl;
+                break;
+            }
+        }
+        return false;
+    }
+
+    for (int32_t line = 2; line < std::max(reference.size(), actual.size()); line++)
+    {
+        const auto expectedStates = reference.value(line).section(',', 1);
+        const auto actualStates = actual.value(line).section(',', 1);
+
+        if (expectedStates == actualStates)
+        {
+            continue;
+        }
+
+        for (int32_t i = 0; i < std::max(expectedStates.size(), actualStates.size()); i++)
+        {
+            const auto expected = expectedStates.mid(i, 1);
+            const auto result = actualStates.mid(i, 1);
+
+            if (expected != result)
+            {
+                // Column 0 is the tick, the line index is offset by the two header lines
+                err << "First divergence at tick " << (line - 1) << " in " << actualProbes.value(i + 1)
+                    << ": expected " << (expected.isEmpty() ? "<none>" : expected)
+                    << ", got " << (result.isEmpty() ? "<none>" : result) << Qt::endl;
+                return false;
+            }
+        }
+    }
+
+    err << "All " << (actual.size() - 2) << " ticks match the reference trace" << Qt::endl;
+    return true;
+}
+
+QStringList CircuitTracer::Trace(const QFileInfo& pCircuit, uint32_t pTicks, uint32_t pSeed)
+{
+    if (!pCircuit.exists())
+    {
+        return QStringList();
+    }
+
+    mCoreLogic.NewCircuit();
+    mCoreLogic.GetCircuitFileParser().LoadJson(pCircuit);
+    mCoreLogic.EnterControlMode(ControlMode::SIMULATION);
+    mCoreLogic.PauseSimulation(); // Entering the simulation starts the propagation timer, ticks are stepped manually below
+
+    const auto probes = CollectProbes();
+    const auto stimulusCells = CollectStimulusCells();
+
+    QStringList trace;
+    trace << QString("# seed=%0 ticks=%1").arg(pSeed).arg(pTicks);
+
+    QStringList header{"tick"};
+    for (const auto& probe : probes)
+    {
+        header << probe.name;
+    }
+    trace << header.join(',');
+
+    // The raw engine output is used instead of a distribution to get the same stimulus on every standard library
+    std::mt19937 random(pSeed);
+
+    for (uint32_t tick = 1; tick <= pTicks; tick++)
+    {
+        for (const auto& cell : stimulusCells)
+        {
+            if (random() % 1000 >= tracing::CIRCUIT_TRACE_TOGGLE_PERMILLE)
+            {
+                continue;
+            }
+
+            if (nullptr != std::dynamic_pointer_cast<LogicInputCell>(cell))
+            {
+                std::static_pointer_cast<LogicInputCell>(cell)->ToggleState();
+            }
+            else
+            {
+                std::static_pointer_cast<LogicButtonCell>(cell)->ButtonClick();
+            }
+        }
+
+        mCoreLogic.StepSimulation();
+
+        QString states;
+        states.reserve(probes.size());
+        for (const auto& probe : probes)
+        {
+            states.append((probe.cell->GetOutputState(probe.output) == LogicState::HIGH) ? '1' : '0');
+        }
+        trace << QString::number(tick) + ',' + states;
+    }
+
+    mCoreLogic.NewCircuit();
+
+    return trace;
+}
+
+std::vector<CircuitTracer::Probe> CircuitTracer::CollectProbes() const
+{
+    std::vector<Probe> probes;
+    std::map<std::shared_ptr<LogicBaseCell>, QPointF> netPositions; // Top left most wire position of every net
+
+    for (const auto& item : mView.Scene()->items())
+    {
+        auto comp = dynamic_cast<IBaseComponent*>(item);
+        if (nullptr == comp || nullptr == comp->GetLogicCell())
+        {
+            continue;
+        }
+
+        if (nullptr != dynamic_cast<LogicWire*>(comp)
+                || (nullptr != dynamic_cast<ConPoint*>(comp) && static_cast<ConPoint*>(comp)->GetConnectionType() == ConnectionType::FULL))
+        {
+            const auto pos = comp->pos();
+            auto [entry, isNew] = netPositions.emplace(comp->GetLogicCell(), pos);
+            if (!isNew && (pos.y() < entry->second.y() || (pos.y() == entry->second.y() && pos.x() < entry->second.x())))
+            {
+                entry->second = pos;
+            }
+            continue;
+        }
+
+        const auto cell = comp->GetLogicCell();
+        const auto name = QString("%0@%1:%2").arg(comp->metaObject()->className()).arg(comp->x()).arg(comp->y());
+
+        for (uint32_t output = 0; output < cell->GetOutputCount(); output++)
+        {
+            probes.push_back(Probe{QString("%0.o%1").arg(name).arg(output), cell, output});
+        }
+    }
+
+    for (const auto& [cell, pos] : netPositions)
+    {
+        probes.push_back(Probe{QString("net@%0:%1").arg(pos.x()).arg(pos.y()), cell, 0});
+    }
+
+    // Scene item order is not guaranteed to be stable between builds, names are
+    std::sort(probes.begin(), probes.end(), [](const Probe& pA, const Probe& pB)
+    {
+        return pA.name < pB.name;
+    });
+
+    return probes;
+}
+
+std::vector<std::shared_ptr<LogicBaseCell>> CircuitTracer::CollectStimulusCells() const
+{
+    std::vector<std::pair<QPointF, std::shared_ptr<LogicBaseCell>>> stimulusCells;
+
+    for (const auto& item : mView.Scene()->items())
+    {
+        if (nullptr != dynamic_cast<LogicInput*>(item) || nullptr != dynamic_cast<LogicButton*>(item))
+        {
+            auto comp = static_cast<IBaseComponent*>(item);
+            stimulusCells.emplace_back(comp->pos(), comp->GetLogicCell());
+        }
+    }
+
+    std::sort(stimulusCells.begin(), stimulusCells.end(), [](const auto& pA, const auto& pB)
+    {
+        return (pA.first.y() < pB.first.y()) || (pA.first.y() == pB.first.y() && pA.first.x() < pB.first.x());
+    });
+
+    std::vector<std::shared_ptr<LogicBaseCell>> cells;
+    for (const auto& [pos, cell] : stimulusCells)
+    {
+        cells.push_back(cell);
+    }
+
+    return cells;
+}
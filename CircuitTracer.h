@@ -0,0 +1,70 @@
+#ifndef CIRCUITTRACER_H
+#define CIRCUITTRACER_H
+
+#include "Components/LogicBaseCell.h"
+
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+
+class CoreLogic;
+class View;
+
+///
+/// \brief The CircuitTracer class simulates a circuit file under seeded random input stimulus and records every net
+/// and component output state per tick. Traces recorded with one build of the simulation engine can be compared
+/// against another build to find the first tick and component where the engines diverge.
+///
+class CircuitTracer
+{
+public:
+    /// \brief Constructor for the CircuitTracer
+    /// \param pCoreLogic: Reference to the core logic to load and simulate the circuit
+    /// \param pView: Reference to the view containing the scene of the loaded circuit
+    CircuitTracer(CoreLogic& pCoreLogic, const View& pView);
+
+    /// \brief Simulates the given circuit and writes the trace to the given path
+    /// \param pCircuit: The circuit file to simulate
+    /// \param pTracePath: The path of the trace file to write
+    /// \param pTicks: The number of ticks to simulate
+    /// \param pSeed: The seed of the random input stimulus
+    /// \return False, if the circuit could not be loaded or the trace could not be written
+    bool Record(const QFileInfo& pCircuit, const QString& pTracePath, uint32_t pTicks, uint32_t pSeed);
+
+    /// \brief Simulates the given circuit with the ticks and seed of the reference trace and compares the states
+    /// The first divergence is reported on stderr
+    /// \param pCircuit: The circuit file to simulate
+    /// \param pReferencePath: The path of the reference trace
+    /// \return True, if all states match the reference
+    bool Compare(const QFileInfo& pCircuit, const QString& pReferencePath);
+
+protected:
+    /// \brief Probe is a named logic cell output whose state is recorded every tick
+    struct Probe
+    {
+        QString name;
+        std::shared_ptr<LogicBaseCell> cell;
+        uint32_t output;
+    };
+
+    /// \brief Loads and simulates the given circuit and records the trace
+    /// \param pCircuit: The circuit file to simulate
+    /// \param pTicks: The number of ticks to simulate
+    /// \param pSeed: The seed of the random input stimulus
+    /// \return The trace lines, or an empty list if the circuit could not be loaded
+    QStringList Trace(const QFileInfo& pCircuit, uint32_t pTicks, uint32_t pSeed);
+
+    /// \brief Collects all nets and component outputs of the simulated circuit, sorted by name
+    /// \return The probes of the current simulation
+    std::vector<Probe> CollectProbes(void) const;
+
+    /// \brief Collects the cells of all inputs and buttons of the simulated circuit, sorted by position
+    /// \return The cells the random stimulus is applied to
+    std::vector<std::shared_ptr<LogicBaseCell>> CollectStimulusCells(void) const;
+
+protected:
+    CoreLogic& mCoreLogic;
+    const View& mView;
+};
+
+#endif // CIRCUITTRACER_H
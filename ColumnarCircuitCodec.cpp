@@ -0,0 +1,365 @@
+#include "ColumnarCircuitCodec.h"
+#include "Configuration.h"
+#include "HelperFunctions.h"
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
+namespace
+{
+constexpr auto GROUP_TYPE_KEY = "type";
+constexpr auto GROUP_COUNT_KEY = "count";
+constexpr auto GROUP_COLUMNS_KEY = "columns";
+
+// Only these fields are positions or lengths on the grid and may be quantized
+constexpr auto X_KEY = "x";
+constexpr auto Y_KEY = "y";
+constexpr auto LENGTH_KEY = "length";
+}
+
+ColumnarCircuitCodec::ColumnarCircuitCodec(QCborStreamWriter& pWriter):
+    mWriter(pWriter),
+    mMinVersion(0, 0, 0)
+{
+    mWriter.startArray(); // Indefinite length, groups are written as soon as they are full
+}
+
+void ColumnarCircuitCodec::AddComponent(const QJsonObject& pJson, SwVersion pMinVersion)
+{
+    const auto type = pJson[file::JSON_TYPE_IDENTIFIER].toInt();
+    auto& group = mGroups[type];
+
+    for (auto field = pJson.constBegin(); field != pJson.constEnd(); field++)
+    {
+        if (field.key() == file::JSON_TYPE_IDENTIFIER)
+        {
+            continue;
+        }
+
+        auto& column = group.columns[field.key()];
+        column.resize(group.count, QCborValue(QCborSimpleType::Undefined)); // Fields missing in earlier components
+        column.push_back(QCborValue::fromJsonValue(field.value()));
+    }
+
+    group.count++;
+
+    mMinVersion = GetNewerVersion(mMinVersion, pMinVersion);
+    mHasComponents = true;
+
+    if (group.count >= file::COLUMNAR_GROUP_SIZE)
+    {
+        WriteGroup(mWriter, type, group);
+        group = ComponentGroup();
+    }
+}
+
+void ColumnarCircuitCodec::Finish()
+{
+    for (const auto& [type, group] : mGroups)
+    {
+        if (group.count > 0)
+        {
+            WriteGroup(mWriter, type, group);
+        }
+    }
+
+    mGroups.clear();
+    mWriter.endArray();
+}
+
+SwVersion ColumnarCircuitCodec::GetMinVersion() const
+{
+    if (!mHasComponents)
+    {
+        return mMinVersion; // Older versions skip the unknown key and read the same empty circuit
+    }
+
+    return GetNewerVersion(mMinVersion, file::COLUMNAR_MIN_VERSION);
+}
+
+bool ColumnarCircuitCodec::Read(QCborStreamReader& pReader, const std::function<bool(const QJsonObject&)>& pComponentHandler)
+{
+    if (!pReader.isArray() || !pReader.enterContainer())
+    {
+        return false;
+    }
+
+    while (pReader.hasNext())
+    {
+        // Only one group is decoded at a time
+        if (!ReadGroup(pReader, pComponentHandler))
+        {
+            return false;
+        }
+    }
+
+    pReader.leaveContainer();
+    return (pReader.lastError() == QCborError::NoError);
+}
+
+ColumnEncoding ColumnarCircuitCodec::GetColumnEncoding(const QString& pKey, const std::vector<QCborValue>& pColumn)
+{
+    const bool isInteger = std::all_of(pColumn.cbegin(), pColumn.cend(), [](const QCborValue& pValue)
+    {
+        return pValue.isInteger();
+    });
+
+    if (!isInteger)
+    {
+        return ColumnEncoding::VALUES;
+    }
+
+    const bool isOnGrid = std::all_of(pColumn.cbegin(), pColumn.cend(), [](const QCborValue& pValue)
+    {
+        return (pValue.toInteger() % static_cast<qint64>(canvas::GRID_SIZE) == 0);
+    });
+
+    if (isOnGrid && (pKey == X_KEY || pKey == Y_KEY))
+    {
+        return ColumnEncoding::GRID_DELTA;
+    }
+
+    if (isOnGrid && pKey == LENGTH_KEY)
+    {
+        return ColumnEncoding::GRID;
+    }
+
+    return ColumnEncoding::INTEGERS;
+}
+
+void ColumnarCircuitCodec::WriteGroup(QCborStreamWriter& pWriter, int32_t pType, const ComponentGroup& pGroup)
+{
+    // Sort the components top to bottom, left to right, so that position deltas stay small
+    std::vector<uint32_t> order(pGroup.count);
+    std::iota(order.begin(), order.end(), 0);
+
+    const auto xColumn = pGroup.columns.find(X_KEY);
+    const auto yColumn = pGroup.columns.find(Y_KEY);
+
+    if (xColumn != pGroup.columns.end() && yColumn != pGroup.columns.end()
+            && xColumn->second.size() == pGroup.count && yColumn->second.size() == pGroup.count)
+    {
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t pA, uint32_t pB)
+        {
+            const auto ya = yColumn->second[pA].toDouble();
+            const auto yb = yColumn->second[pB].toDouble();
+            return (ya < yb) || (ya == yb && xColumn->second[pA].toDouble() < xColumn->second[pB].toDouble());
+        });
+    }
+
+    pWriter.startMap(3);
+
+    pWriter.append(QLatin1String(GROUP_TYPE_KEY));
+    pWriter.append(static_cast<qint64>(pType));
+
+    pWriter.append(QLatin1String(GROUP_COUNT_KEY));
+    pWriter.append(static_cast<quint64>(pGroup.count));
+
+    pWriter.append(QLatin1String(GROUP_COLUMNS_KEY));
+    pWriter.startMap(pGroup.columns.size());
+
+    for (const auto& [key, sparseColumn] : pGroup.columns)
+    {
+        auto column = sparseColumn;
+        column.resize(pGroup.count, QCborValue(QCborSimpleType::Undefined)); // Fields missing in the last components
+
+        const auto encoding = GetColumnEncoding(key, column);
+
+        pWriter.append(key);
+        pWriter.startArray(2);
+        pWriter.append(static_cast<quint64>(encoding));
+        pWriter.startArray(pGroup.count);
+
+        qint64 previous = 0;
+        for (const auto& index : order)
+        {
+            switch (encoding)
+            {
+                case ColumnEncoding::VALUES:
+                {
+                    column[index].toCbor(pWriter);
+                    break;
+                }
+                case ColumnEncoding::INTEGERS:
+                {
+                    pWriter.append(column[index].toInteger());
+                    break;
+                }
+                case ColumnEncoding::GRID:
+                {
+                    pWriter.append(column[index].toInteger() / static_cast<qint64>(canvas::GRID_SIZE));
+                    break;
+                }
+                case ColumnEncoding::GRID_DELTA:
+                {
+                    const auto value = column[index].toInteger() / static_cast<qint64>(canvas::GRID_SIZE);
+                    pWriter.append(value - previous);
+                    previous = value;
+                    break;
+                }
+                default:
+                {
+                    throw std::logic_error("Column encoding invalid");
+                }
+            }
+        }
+
+        pWriter.endArray();
+        pWriter.endArray();
+    }
+
+    pWriter.endMap();
+    pWriter.endMap();
+}
+
+bool ColumnarCircuitCodec::ReadGroup(QCborStreamReader& pReader, const std::function<bool(const QJsonObject&)>& pComponentHandler)
+{
+    if (!pReader.isMap() || !pReader.enterContainer())
+    {
+        return false;
+    }
+
+    std::optional<qint64> type;
+    std::vector<QJsonObject> components;
+
+    while (pReader.hasNext())
+    {
+        const auto key = QCborValue::fromCbor(pReader).toString();
+
+        if (key == GROUP_TYPE_KEY && pReader.isInteger())
+        {
+            type = pReader.toInteger();
+            pReader.next();
+        }
+        else if (key == GROUP_COUNT_KEY && pReader.isUnsignedInteger() && type.has_value())
+        {
+            const auto count = pReader.toUnsignedInteger();
+            pReader.next();
+
+            // The count is read from the file, groups of valid files never exceed the group size
+            if (count > file::COLUMNAR_GROUP_SIZE)
+            {
+                return false;
+            }
+
+            components.resize(count);
+            for (auto& component : components)
+            {
+                component[file::JSON_TYPE_IDENTIFIER] = type.value();
+            }
+        }
+        else if (key == GROUP_COLUMNS_KEY && !components.empty())
+        {
+            if (!ReadColumns(pReader, components))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            pReader.next();
+        }
+    }
+
+    pReader.leaveContainer();
+
+    if (pReader.lastError() != QCborError::NoError)
+    {
+        return false;
+    }
+
+    for (const auto& component : components)
+    {
+        if (!pComponentHandler(component))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ColumnarCircuitCodec::ReadColumns(QCborStreamReader& pReader, std::vector<QJsonObject>& pComponents)
+{
+    if (!pReader.isMap() || !pReader.enterContainer())
+    {
+        return false;
+    }
+
+    const auto count = static_cast<qint64>(pComponents.size());
+
+    while (pReader.hasNext())
+    {
+        const auto key = QCborValue::fromCbor(pReader).toString();
+
+        if (!pReader.isArray() || !pReader.enterContainer() || !pReader.hasNext() || !pReader.isUnsignedInteger())
+        {
+            return false;
+        }
+
+        // Files with encodings of newer versions are rejected by the columnar version check, an unknown encoding means corrupted data
+        if (pReader.toUnsignedInteger() > static_cast<quint64>(ColumnEncoding::GRID_DELTA))
+        {
+            return false;
+        }
+
+        const auto encoding = static_cast<ColumnEncoding>(pReader.toUnsignedInteger());
+        pReader.next();
+
+        // Falling back to the defaults of the field would load the components with silently changed properties
+        if (!pReader.isArray() || !pReader.isLengthKnown() || pReader.length() != static_cast<quint64>(count) || !pReader.enterContainer())
+        {
+            return false;
+        }
+
+        qint64 previous = 0;
+        for (qint64 i = 0; i < count && pReader.hasNext(); i++)
+        {
+            const auto value = QCborValue::fromCbor(pReader);
+
+            switch (encoding)
+            {
+                case ColumnEncoding::VALUES:
+                {
+                    if (!value.isUndefined())
+                    {
+                        pComponents[i][key] = value.toJsonValue();
+                    }
+                    break;
+                }
+                case ColumnEncoding::INTEGERS:
+                {
+                    pComponents[i][key] = value.toInteger();
+                    break;
+                }
+                case ColumnEncoding::GRID:
+                {
+                    pComponents[i][key] = value.toInteger() * static_cast<qint64>(canvas::GRID_SIZE);
+                    break;
+                }
+                case ColumnEncoding::GRID_DELTA:
+                {
+                    previous += value.toInteger();
+                    pComponents[i][key] = previous * static_cast<qint64>(canvas::GRID_SIZE);
+                    break;
+                }
+                default:
+                {
+                    throw std::logic_error("Column encoding invalid");
+                }
+            }
+        }
+
+        pReader.leaveContainer();
+
+        while (pReader.hasNext())
+        {
+            pReader.next(); // Containers can only be left at their end
+        }
+        pReader.leaveContainer(); // Encoding and data array
+    }
+
+    pReader.leaveContainer();
+    return (pReader.lastError() == QCborError::NoError);
+}
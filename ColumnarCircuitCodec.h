@@ -0,0 +1,94 @@
+#ifndef COLUMNARCIRCUITCODEC_H
+#define COLUMNARCIRCUITCODEC_H
+
+#include "HelperStructures.h"
+
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QJsonObject>
+#include <functional>
+#include <map>
+
+/// \brief ColumnEncoding contains the encodings of a column in the columnar circuit format
+enum class ColumnEncoding
+{
+    VALUES = 0,     // Any CBOR values, undefined for components without this field
+    INTEGERS,       // Plain integers
+    GRID,           // Integers in canvas::GRID_SIZE units
+    GRID_DELTA      // Integers in canvas::GRID_SIZE units, each stored as difference to its predecessor
+};
+
+///
+/// \brief The ColumnarCircuitCodec class encodes components grouped by their file::ComponentId,
+/// with every JSON field of a group stored as one typed column instead of one map per component.
+/// Groups hold at most file::COLUMNAR_GROUP_SIZE components and are written as soon as they are full,
+/// so that neither writing nor reading holds the columns of the whole circuit in memory.
+///
+class ColumnarCircuitCodec
+{
+public:
+    /// \brief Constructor for the ColumnarCircuitCodec, starts the group array, the key has to be written before
+    /// \param pWriter: The CBOR stream to write into, it must outlive the codec
+    ColumnarCircuitCodec(QCborStreamWriter& pWriter);
+
+    /// \brief Adds the JSON representation of a component to its group, full groups are written immediately
+    /// \param pJson: The JSON representation of the component, as returned by GetJson()
+    /// \param pMinVersion: The minimum software version needed to read the component
+    void AddComponent(const QJsonObject& pJson, SwVersion pMinVersion);
+
+    /// \brief Writes the remaining groups and ends the group array
+    void Finish(void);
+
+    /// \brief Returns the minimum software version needed to read the written components in the columnar encoding
+    /// \return The minimum version
+    SwVersion GetMinVersion(void) const;
+
+    /// \brief Decodes the columnar groups at the current position of the reader, one group at a time
+    /// \param pReader: The CBOR stream, positioned at the group array
+    /// \param pComponentHandler: Function that is called with the reconstructed JSON object of every component, returns false to stop decoding
+    /// \return False, if decoding has been stopped by the handler or a group is invalid
+    static bool Read(QCborStreamReader& pReader, const std::function<bool(const QJsonObject&)>& pComponentHandler);
+
+protected:
+    /// \brief ComponentGroup contains the columns of up to file::COLUMNAR_GROUP_SIZE components of one type
+    struct ComponentGroup
+    {
+        uint32_t count = 0;
+        std::map<QString, std::vector<QCborValue>> columns;
+    };
+
+    /// \brief Chooses the most compact encoding for the given column
+    /// \param pKey: The JSON key of the column
+    /// \param pColumn: The values of the column
+    /// \return The encoding to use
+    static ColumnEncoding GetColumnEncoding(const QString& pKey, const std::vector<QCborValue>& pColumn);
+
+    /// \brief Writes the given group, sorted by position so that the position deltas are small
+    /// \param pWriter: The CBOR stream to write into
+    /// \param pType: The file::ComponentId of the group
+    /// \param pGroup: The group to write
+    static void WriteGroup(QCborStreamWriter& pWriter, int32_t pType, const ComponentGroup& pGroup);
+
+    /// \brief Decodes the group map at the current position of the reader and passes its components to the handler
+    /// \param pReader: The CBOR stream, positioned at the group map
+    /// \param pComponentHandler: Function that is called with the reconstructed JSON object of every component, returns false to stop decoding
+    /// \return False, if decoding has been stopped by the handler or the group is invalid
+    static bool ReadGroup(QCborStreamReader& pReader, const std::function<bool(const QJsonObject&)>& pComponentHandler);
+
+    /// \brief Decodes the column map of a group into the given components
+    /// \param pReader: The CBOR stream, positioned at the column map
+    /// \param pComponents: The components of the group, one entry per component
+    /// \return False, if the column map is invalid
+    static bool ReadColumns(QCborStreamReader& pReader, std::vector<QJsonObject>& pComponents);
+
+protected:
+    QCborStreamWriter& mWriter;
+
+    std::map<int32_t, ComponentGroup> mGroups;
+
+    SwVersion mMinVersion;
+    bool mHasComponents = false;
+};
+
+#endif // COLUMNARCIRCUITCODEC_H
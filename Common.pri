@@ -65,6 +65,16 @@ HEADERS += \
     $${PWD}/Components/Outputs/LogicOutput.h \
     $${PWD}/Components/LogicWire.h \
     $${PWD}/CoreLogic.h \
+    $${PWD}/Benchmark.h \
+    $${PWD}/CircuitGenerator.h \
+    $${PWD}/CircuitTracer.h \
+    $${PWD}/CircuitLoader.h \
+    $${PWD}/CircuitJournal.h \
+    $${PWD}/NetlistCache.h \
+    $${PWD}/NetlistImporter.h \
+    $${PWD}/ColumnarCircuitCodec.h \
+    $${PWD}/ChunkedCompressionDevice.h \
+    $${PWD}/LogicCellTracer.h \
     $${PWD}/HelperFunctions.h \
     $${PWD}/HelperStructures.h \
     $${PWD}/Gui/MainWindow.h \
@@ -74,11 +84,20 @@ HEADERS += \
     $${PWD}/Undo/UndoDeleteType.h \
     $${PWD}/Undo/UndoMoveType.h \
     $${PWD}/View.h \
+    $${PWD}/WireLayer.h \
+    $${PWD}/TileCache.h \
+    $${PWD}/RenderStatistics.h \
+    $${PWD}/ViewportTracker.h \
+    $${PWD}/SpatialIndex.h \
+    $${PWD}/SceneHelper.h \
+    $${PWD}/PngStreamWriter.h \
+    $${PWD}/CircuitExporter.h \
     $${PWD}/Configuration.h \
     $${PWD}/Gui/AboutDialog.h \
     $${PWD}/Gui/WelcomeDialog.h \
     $${PWD}/Gui/IconToolButton.h \
-    $${PWD}/Gui/TutorialFrame.h
+    $${PWD}/Gui/TutorialFrame.h \
+    $${PWD}/Gui/Minimap.h
 
 SOURCES += \
     $$PWD/CircuitFileParser.cpp \
@@ -147,6 +166,16 @@ SOURCES += \
     $${PWD}/Components/Outputs/LogicOutput.cpp \
     $${PWD}/Components/LogicWire.cpp \
     $${PWD}/CoreLogic.cpp \
+    $${PWD}/Benchmark.cpp \
+    $${PWD}/CircuitGenerator.cpp \
+    $${PWD}/CircuitTracer.cpp \
+    $${PWD}/CircuitLoader.cpp \
+    $${PWD}/CircuitJournal.cpp \
+    $${PWD}/NetlistCache.cpp \
+    $${PWD}/NetlistImporter.cpp \
+    $${PWD}/ColumnarCircuitCodec.cpp \
+    $${PWD}/ChunkedCompressionDevice.cpp \
+    $${PWD}/LogicCellTracer.cpp \
     $${PWD}/Undo/UndoAddType.cpp \
     $${PWD}/Undo/UndoBaseType.cpp \
     $${PWD}/Undo/UndoConfigureType.cpp \
@@ -154,10 +183,18 @@ SOURCES += \
     $${PWD}/Undo/UndoMoveType.cpp \
     $${PWD}/Gui/MainWindow.cpp \
     $${PWD}/View.cpp \
+    $${PWD}/WireLayer.cpp \
+    $${PWD}/TileCache.cpp \
+    $${PWD}/RenderStatistics.cpp \
+    $${PWD}/ViewportTracker.cpp \
+    $${PWD}/SpatialIndex.cpp \
+    $${PWD}/PngStreamWriter.cpp \
+    $${PWD}/CircuitExporter.cpp \
     $${PWD}/Gui/AboutDialog.cpp \
     $${PWD}/Gui/WelcomeDialog.cpp \
     $${PWD}/Gui/IconToolButton.cpp \
-    $${PWD}/Gui/TutorialFrame.cpp
+    $${PWD}/Gui/TutorialFrame.cpp \
+    $${PWD}/Gui/Minimap.cpp
 
 INCLUDEPATH += $${PWD}
 
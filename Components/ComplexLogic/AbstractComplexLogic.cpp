@@ -1,6 +1,8 @@
 #include "AbstractComplexLogic.h"
 #include "Configuration.h"
 
+#include <algorithm>
+
 #warning trapezoid components should inherit IBaseComponent directly
 AbstractComplexLogic::AbstractComplexLogic(const CoreLogic* pCoreLogic, const std::shared_ptr<LogicBaseCell>& pLogicCell, uint8_t pInputCount, uint8_t pOutputCount,
                                            Direction pDirection, uint8_t pTopInputCount, bool pStrechTwoPins, bool pTrapezoidShape):
@@ -215,6 +217,8 @@ void AbstractComplexLogic::paint(QPainter *pPainter, const QStyleOptionGraphicsI
     Q_ASSERT(pItem);
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pItem->levelOfDetailFromTransform(pPainter->worldTransform());
 
     // Draw connectors and inversion circles behind the body
@@ -268,17 +272,17 @@ void AbstractComplexLogic::paint(QPainter *pPainter, const QStyleOptionGraphicsI
         pPainter->drawPolygon(mTrapezoid);
     }
 
+    if (levelOfDetail >= std::min(components::DESCRIPTION_TEXT_MIN_LOD, components::SMALL_TEXT_MIN_LOD))
+    {
+        UpdateStaticTexts();
+    }
+
     // Draw description text
     if (levelOfDetail >= components::DESCRIPTION_TEXT_MIN_LOD)
     {
         pPainter->setPen(components::complex_logic::FONT_COLOR);
-        pPainter->setFont(components::complex_logic::FONT);
-
-        auto font = pPainter->font();
-        font.setPointSize(mDescriptionFontSize);
-        pPainter->setFont(font);
-
-        pPainter->drawText(boundingRect(), mComponentText, Qt::AlignHCenter | Qt::AlignVCenter);
+        pPainter->setFont(mDescriptionFont);
+        DrawStaticText(pPainter, boundingRect(), mComponentStaticText, Qt::AlignHCenter | Qt::AlignVCenter);
     }
 
     // Draw connector descriptions
@@ -586,7 +590,7 @@ void AbstractComplexLogic::DrawConnectorDescriptionsRight(QPainter *pPainter, co
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(canvas::GRID_SIZE * i + canvas::GRID_SIZE - 20, 0, 40, mHeight), mInputLabels[mTopInputCount - i - 1], Qt::AlignHCenter | Qt::AlignTop);
+            DrawStaticText(pPainter, QRect(canvas::GRID_SIZE * i + canvas::GRID_SIZE - 20, 0, 40, mHeight), mInputStaticTexts[mTopInputCount - i - 1], Qt::AlignHCenter | Qt::AlignTop);
         }
     }
     for (int i = 0; i < mInputCount - mTopInputCount; i++)
@@ -602,13 +606,13 @@ void AbstractComplexLogic::DrawConnectorDescriptionsRight(QPainter *pPainter, co
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(2, (mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 8, mWidth - 4, 12), mInputLabels[i + mTopInputCount], Qt::AlignLeft | Qt::AlignVCenter);
+            DrawStaticText(pPainter, QRect(2, (mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 8, mWidth - 4, 12), mInputStaticTexts[i + mTopInputCount], Qt::AlignLeft | Qt::AlignVCenter);
         }
     }
     pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
     for (size_t i = 0; i < mOutputCount; i++)
     {
-        pPainter->drawText(QRect(2, (mOutputsSpacing * i + mOutputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 8, mWidth - 4, 12), mOutputLabels[i], Qt::AlignRight | Qt::AlignVCenter);
+        DrawStaticText(pPainter, QRect(2, (mOutputsSpacing * i + mOutputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 8, mWidth - 4, 12), mOutputStaticTexts[i], Qt::AlignRight | Qt::AlignVCenter);
     }
 }
 
@@ -630,7 +634,7 @@ void AbstractComplexLogic::DrawConnectorDescriptionsDown(QPainter *pPainter, con
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(2, canvas::GRID_SIZE * i + canvas::GRID_SIZE - 8, mWidth - 4, 12), mInputLabels[mTopInputCount - i - 1], Qt::AlignRight | Qt::AlignVCenter);
+            DrawStaticText(pPainter, QRect(2, canvas::GRID_SIZE * i + canvas::GRID_SIZE - 8, mWidth - 4, 12), mInputStaticTexts[mTopInputCount - i - 1], Qt::AlignRight | Qt::AlignVCenter);
         }
     }
     for (int i = 0; i < mInputCount - mTopInputCount; i++)
@@ -646,13 +650,13 @@ void AbstractComplexLogic::DrawConnectorDescriptionsDown(QPainter *pPainter, con
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(mWidth - (mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 20, 0, 40, mHeight), mInputLabels[i + mTopInputCount], Qt::AlignHCenter | Qt::AlignTop);
+            DrawStaticText(pPainter, QRect(mWidth - (mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 20, 0, 40, mHeight), mInputStaticTexts[i + mTopInputCount], Qt::AlignHCenter | Qt::AlignTop);
         }
     }
     pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
     for (size_t i = 0; i < mOutputCount; i++)
     {
-        pPainter->drawText(QRect(mWidth - (mOutputsSpacing * canvas::GRID_SIZE * (mOutputCount - i - 1) + canvas::GRID_SIZE * (mOutputsTrapezoidOffset + 1)) - 20, 0, 40, mHeight), mOutputLabels[mOutputCount - i - 1], Qt::AlignHCenter | Qt::AlignBottom);
+        DrawStaticText(pPainter, QRect(mWidth - (mOutputsSpacing * canvas::GRID_SIZE * (mOutputCount - i - 1) + canvas::GRID_SIZE * (mOutputsTrapezoidOffset + 1)) - 20, 0, 40, mHeight), mOutputStaticTexts[mOutputCount - i - 1], Qt::AlignHCenter | Qt::AlignBottom);
     }
 }
 
@@ -674,7 +678,7 @@ void AbstractComplexLogic::DrawConnectorDescriptionsLeft(QPainter *pPainter, con
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(mWidth - (canvas::GRID_SIZE * i + canvas::GRID_SIZE) - 20, 0, 40, mHeight), mInputLabels[mTopInputCount - i - 1], Qt::AlignHCenter | Qt::AlignBottom);
+            DrawStaticText(pPainter, QRect(mWidth - (canvas::GRID_SIZE * i + canvas::GRID_SIZE) - 20, 0, 40, mHeight), mInputStaticTexts[mTopInputCount - i - 1], Qt::AlignHCenter | Qt::AlignBottom);
         }
     }
     for (int i = 0; i < mInputCount - mTopInputCount; i++)
@@ -690,13 +694,13 @@ void AbstractComplexLogic::DrawConnectorDescriptionsLeft(QPainter *pPainter, con
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(2, mHeight - (mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 8, mWidth - 4, 12), mInputLabels[i + mTopInputCount], Qt::AlignRight | Qt::AlignVCenter);
+            DrawStaticText(pPainter, QRect(2, mHeight - (mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 8, mWidth - 4, 12), mInputStaticTexts[i + mTopInputCount], Qt::AlignRight | Qt::AlignVCenter);
         }
     }
     pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
     for (size_t i = 0; i < mOutputCount; i++)
     {
-        pPainter->drawText(QRect(2, mHeight - (mOutputsSpacing * canvas::GRID_SIZE * (mOutputCount - i - 1) + canvas::GRID_SIZE * (mOutputsTrapezoidOffset + 1)) - 8, mWidth - 4, 12), mOutputLabels[mOutputCount - i - 1], Qt::AlignLeft | Qt::AlignVCenter);
+        DrawStaticText(pPainter, QRect(2, mHeight - (mOutputsSpacing * canvas::GRID_SIZE * (mOutputCount - i - 1) + canvas::GRID_SIZE * (mOutputsTrapezoidOffset + 1)) - 8, mWidth - 4, 12), mOutputStaticTexts[mOutputCount - i - 1], Qt::AlignLeft | Qt::AlignVCenter);
     }
 }
 
@@ -718,7 +722,7 @@ void AbstractComplexLogic::DrawConnectorDescriptionsUp(QPainter *pPainter, const
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect(2, mHeight - (canvas::GRID_SIZE * i + canvas::GRID_SIZE) - 8, mWidth - 4, 12), mInputLabels[mTopInputCount - i - 1], Qt::AlignLeft | Qt::AlignVCenter);
+            DrawStaticText(pPainter, QRect(2, mHeight - (canvas::GRID_SIZE * i + canvas::GRID_SIZE) - 8, mWidth - 4, 12), mInputStaticTexts[mTopInputCount - i - 1], Qt::AlignLeft | Qt::AlignVCenter);
         }
     }
     for (int i = 0; i < mInputCount - mTopInputCount; i++)
@@ -734,14 +738,83 @@ void AbstractComplexLogic::DrawConnectorDescriptionsUp(QPainter *pPainter, const
         else
         {
             pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
-            pPainter->drawText(QRect((mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 20, 0, 40, mHeight), mInputLabels[i + mTopInputCount], Qt::AlignHCenter | Qt::AlignBottom);
+            DrawStaticText(pPainter, QRect((mInputsSpacing * i + mInputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 20, 0, 40, mHeight), mInputStaticTexts[i + mTopInputCount], Qt::AlignHCenter | Qt::AlignBottom);
         }
     }
     pPainter->setPen(components::complex_logic::SMALL_TEXT_FONT_COLOR);
     for (size_t i = 0; i < mOutputCount; i++)
     {
-        pPainter->drawText(QRect((mOutputsSpacing * i + mOutputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 20, 0, 40, mHeight), mOutputLabels[i], Qt::AlignHCenter | Qt::AlignTop);
+        DrawStaticText(pPainter, QRect((mOutputsSpacing * i + mOutputsTrapezoidOffset + 1) * canvas::GRID_SIZE - 20, 0, 40, mHeight), mOutputStaticTexts[i], Qt::AlignHCenter | Qt::AlignTop);
+    }
+}
+
+void AbstractComplexLogic::UpdateStaticTexts()
+{
+    if (mComponentStaticText.text() != mComponentText || mDescriptionFont.pointSize() != mDescriptionFontSize)
+    {
+        mDescriptionFont = components::complex_logic::FONT;
+        mDescriptionFont.setPointSize(mDescriptionFontSize);
+        mComponentStaticText = CreateStaticText(mComponentText, mDescriptionFont);
     }
+
+    const auto updateLabels = [](const std::vector<QString> &pLabels, std::vector<QStaticText> &pStaticTexts)
+    {
+        pStaticTexts.resize(pLabels.size());
+
+        for (size_t i = 0; i < pLabels.size(); i++)
+        {
+            if (pStaticTexts[i].text() != pLabels[i])
+            {
+                pStaticTexts[i] = CreateStaticText(pLabels[i], components::complex_logic::CONNECTOR_FONT);
+            }
+        }
+    };
+
+    updateLabels(mInputLabels, mInputStaticTexts);
+    updateLabels(mOutputLabels, mOutputStaticTexts);
+}
+
+QStaticText AbstractComplexLogic::CreateStaticText(const QString &pText, const QFont &pFont)
+{
+    QStaticText staticText(pText);
+    staticText.setTextFormat(Qt::PlainText);
+    staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    staticText.prepare(QTransform(), pFont);
+
+    return staticText;
+}
+
+void AbstractComplexLogic::DrawStaticText(QPainter *pPainter, const QRectF &pRect, const QStaticText &pText, Qt::Alignment pAlignment)
+{
+    Q_ASSERT(pPainter);
+
+    if (pText.text().isEmpty())
+    {
+        return;
+    }
+
+    const auto size = pText.size();
+    QPointF pos = pRect.topLeft();
+
+    if (pAlignment & Qt::AlignRight)
+    {
+        pos.setX(pRect.right() - size.width());
+    }
+    else if (pAlignment & Qt::AlignHCenter)
+    {
+        pos.setX(pRect.left() + (pRect.width() - size.width()) / 2);
+    }
+
+    if (pAlignment & Qt::AlignBottom)
+    {
+        pos.setY(pRect.bottom() - size.height());
+    }
+    else if (pAlignment & Qt::AlignVCenter)
+    {
+        pos.setY(pRect.top() + (pRect.height() - size.height()) / 2);
+    }
+
+    pPainter->drawStaticText(pos, pText);
 }
 
 void AbstractComplexLogic::SetConnectorPen(QPainter *pPainter, LogicState pState, bool pSelected)
@@ -3,6 +3,8 @@
 
 #include "../IBaseComponent.h"
 
+#include <QStaticText>
+
 ///
 /// \brief The AbstractComplexLogic class is the super class for all built-in complex components (excluding gates)
 ///
@@ -89,6 +91,23 @@ protected:
     /// \param pItem: Contains drawing parameters
     void DrawConnectorDescriptionsUp(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem);
 
+    /// \brief Lays out the description and connector labels that have changed since the last call
+    /// Drawing pre-laid-out texts avoids shaping the labels through the font engine on every paint
+    void UpdateStaticTexts(void);
+
+    /// \brief Creates a pre-laid-out plain text
+    /// \param pText: The text
+    /// \param pFont: The font the text is drawn with, the painter must use the same font when drawing it
+    /// \return The static text
+    static QStaticText CreateStaticText(const QString &pText, const QFont &pFont);
+
+    /// \brief Draws a pre-laid-out text aligned within the given rectangle, like QPainter::drawText with a rectangle
+    /// \param pPainter: The painter to use, with the font the text has been laid out with
+    /// \param pRect: The rectangle to align the text in
+    /// \param pText: The static text
+    /// \param pAlignment: The horizontal and vertical alignment within the rectangle
+    static void DrawStaticText(QPainter *pPainter, const QRectF &pRect, const QStaticText &pText, Qt::Alignment pAlignment);
+
     /// \brief Creates logic connectors at all in- and output pin points
     virtual void SetLogicConnectors(void);
 
@@ -127,6 +146,12 @@ protected:
 
     uint8_t mDescriptionFontSize;
 
+    // Pre-laid-out description and connector labels, laid out again when a label or the description font size changes
+    QFont mDescriptionFont;
+    QStaticText mComponentStaticText;
+    std::vector<QStaticText> mInputStaticTexts;
+    std::vector<QStaticText> mOutputStaticTexts;
+
     QPolygon mTrapezoid;
     bool mTrapezoidShape;
     uint8_t mInputsTrapezoidOffset;
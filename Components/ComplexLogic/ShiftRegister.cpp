@@ -34,6 +34,9 @@ ShiftRegister::ShiftRegister(const CoreLogic* pCoreLogic, Direction pDirection,
     mShape.clear();
     mShape.addRect(0, 0, mWidth, mHeight);
 
+    mLowStateText = CreateStaticText("0", components::shift_register::FONT);
+    mHighStateText = CreateStaticText("1", components::shift_register::FONT);
+
 #warning ShiftRegister should inherit IBaseComponent directly, not AbstractComplexLogic
 
     SetLogicConnectors();
@@ -176,6 +179,8 @@ void ShiftRegister::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pI
     Q_ASSERT(pItem);
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pItem->levelOfDetailFromTransform(pPainter->worldTransform());
 
     // Draw connectors and inversion circles
@@ -328,11 +333,11 @@ void ShiftRegister::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pI
                 for (int i = 0; i < mOutputCount; i++)
                 {
                     const auto state = std::static_pointer_cast<LogicShiftRegisterCell>(mLogicCell)->GetOutputStateUninverted(i);
-                    const auto text = (state == LogicState::HIGH) ? "1" : "0";
+                    const auto& text = (state == LogicState::HIGH) ? mHighStateText : mLowStateText;
                     const auto x = (i + 1) * canvas::GRID_SIZE - components::BORDER_WIDTH + 1;
 
                     pPainter->setPen((state == LogicState::HIGH) ? components::shift_register::HIGH_FONT_COLOR: components::shift_register::LOW_FONT_COLOR);
-                    pPainter->drawText(QRect(x, 2 * components::BORDER_WIDTH, bitStretch, mHeight - 4 * components::BORDER_WIDTH), text, Qt::AlignHCenter | Qt::AlignBottom);
+                    DrawStaticText(pPainter, QRect(x, 2 * components::BORDER_WIDTH, bitStretch, mHeight - 4 * components::BORDER_WIDTH), text, Qt::AlignHCenter | Qt::AlignBottom);
                 }
                 break;
             }
@@ -341,11 +346,11 @@ void ShiftRegister::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pI
                 for (int i = 0; i < mOutputCount; i++)
                 {
                     const auto state = std::static_pointer_cast<LogicShiftRegisterCell>(mLogicCell)->GetOutputStateUninverted(i);
-                    const auto text = (state == LogicState::HIGH) ? "1" : "0";
+                    const auto& text = (state == LogicState::HIGH) ? mHighStateText : mLowStateText;
                     const auto y = (i + 1) * canvas::GRID_SIZE - components::BORDER_WIDTH + 1;
 
                     pPainter->setPen((state == LogicState::HIGH) ? components::shift_register::HIGH_FONT_COLOR: components::shift_register::LOW_FONT_COLOR);
-                    pPainter->drawText(QRect(4 * components::BORDER_WIDTH, y, mWidth - 8 * components::BORDER_WIDTH, bitStretch), text, Qt::AlignLeft | Qt::AlignVCenter);
+                    DrawStaticText(pPainter, QRect(4 * components::BORDER_WIDTH, y, mWidth - 8 * components::BORDER_WIDTH, bitStretch), text, Qt::AlignLeft | Qt::AlignVCenter);
                 }
                 break;
             }
@@ -354,11 +359,11 @@ void ShiftRegister::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pI
                 for (int i = 0; i < mOutputCount; i++)
                 {
                     const auto state = std::static_pointer_cast<LogicShiftRegisterCell>(mLogicCell)->GetOutputStateUninverted(mOutputCount - i - 1);
-                    const auto text = (state == LogicState::HIGH) ? "1" : "0";
+                    const auto& text = (state == LogicState::HIGH) ? mHighStateText : mLowStateText;
                     const auto x = i * canvas::GRID_SIZE + 2 * components::BORDER_WIDTH + 1;
 
                     pPainter->setPen((state == LogicState::HIGH) ? components::shift_register::HIGH_FONT_COLOR: components::shift_register::LOW_FONT_COLOR);
-                    pPainter->drawText(QRect(x, 2 * components::BORDER_WIDTH, bitStretch, mHeight - 4 * components::BORDER_WIDTH), text, Qt::AlignHCenter | Qt::AlignTop);
+                    DrawStaticText(pPainter, QRect(x, 2 * components::BORDER_WIDTH, bitStretch, mHeight - 4 * components::BORDER_WIDTH), text, Qt::AlignHCenter | Qt::AlignTop);
                 }
                 break;
             }
@@ -367,11 +372,11 @@ void ShiftRegister::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pI
                 for (int i = 0; i < mOutputCount; i++)
                 {
                     const auto state = std::static_pointer_cast<LogicShiftRegisterCell>(mLogicCell)->GetOutputStateUninverted(mOutputCount - i - 1);
-                    const auto text = (state == LogicState::HIGH) ? "1" : "0";
+                    const auto& text = (state == LogicState::HIGH) ? mHighStateText : mLowStateText;
                     const auto y = i * canvas::GRID_SIZE + 2 * components::BORDER_WIDTH + 1;
 
                     pPainter->setPen((state == LogicState::HIGH) ? components::shift_register::HIGH_FONT_COLOR: components::shift_register::LOW_FONT_COLOR);
-                    pPainter->drawText(QRect(4 * components::BORDER_WIDTH, y, mWidth - 8 * components::BORDER_WIDTH, bitStretch), text, Qt::AlignRight | Qt::AlignVCenter);
+                    DrawStaticText(pPainter, QRect(4 * components::BORDER_WIDTH, y, mWidth - 8 * components::BORDER_WIDTH, bitStretch), text, Qt::AlignRight | Qt::AlignVCenter);
                 }
                 break;
             }
@@ -75,6 +75,10 @@ protected:
 
 protected:
     uint8_t mBitWidth;
+
+    // Pre-laid-out state digits, shared by all bits
+    QStaticText mLowStateText;
+    QStaticText mHighStateText;
 };
 
 #endif // SHIFTREGISTER_H
@@ -159,6 +159,8 @@ void ConPoint::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOption
     Q_ASSERT(pOption);
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pOption->levelOfDetailFromTransform(pPainter->worldTransform());
 
     if (levelOfDetail >= components::conpoints::MIN_VISIBLE_LOD)
@@ -1,6 +1,48 @@
 #include "AbstractGate.h"
 #include "Configuration.h"
 
+#include <QCache>
+#include <QCoreApplication>
+#include <QHash>
+#include <QPaintEngine>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/// \brief Returns the glyphs shared between all gates, keyed by their appearance
+/// The glyphs are released with the application, while the paint device backends still exist
+/// \return The glyph cache
+QCache<quint64, QPixmap>& GetGlyphCache()
+{
+    static QCache<quint64, QPixmap> glyphCache(components::gates::GLYPH_CACHE_MAX_KB);
+    static const bool isCleanupRegistered = []()
+    {
+        qAddPostRoutine([]() { glyphCache.clear(); });
+        return true;
+    }();
+    Q_UNUSED(isCleanupRegistered);
+
+    return glyphCache;
+}
+
+/// \brief Returns a small number for each distinct description text, so that the text can be part of an integer key
+/// \param pText: The description text
+/// \return The number of the text
+quint64 GetTextId(const QString& pText)
+{
+    static QHash<QString, quint64> textIds;
+
+    auto textId = textIds.find(pText);
+    if (textId == textIds.end())
+    {
+        textId = textIds.insert(pText, textIds.size());
+    }
+
+    return textId.value();
+}
+} // namespace
+
 AbstractGate::AbstractGate(const CoreLogic* pCoreLogic, const std::shared_ptr<LogicBaseCell>& pLogicCell, uint8_t pInputCount, Direction pDirection):
     IBaseComponent(pCoreLogic, pLogicCell),
     mInputCount(pInputCount),
@@ -93,31 +135,125 @@ void AbstractGate::ResetZValue()
 void AbstractGate::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem, QWidget *pWidget)
 {
     Q_UNUSED(pWidget);
+
+    CountPaintCall();
+
     const double levelOfDetail = pItem->levelOfDetailFromTransform(pPainter->worldTransform());
+    const bool isSelected = (pItem->state & QStyle::State_Selected);
+    const bool areDetailsVisible = (levelOfDetail >= components::COMPONENT_DETAILS_MIN_LOD);
+    const bool isTextVisible = (levelOfDetail >= components::DESCRIPTION_TEXT_MIN_LOD);
+
+    if (pPainter->paintEngine()->type() != QPaintEngine::Raster)
+    {
+        pPainter->save();
+        DrawGlyph(pPainter, isSelected, areDetailsVisible, isTextVisible);
+        pPainter->restore();
+        return;
+    }
+
+    // Rendered at the next power of two of the device scale, so that zooming only creates a few pixmaps per appearance
+    const double deviceScale = levelOfDetail * pPainter->device()->devicePixelRatioF();
+    const auto scaleExponent = static_cast<int32_t>(std::clamp(std::ceil(std::log2(deviceScale)),
+                                                               static_cast<double>(components::gates::GLYPH_CACHE_MIN_SCALE_EXPONENT),
+                                                               static_cast<double>(components::gates::GLYPH_CACHE_MAX_SCALE_EXPONENT)));
+
+    const quint64 key = GetGlyphKey(isSelected, areDetailsVisible, isTextVisible, scaleExponent);
+    const QRectF glyphRect = boundingRect();
+
+    auto& glyphCache = GetGlyphCache();
+    QPixmap* glyph = glyphCache.object(key);
+
+    if (glyph == nullptr)
+    {
+        const double scale = std::exp2(scaleExponent);
+
+        glyph = new QPixmap((glyphRect.size() * scale).toSize());
+        glyph->fill(Qt::transparent);
+
+        QPainter glyphPainter(glyph);
+        glyphPainter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+        glyphPainter.scale(scale, scale);
+        glyphPainter.translate(-glyphRect.topLeft());
+
+        DrawGlyph(&glyphPainter, isSelected, areDetailsVisible, isTextVisible);
+        glyphPainter.end();
+
+        const auto cost = std::max<qsizetype>(1, static_cast<qsizetype>(glyph->width()) * glyph->height() * glyph->depth() / (8 * 1024));
+        if (!glyphCache.insert(key, glyph, cost))
+        {
+            // Glyphs larger than the whole cache are drawn once, insert() has already deleted it
+            pPainter->save();
+            DrawGlyph(pPainter, isSelected, areDetailsVisible, isTextVisible);
+            pPainter->restore();
+            return;
+        }
+    }
+
+    pPainter->drawPixmap(glyphRect, *glyph, QRectF(glyph->rect()));
+}
+
+quint64 AbstractGate::GetGlyphKey(bool pSelected, bool pDetailsVisible, bool pTextVisible, int32_t pScaleExponent) const
+{
+    Q_ASSERT(mInputCount <= components::gates::MAX_INPUT_COUNT);
+
+    if (mGlyphKeyBase == 0)
+    {
+        // The appearance that never changes is looked up only once per gate
+        mGlyphKeyBase = (GetTextId(mComponentText) << 44)
+                | (static_cast<quint64>(mDirection) << 40)
+                | (static_cast<quint64>(mInputCount) << 36);
+    }
+
+    quint64 key = mGlyphKeyBase
+            | (static_cast<quint64>(pDetailsVisible) << 35)
+            | (static_cast<quint64>(pScaleExponent - components::gates::GLYPH_CACHE_MIN_SCALE_EXPONENT) << 32)
+            | (static_cast<quint64>(pTextVisible) << 31)
+            | (static_cast<quint64>(pSelected) << 30);
+
+    if (pDetailsVisible)
+    {
+        // Three bits per pin: connected, inverted and high state, the output uses the lowest bits
+        const auto pinBits = [](bool pConnected, bool pInverted, LogicState pState)
+        {
+            return static_cast<quint64>(pConnected) | (static_cast<quint64>(pInverted) << 1) | (static_cast<quint64>(pState == LogicState::HIGH) << 2);
+        };
 
+        for (size_t i = 0; i < mInputCount; i++)
+        {
+            key |= pinBits(mLogicCell->IsInputConnected(i), mLogicCell->IsInputInverted(i), mLogicCell->GetInputState(i)) << (3 * (i + 1));
+        }
+
+        key |= pinBits(mLogicCell->IsOutputConnected(0), mLogicCell->IsOutputInverted(0), mLogicCell->GetOutputState());
+    }
+
+    return key;
+}
+
+void AbstractGate::DrawGlyph(QPainter *pPainter, bool pSelected, bool pDetailsVisible, bool pTextVisible)
+{
     // Draw connectors and inversion circles
-    if (levelOfDetail >= components::COMPONENT_DETAILS_MIN_LOD)
+    if (pDetailsVisible)
     {
         switch(mDirection)
         {
             case Direction::RIGHT:
             {
-                DrawGateDetailsRight(pPainter, pItem);
+                DrawGateDetailsRight(pPainter, pSelected);
                 break;
             }
             case Direction::DOWN:
             {
-                DrawGateDetailsDown(pPainter, pItem);
+                DrawGateDetailsDown(pPainter, pSelected);
                 break;
             }
             case Direction::LEFT:
             {
-                DrawGateDetailsLeft(pPainter, pItem);
+                DrawGateDetailsLeft(pPainter, pSelected);
                 break;
             }
             case Direction::UP:
             {
-                DrawGateDetailsUp(pPainter, pItem);
+                DrawGateDetailsUp(pPainter, pSelected);
                 break;
             }
             default:
@@ -127,17 +263,19 @@ void AbstractGate::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pIt
         }
     }
 
-    // Draw gate body
-    {
-        QPen pen(pItem->state & QStyle::State_Selected ? components::SELECTED_BORDER_COLOR : components::FILL_COLOR,
-                 components::BORDER_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
-        pPainter->setPen(pen);
-        pPainter->setBrush(QBrush(components::FILL_COLOR));
-        pPainter->drawRect(0, 0, mWidth, mHeight);
-    }
+    // Draw gate body and description text
+    DrawBodyShape(pPainter, pSelected, pTextVisible);
+}
+
+void AbstractGate::DrawBodyShape(QPainter *pPainter, bool pSelected, bool pTextVisible)
+{
+    QPen pen(pSelected ? components::SELECTED_BORDER_COLOR : components::FILL_COLOR,
+             components::BORDER_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    pPainter->setPen(pen);
+    pPainter->setBrush(QBrush(components::FILL_COLOR));
+    pPainter->drawRect(0, 0, mWidth, mHeight);
 
-    // Draw description text
-    if (levelOfDetail >= components::DESCRIPTION_TEXT_MIN_LOD)
+    if (pTextVisible)
     {
         pPainter->setPen(components::gates::FONT_COLOR);
         pPainter->setFont(components::gates::FONT);
@@ -145,14 +283,14 @@ void AbstractGate::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pIt
     }
 }
 
-void AbstractGate::DrawGateDetailsRight(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem)
+void AbstractGate::DrawGateDetailsRight(QPainter *pPainter, bool pSelected)
 {
     // Draw input connectors
     for (size_t i = 0; i < mInputCount; i++)
     {
         if (!mLogicCell->IsInputConnected(i))
         {
-            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawLine(-8, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE, 0, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE);
         }
     }
@@ -160,7 +298,7 @@ void AbstractGate::DrawGateDetailsRight(QPainter *pPainter, const QStyleOptionGr
     if (!mLogicCell->IsOutputConnected(0))
     {
         // Draw output connector
-        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawLine(mWidth, mHeight / 2 - mOutputPositionOffset, mWidth + 8, mHeight / 2 - mOutputPositionOffset);
     }
 
@@ -169,26 +307,26 @@ void AbstractGate::DrawGateDetailsRight(QPainter *pPainter, const QStyleOptionGr
     {
         if (mLogicCell->IsInputInverted(i))
         {
-            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawEllipse(-9, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE - 4, 8, 8);
         }
     }
 
     if (mLogicCell->IsOutputInverted(0))
     {
-        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawEllipse(mWidth + 1, mHeight / 2 - mOutputPositionOffset - 4, 8, 8);
     }
 }
 
-void AbstractGate::DrawGateDetailsDown(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem)
+void AbstractGate::DrawGateDetailsDown(QPainter *pPainter, bool pSelected)
 {
     // Draw input connectors
     for (size_t i = 0; i < mInputCount; i++)
     {
         if (!mLogicCell->IsInputConnected(i))
         {
-            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawLine(mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE, -8, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE, 0);
         }
     }
@@ -196,7 +334,7 @@ void AbstractGate::DrawGateDetailsDown(QPainter *pPainter, const QStyleOptionGra
     if (!mLogicCell->IsOutputConnected(0))
     {
         // Draw output connector
-        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawLine(mWidth / 2 + mOutputPositionOffset, mHeight, mWidth / 2 + mOutputPositionOffset, mHeight + 8);
     }
 
@@ -205,26 +343,26 @@ void AbstractGate::DrawGateDetailsDown(QPainter *pPainter, const QStyleOptionGra
     {
         if (mLogicCell->IsInputInverted(i))
         {
-            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawEllipse(mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE - 4, -9, 8, 8);
         }
     }
 
     if (mLogicCell->IsOutputInverted(0))
     {
-        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawEllipse(mWidth / 2 + mOutputPositionOffset - 4, mHeight + 1, 8, 8);
     }
 }
 
-void AbstractGate::DrawGateDetailsLeft(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem)
+void AbstractGate::DrawGateDetailsLeft(QPainter *pPainter, bool pSelected)
 {
     // Draw input connectors
     for (size_t i = 0; i < mInputCount; i++)
     {
         if (!mLogicCell->IsInputConnected(i))
         {
-            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawLine(mWidth, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE, mWidth + 8, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE);
         }
     }
@@ -232,7 +370,7 @@ void AbstractGate::DrawGateDetailsLeft(QPainter *pPainter, const QStyleOptionGra
     if (!mLogicCell->IsOutputConnected(0))
     {
         // Draw output connector
-        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawLine(-8, mHeight / 2 + mOutputPositionOffset, 0, mHeight / 2 + mOutputPositionOffset);
     }
 
@@ -241,26 +379,26 @@ void AbstractGate::DrawGateDetailsLeft(QPainter *pPainter, const QStyleOptionGra
     {
         if (mLogicCell->IsInputInverted(i))
         {
-            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawEllipse(mWidth + 1, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE - 4, 8, 8);
         }
     }
 
     if (mLogicCell->IsOutputInverted(0))
     {
-        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawEllipse(-9, mHeight / 2 + mOutputPositionOffset - 4, 8, 8);
     }
 }
 
-void AbstractGate::DrawGateDetailsUp(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem)
+void AbstractGate::DrawGateDetailsUp(QPainter *pPainter, bool pSelected)
 {
     // Draw input connectors
     for (size_t i = 0; i < mInputCount; i++)
     {
         if (!mLogicCell->IsInputConnected(i))
         {
-            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetConnectorPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawLine(mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE, mHeight, mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE, mHeight + 8);
         }
     }
@@ -268,7 +406,7 @@ void AbstractGate::DrawGateDetailsUp(QPainter *pPainter, const QStyleOptionGraph
     if (!mLogicCell->IsOutputConnected(0))
     {
         // Draw output connector
-        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetConnectorPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawLine(mWidth / 2 - mOutputPositionOffset, -8, mWidth / 2 - mOutputPositionOffset, 0);
     }
 
@@ -277,14 +415,14 @@ void AbstractGate::DrawGateDetailsUp(QPainter *pPainter, const QStyleOptionGraph
     {
         if (mLogicCell->IsInputInverted(i))
         {
-            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pItem->state & QStyle::State_Selected);
+            SetInversionPen(pPainter, mLogicCell->GetInputState(i), pSelected);
             pPainter->drawEllipse(mInputsSpacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE - 4, mHeight + 1, 8, 8);
         }
     }
 
     if (mLogicCell->IsOutputInverted(0))
     {
-        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pItem->state & QStyle::State_Selected);
+        SetInversionPen(pPainter, mLogicCell->GetOutputState(), pSelected);
         pPainter->drawEllipse(mWidth / 2 - mOutputPositionOffset - 4, -9, 8, 8);
     }
 }
@@ -46,23 +46,44 @@ protected:
 
     /// \brief Draws the gate in- and output pins and inversion circles for a right-facing component
     /// \param pPainter: The painter to use
-    /// \param pItem: Contains drawing parameters
-    void DrawGateDetailsRight(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem);
+    /// \param pSelected: Whether the component is selected or not
+    void DrawGateDetailsRight(QPainter *pPainter, bool pSelected);
 
     /// \brief Draws the gate in- and output pins and inversion circles for a down-facing component
     /// \param pPainter: The painter to use
-    /// \param pItem: Contains drawing parameters
-    void DrawGateDetailsDown(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem);
+    /// \param pSelected: Whether the component is selected or not
+    void DrawGateDetailsDown(QPainter *pPainter, bool pSelected);
 
     /// \brief Draws the gate in- and output pins and inversion circles for a left-facing component
     /// \param pPainter: The painter to use
-    /// \param pItem: Contains drawing parameters
-    void DrawGateDetailsLeft(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem);
+    /// \param pSelected: Whether the component is selected or not
+    void DrawGateDetailsLeft(QPainter *pPainter, bool pSelected);
 
     /// \brief Draws the gate in- and output pins and inversion circles for an up-facing component
     /// \param pPainter: The painter to use
-    /// \param pItem: Contains drawing parameters
-    void DrawGateDetailsUp(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem);
+    /// \param pSelected: Whether the component is selected or not
+    void DrawGateDetailsUp(QPainter *pPainter, bool pSelected);
+
+    /// \brief Draws the gate with its pins, inversion circles, body and description text as shapes
+    /// \param pPainter: The painter to use
+    /// \param pSelected: Whether the component is selected or not
+    /// \param pDetailsVisible: Whether the pins and inversion circles are drawn
+    /// \param pTextVisible: Whether the description text is drawn
+    void DrawGlyph(QPainter *pPainter, bool pSelected, bool pDetailsVisible, bool pTextVisible);
+
+    /// \brief Gets the key of the cached glyph that matches the current appearance of this gate
+    /// \param pSelected: Whether the component is selected or not
+    /// \param pDetailsVisible: Whether the pins and inversion circles are drawn
+    /// \param pTextVisible: Whether the description text is drawn
+    /// \param pScaleExponent: The power of two of the scale the glyph is rendered at
+    /// \return The glyph key, combining the gate type, direction, pin states and drawing parameters
+    quint64 GetGlyphKey(bool pSelected, bool pDetailsVisible, bool pTextVisible, int32_t pScaleExponent) const;
+
+    /// \brief Draws the gate body and description text as shapes
+    /// \param pPainter: The painter to use
+    /// \param pSelected: Whether the component is selected or not
+    /// \param pTextVisible: Whether the description text is drawn
+    void DrawBodyShape(QPainter *pPainter, bool pSelected, bool pTextVisible);
 
     /// \brief Creates logic connectors at all in- and output pin points
     void SetLogicConnectors(void);
@@ -87,6 +108,9 @@ protected:
 
     uint8_t mInputsSpacing;
     uint8_t mOutputPositionOffset;
+
+    // The part of the glyph key that never changes, 0 until the gate is painted for the first time
+    mutable quint64 mGlyphKeyBase = 0;
 };
 
 #endif // ABSTRACTGATE_H
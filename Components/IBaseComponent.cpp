@@ -1,6 +1,9 @@
 #include "IBaseComponent.h"
 #include "CoreLogic.h"
 #include "HelperFunctions.h"
+#include "RenderStatistics.h"
+#include "SpatialIndex.h"
+#include "ViewportTracker.h"
 
 #include <QApplication>
 #include <QGraphicsScene>
@@ -12,7 +15,7 @@ IBaseComponent::IBaseComponent(const CoreLogic* pCoreLogic, const std::shared_pt
 {
     setPos(0, 0);
     setCursor(Qt::PointingHandCursor);
-    setFlags(ItemIsSelectable | ItemIsMovable);
+    setFlags(ItemIsSelectable | ItemIsMovable | ItemSendsGeometryChanges);
     setAcceptHoverEvents(true);
 
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStartSignal, this, [&]()
@@ -27,7 +30,8 @@ IBaseComponent::IBaseComponent(const CoreLogic* pCoreLogic, const std::shared_pt
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStopSignal, this, [&]()
     {
         setCursor(Qt::PointingHandCursor);
-        setFlags(ItemIsSelectable | ItemIsMovable);
+        setFlag(ItemIsSelectable, true); // Other flags of derived components are kept
+        setFlag(ItemIsMovable, true);
         setAcceptHoverEvents(true);
         mSimulationRunning = false;
     });
@@ -55,6 +59,55 @@ IBaseComponent::IBaseComponent(const CoreLogic* pCoreLogic, const std::shared_pt
     }
 }
 
+IBaseComponent::~IBaseComponent()
+{
+    if (auto index = SpatialIndex::FromScene(scene()))
+    {
+        index->Remove(this);
+    }
+}
+
+QVariant IBaseComponent::itemChange(GraphicsItemChange pChange, const QVariant& pValue)
+{
+    switch (pChange)
+    {
+        case ItemSceneChange:
+        {
+            if (auto index = SpatialIndex::FromScene(scene()))
+            {
+                index->Remove(this);
+            }
+            break;
+        }
+        case ItemSceneHasChanged:
+        {
+            mRenderStatistics = RenderStatistics::FromScene(scene());
+            mViewportTracker = ViewportTracker::FromScene(scene());
+            UpdateSpatialIndex();
+            break;
+        }
+        case ItemPositionHasChanged:
+        {
+            UpdateSpatialIndex();
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return QGraphicsItem::itemChange(pChange, pValue);
+}
+
+void IBaseComponent::UpdateSpatialIndex()
+{
+    if (auto index = SpatialIndex::FromScene(scene()))
+    {
+        index->Update(this);
+    }
+}
+
 const std::vector<LogicConnector>& IBaseComponent::GetInConnectors() const
 {
     return mInConnectors;
@@ -76,10 +129,64 @@ uint32_t IBaseComponent::GetOutConnectorCount() const
 }
 
 void IBaseComponent::OnLogicStateChanged()
+{
+    CountUpdateRequest();
+
+    if (!DeferUpdateIfHidden())
+    {
+        UpdateState();
+    }
+}
+
+void IBaseComponent::UpdateState()
 {
     update();
 }
 
+bool IBaseComponent::DeferUpdateIfHidden()
+{
+    if (nullptr == mViewportTracker)
+    {
+        return false;
+    }
+
+    const auto rect = sceneBoundingRect();
+
+    if (mViewportTracker->IsVisible(rect))
+    {
+        return false;
+    }
+
+    mIsUpdateDeferred = true;
+    mViewportTracker->NotifyUpdateDeferred(rect); // Lets the minimap show the new state without repainting the component
+    return true;
+}
+
+void IBaseComponent::ApplyDeferredUpdate()
+{
+    if (mIsUpdateDeferred)
+    {
+        mIsUpdateDeferred = false;
+        UpdateState();
+    }
+}
+
+void IBaseComponent::CountPaintCall() const
+{
+    if (nullptr != mRenderStatistics)
+    {
+        mRenderStatistics->CountPaint(this);
+    }
+}
+
+void IBaseComponent::CountUpdateRequest() const
+{
+    if (nullptr != mRenderStatistics)
+    {
+        mRenderStatistics->CountUpdateRequest();
+    }
+}
+
 std::shared_ptr<LogicBaseCell> IBaseComponent::GetLogicCell()
 {
     return mLogicCell;
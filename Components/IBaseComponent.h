@@ -11,6 +11,8 @@
 #include <QJsonArray>
 
 class CoreLogic;
+class RenderStatistics;
+class ViewportTracker;
 
 struct LogicConnector
 {
@@ -41,6 +43,9 @@ public:
     /// \param pLogicCell: Pointer to the logic cell of this component
     IBaseComponent(const CoreLogic* pCoreLogic, const std::shared_ptr<LogicBaseCell>& pLogicCell);
 
+    /// \brief Destructor for the IBaseComponent, removes the component from the spatial index if it is deleted while in a scene
+    ~IBaseComponent(void) override;
+
     /// \brief Returns a new object that is a clone of this object
     /// \param pCoreLogic: Pointer to the core logic
     /// \return Pointer to a new IBaseComponent
@@ -94,8 +99,11 @@ public:
     /// \return the minimum version
     virtual SwVersion GetMinVersion(void) const = 0;
 
+    /// \brief Repaints this component, if the repaint of a logic state change has been deferred while it was outside the viewport
+    void ApplyDeferredUpdate(void);
+
 protected slots:
-    /// \brief Updates when this component's logic state changed
+    /// \brief Repaints this component when its logic state changed, or defers the repaint while it is outside the viewport
     void OnLogicStateChanged(void);
 
 signals:
@@ -103,6 +111,30 @@ signals:
     /// \param pOffset: The offset by which the component was moved
     void SelectedComponentMovedSignal(QPointF pOffset);
 
+protected:
+    /// \brief Keeps the spatial index of the scene up to date when this component is added, removed or moved,
+    /// and looks up the render statistics of the new scene
+    /// \param pChange: The kind of change
+    /// \param pValue: The new value
+    /// \return The value to apply
+    QVariant itemChange(GraphicsItemChange pChange, const QVariant& pValue) override;
+
+    /// \brief Updates the position and size of this component in the spatial index of its scene
+    void UpdateSpatialIndex(void);
+
+    /// \brief Repaints this component after its logic state changed
+    virtual void UpdateState(void);
+
+    /// \brief Defers the repaint of a logic state change while this component is outside the viewport of its scene
+    /// \return True, if the repaint has been deferred
+    bool DeferUpdateIfHidden(void);
+
+    /// \brief Counts a paint call of this component, if render statistics are enabled for its scene
+    void CountPaintCall(void) const;
+
+    /// \brief Counts an update request of this component, if render statistics are enabled for its scene
+    void CountUpdateRequest(void) const;
+
 protected:
     uint32_t mWidth;
     uint32_t mHeight;
@@ -110,6 +142,10 @@ protected:
     QPointF mMoveStartPoint;
 
     bool mSimulationRunning;
+    bool mIsUpdateDeferred = false;
+
+    RenderStatistics* mRenderStatistics = nullptr; // The render statistics of the scene, looked up when the scene changes
+    ViewportTracker* mViewportTracker = nullptr; // The viewport tracker of the scene, looked up when the scene changes
 
     std::vector<LogicConnector> mInConnectors;
     std::vector<LogicConnector> mOutConnectors;
@@ -14,6 +14,8 @@ LogicButton::LogicButton(const CoreLogic* pCoreLogic):
 
     mOutConnectors.push_back(LogicConnector(ConnectorType::OUT, QPointF(0, 0), 0, QPointF(0, 0))); // Place connector in the middle of the component
 
+    QObject::connect(mLogicCell.get(), &LogicBaseCell::StateChangedSignal, pCoreLogic, &CoreLogic::OnInputStateChanged);
+
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStartSignal, this, [&]()
     {
         setCursor(Qt::PointingHandCursor);
@@ -60,6 +62,8 @@ void LogicButton::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOpt
     Q_ASSERT(pOption);
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pOption->levelOfDetailFromTransform(pPainter->worldTransform());
 
     if (std::static_pointer_cast<LogicButtonCell>(mLogicCell)->GetOutputState() == LogicState::LOW)
@@ -41,7 +41,7 @@ LogicState LogicButtonCell::GetOutputState(uint32_t pOutput) const
 
 void LogicButtonCell::OnSimulationAdvance()
 {
-    LogicFunction();
+    EvaluateLogicFunction();
 
     if (mStateChanged)
     {
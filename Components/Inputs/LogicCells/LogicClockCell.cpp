@@ -64,7 +64,7 @@ LogicState LogicClockCell::GetOutputState(uint32_t pOutput) const
 
 void LogicClockCell::OnSimulationAdvance()
 {
-    LogicFunction();
+    EvaluateLogicFunction();
 
     if (mStateChanged)
     {
@@ -28,6 +28,7 @@ LogicClock::LogicClock(const CoreLogic* pCoreLogic, Direction pDirection):
     SetLogicConnectors();
 
     QObject::connect(this, &LogicClock::ShowClockConfiguratorSignal, pCoreLogic, &CoreLogic::OnShowClockConfiguratorRequest);
+    QObject::connect(mLogicCell.get(), &LogicBaseCell::StateChangedSignal, pCoreLogic, &CoreLogic::OnInputStateChanged);
 }
 
 LogicClock::LogicClock(const LogicClock& pObj, const CoreLogic* pCoreLogic):
@@ -102,6 +103,8 @@ void LogicClock::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOpti
 {
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pOption->levelOfDetailFromTransform(pPainter->worldTransform());
 
     // Draw connectors and inversion circles
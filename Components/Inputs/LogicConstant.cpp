@@ -44,6 +44,8 @@ void LogicConstant::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pO
     Q_ASSERT(pOption);
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pOption->levelOfDetailFromTransform(pPainter->worldTransform());
 
     if (std::static_pointer_cast<LogicConstantCell>(mLogicCell)->GetOutputState() == LogicState::LOW)
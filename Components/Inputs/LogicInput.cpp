@@ -14,6 +14,8 @@ LogicInput::LogicInput(const CoreLogic* pCoreLogic):
 
     mOutConnectors.push_back(LogicConnector(ConnectorType::OUT, QPointF(0, 0), 0, QPointF(0, 0))); // Place connector in the middle of the component
 
+    QObject::connect(mLogicCell.get(), &LogicBaseCell::StateChangedSignal, pCoreLogic, &CoreLogic::OnInputStateChanged);
+
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStartSignal, this, [&]()
     {
         setCursor(Qt::PointingHandCursor);
@@ -60,6 +62,8 @@ void LogicInput::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOpti
     Q_ASSERT(pOption);
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     if (std::static_pointer_cast<LogicInputCell>(mLogicCell)->GetOutputState() == LogicState::LOW)
     {
         QPen pen(pOption->state & QStyle::State_Selected ? components::SELECTED_BORDER_COLOR : components::FILL_COLOR,
@@ -3,6 +3,9 @@
 #include <QThread>
 #include <QDebug>
 
+// Time spent in the evaluations nested in the currently running evaluation, the simulation runs in the GUI thread only
+static std::chrono::nanoseconds sNestedEvaluationTime{0};
+
 LogicBaseCell::LogicBaseCell(uint32_t pInputs, uint32_t pOutputs):
     mInputStates(pInputs, LogicState::LOW),
     mInputConnected(pInputs, false),
@@ -83,16 +86,75 @@ void LogicBaseCell::InvertOutput(uint32_t pOutput)
     mOutputInverted[pOutput] = !mOutputInverted[pOutput];
 }
 
+uint32_t LogicBaseCell::GetInputCount() const
+{
+    return mInputStates.size();
+}
+
+uint32_t LogicBaseCell::GetOutputCount() const
+{
+    return mOutputInverted.size();
+}
+
 bool LogicBaseCell::IsActive() const
 {
     return mIsActive;
 }
 
+void LogicBaseCell::SetProfilingEnabled(bool pEnabled)
+{
+    if (pEnabled)
+    {
+        mProfile = std::make_unique<CellProfile>();
+    }
+    else
+    {
+        mProfile.reset();
+    }
+}
+
+const CellProfile* LogicBaseCell::GetProfile() const
+{
+    return mProfile.get();
+}
+
+void LogicBaseCell::EvaluateLogicFunction()
+{
+    if (nullptr == mProfile)
+    {
+        LogicFunction();
+        return;
+    }
+
+    // Successors notified by LogicFunction() may evaluate within it, their time is subtracted,
+    // so that every cell is only charged for its own work and downstream time isn't counted repeatedly
+    const auto outerNestedTime = sNestedEvaluationTime;
+    sNestedEvaluationTime = std::chrono::nanoseconds(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    LogicFunction();
+    const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+    mProfile->evaluationTime += elapsed - sNestedEvaluationTime;
+    mProfile->evaluations++;
+
+    sNestedEvaluationTime = outerNestedTime + elapsed;
+}
+
 void LogicBaseCell::NotifySuccessor(uint32_t pOutput, LogicState pState) const
 {
     Q_ASSERT(mOutputCells.size() > pOutput);
     if (mOutputCells[pOutput].first != nullptr) // If successor exists
     {
+        if (nullptr != mProfile)
+        {
+            mProfile->notifications++;
+        }
+        if (nullptr != mOutputCells[pOutput].first->mProfile)
+        {
+            mOutputCells[pOutput].first->mProfile->inputEvents++;
+        }
+
         if (mOutputCells[pOutput].first->IsInputInverted(mOutputCells[pOutput].second))
         {
             const auto&& forwardedState = ApplyInversion(InvertState(pState), pOutput);
@@ -161,7 +223,7 @@ void LogicBaseCell::AdvanceUpdateTime()
         }
         case UpdateTime::NOW:
         {
-            LogicFunction(); // Update output states now
+            EvaluateLogicFunction(); // Update output states now
             mNextUpdateTime = UpdateTime::INF;
             break;
         }
@@ -4,6 +4,8 @@
 #include "HelperFunctions.h"
 
 #include <QObject>
+#include <chrono>
+#include <memory>
 
 /// \brief UpdateTime contains values to indicate when the logic cell should update its state
 enum class UpdateTime
@@ -13,6 +15,15 @@ enum class UpdateTime
     INF
 };
 
+/// \brief CellProfile contains the activity counters of a logic cell, only allocated while profiling is enabled
+struct CellProfile
+{
+    uint64_t evaluations = 0;
+    uint64_t inputEvents = 0;
+    uint64_t notifications = 0;
+    std::chrono::nanoseconds evaluationTime{0}; // Exclusive of the evaluations of successors nested in LogicFunction()
+};
+
 ///
 /// \brief The LogicBaseCell class is the abstract base for all logic cells
 ///
@@ -105,11 +116,30 @@ public:
     /// \return The logic state of this cell's output number pOutput
     virtual LogicState GetOutputState(uint32_t pOutput = 0) const = 0;
 
+    /// \brief Getter for the amount of inputs of this cell
+    /// \return The amount of inputs
+    uint32_t GetInputCount(void) const;
+
+    /// \brief Getter for the amount of outputs of this cell
+    /// \return The amount of outputs
+    uint32_t GetOutputCount(void) const;
+
     /// \brief Returns true, if this logic cell is not shut down
     /// \return True, if logic cell active
     bool IsActive(void) const;
 
+    /// \brief Enables or disables activity profiling for this cell, enabling resets the counters
+    /// \param pEnabled: If true, evaluations, input events and notifications are counted
+    void SetProfilingEnabled(bool pEnabled);
+
+    /// \brief Getter for the activity counters of this cell
+    /// \return Pointer to the activity counters or nullptr, if profiling is disabled
+    const CellProfile* GetProfile(void) const;
+
 protected:
+    /// \brief Calls LogicFunction() and records the evaluation if profiling is enabled
+    void EvaluateLogicFunction(void);
+
     /// \brief If the mNextUpdateTime value is NOW, AdvanceUpdateTime calls LogicFunction()
     /// If it's NEXT_TICK, the update time is advanced to NOW
     void AdvanceUpdateTime(void);
@@ -162,6 +192,8 @@ protected:
     UpdateTime mNextUpdateTime;
 
     bool mIsActive;
+
+    std::unique_ptr<CellProfile> mProfile; // Null while profiling is disabled, so the disabled case costs a single check
 };
 
 #endif // LOGICBASECELL_H
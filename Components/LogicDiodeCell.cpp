@@ -25,7 +25,7 @@ void LogicDiodeCell::InputReady(uint32_t pInput, LogicState pState)
     if (mInputStates[pInput] != pState)
     {
         mInputStates[pInput] = pState;
-        LogicFunction();
+        EvaluateLogicFunction();
 
         NotifySuccessor(0, mState);
     }
@@ -1,6 +1,9 @@
 #include "LogicWire.h"
 #include "CoreLogic.h"
 #include "Configuration.h"
+#include "WireLayer.h"
+
+#include <QGraphicsScene>
 
 LogicWire::LogicWire(const CoreLogic* pCoreLogic, WireDirection pDirection, uint32_t pLength):
     IBaseComponent(pCoreLogic, nullptr),
@@ -19,18 +22,22 @@ LogicWire::LogicWire(const CoreLogic* pCoreLogic, WireDirection pDirection, uint
 
     setZValue(components::zvalues::WIRE);
 
+    // Wires are drawn in batches by the wire layer, the item is only used for selection and hit-testing
+    setFlag(ItemHasNoContents, true);
+    setFlag(ItemSendsGeometryChanges, true);
+
     if (mDirection == WireDirection::HORIZONTAL)
     {
         mHeight = components::wires::BOUNDING_RECT_SIZE;
         mWidth = pLength;
-        mShape.addRect(-1, mHeight * -0.5f, mWidth + 2, mHeight);
     }
     else
     {
         mWidth = components::wires::BOUNDING_RECT_SIZE;
         mHeight = pLength;
-        mShape.addRect(mWidth * -0.5f, -1, mWidth, mHeight + 2);
     }
+
+    UpdateShape();
 }
 
 LogicWire::LogicWire(const LogicWire& pObj, const CoreLogic* pCoreLogic):
@@ -43,6 +50,14 @@ LogicWire::LogicWire(const CoreLogic* pCoreLogic, const QJsonObject& pJson):
     setPos(SnapToGrid(QPointF(pJson["x"].toInt(), pJson["y"].toInt())));
 }
 
+LogicWire::~LogicWire()
+{
+    if (auto layer = WireLayer::FromScene(scene()))
+    {
+        layer->RemoveWire(this);
+    }
+}
+
 IBaseComponent* LogicWire::CloneBaseComponent(const CoreLogic* pCoreLogic) const
 {
     return new LogicWire(*this, pCoreLogic);
@@ -55,32 +70,98 @@ void LogicWire::ResetZValue()
 
 void LogicWire::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOption, QWidget *pWidget)
 {
+    Q_UNUSED(pPainter);
+    Q_UNUSED(pOption);
     Q_UNUSED(pWidget);
+}
 
-    QPen pen;
-    if (mLogicCell != nullptr && std::static_pointer_cast<LogicWireCell>(mLogicCell)->GetOutputState() == LogicState::HIGH)
+QLineF LogicWire::GetLine() const
+{
+    if (mDirection == WireDirection::HORIZONTAL)
     {
-        pen = QPen(components::wires::WIRE_HIGH_COLOR, components::wires::WIRE_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+        return QLineF(pos(), pos() + QPointF(mWidth, 0));
     }
     else
     {
-        pen = QPen(pOption->state & QStyle::State_Selected ? components::SELECTED_BORDER_COLOR : components::wires::WIRE_LOW_COLOR,
-                     components::wires::WIRE_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+        return QLineF(pos(), pos() + QPointF(0, mHeight));
     }
-    pPainter->setPen(pen);
+}
 
-    if (mDirection == WireDirection::HORIZONTAL)
+QColor LogicWire::GetColor(bool pShowSelection) const
+{
+    if (mLogicCell != nullptr && std::static_pointer_cast<LogicWireCell>(mLogicCell)->IsOscillating())
     {
-        pPainter->drawLine(0, 0, mWidth, 0);
+        return components::wires::WIRE_OSCILLATING_COLOR;
+    }
+    else if (mLogicCell != nullptr && mLogicCell->GetOutputState() == LogicState::HIGH)
+    {
+        return components::wires::WIRE_HIGH_COLOR;
     }
     else
     {
-        pPainter->drawLine(0, 0, 0, mHeight);
+        return (pShowSelection && isSelected()) ? components::SELECTED_BORDER_COLOR : components::wires::WIRE_LOW_COLOR;
     }
 }
 
+QVariant LogicWire::itemChange(GraphicsItemChange pChange, const QVariant& pValue)
+{
+    switch (pChange)
+    {
+        case ItemSceneChange:
+        {
+            UpdateWireLayer(); // Old area in the scene the wire is removed from
+
+            if (auto layer = WireLayer::FromScene(scene()))
+            {
+                layer->RemoveWire(this);
+            }
+            break;
+        }
+        case ItemSceneHasChanged:
+        {
+            if (auto layer = WireLayer::FromScene(scene()))
+            {
+                layer->AddWire(this);
+            }
+
+            UpdateWireLayer();
+            break;
+        }
+        case ItemPositionChange:
+        case ItemPositionHasChanged:
+        case ItemSelectedHasChanged:
+        case ItemVisibleHasChanged:
+        {
+            UpdateWireLayer();
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return IBaseComponent::itemChange(pChange, pValue);
+}
+
+void LogicWire::UpdateWireLayer()
+{
+    if (nullptr != scene())
+    {
+        scene()->update(sceneBoundingRect());
+    }
+}
+
+void LogicWire::UpdateState()
+{
+    UpdateWireLayer();
+}
+
 void LogicWire::SetLength(uint32_t pLength)
 {
+    UpdateWireLayer();
+    prepareGeometryChange();
+
     if (mDirection == WireDirection::HORIZONTAL)
     {
         mWidth = pLength;
@@ -89,6 +170,26 @@ void LogicWire::SetLength(uint32_t pLength)
     {
         mHeight = pLength;
     }
+
+    // Preview wires are created with length 0 and resized while the mouse moves
+    UpdateShape();
+    UpdateSpatialIndex();
+
+    UpdateWireLayer();
+}
+
+void LogicWire::UpdateShape()
+{
+    mShape.clear();
+
+    if (mDirection == WireDirection::HORIZONTAL)
+    {
+        mShape.addRect(-1, mHeight * -0.5f, mWidth + 2, mHeight);
+    }
+    else
+    {
+        mShape.addRect(mWidth * -0.5f, -1, mWidth, mHeight + 2);
+    }
 }
 
 uint32_t LogicWire::GetLength() const
@@ -28,6 +28,9 @@ public:
     /// \param pJson: The JSON object to load the component's data from
     LogicWire(const CoreLogic* pCoreLogic, const QJsonObject& pJson);
 
+    /// \brief Destructor for LogicWire, removes the wire from the wire layer if it is deleted while in a scene
+    ~LogicWire(void) override;
+
     /// \brief Clone function for the wire component
     /// \param pCoreLogic: Pointer to the core logic, used to connect the component's signals and slots
     /// \return A pointer to the new component
@@ -57,6 +60,15 @@ public:
     /// \return True, if the wire starts or ends in pPoint
     bool StartsOrEndsIn(QPointF pPoint) const;
 
+    /// \brief Getter for the line of this wire
+    /// \return The line from the start to the end of this wire in scene coordinates
+    QLineF GetLine(void) const;
+
+    /// \brief Getter for the color this wire is drawn with by the wire layer
+    /// \param pShowSelection: If false, the color of an unselected wire is returned regardless of the selection
+    /// \return The color for the current logic state and selection of this wire
+    QColor GetColor(bool pShowSelection = true) const;
+
     /// \brief Sets the logic wire cell of this wire and connects it to this wire via signals and slots
     /// \param pLogicCell: The logic cell
     void SetLogicCell(const std::shared_ptr<LogicWireCell>& pLogicCell);
@@ -70,9 +82,24 @@ public:
     virtual SwVersion GetMinVersion(void) const override;
 
 protected:
-    /// \brief Paints the wire component
-    /// \param pPainter: The painter to use
-    /// \param pItem: Contains drawing parameters
+    /// \brief Registers the wire with the wire layer of its scene and repaints the wire layer on geometry and selection changes
+    /// \param pChange: The kind of change
+    /// \param pValue: The new value
+    /// \return The value to apply
+    QVariant itemChange(GraphicsItemChange pChange, const QVariant& pValue) override;
+
+    /// \brief Marks the area of this wire for repainting, the wire item itself has no contents
+    void UpdateWireLayer(void);
+
+    /// \brief Repaints the wire layer where this wire is, after the state of its net changed
+    void UpdateState(void) override;
+
+    /// \brief Sets the shape used for selection and hit-testing to the current length of this wire
+    void UpdateShape(void);
+
+    /// \brief Empty, wires are drawn by the wire layer of the scene
+    /// \param pPainter: Unused, the painter to use
+    /// \param pItem: Unused, contains drawing parameters
     /// \param pWidget: Unused, the widget that is been painted on
     void paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pItem, QWidget *pWidget) override;
 
@@ -3,7 +3,12 @@
 
 LogicWireCell::LogicWireCell(const CoreLogic* pCoreLogic):
     LogicBaseCell(0, 0),
-    mState(LogicState::LOW)
+    mCoreLogic(pCoreLogic),
+    mState(LogicState::LOW),
+    mToggleCount(0),
+    mTogglesSinceInputChange(0),
+    mInputChangeCount(0),
+    mIsOscillating(false)
 {
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStartSignal, this, &LogicWireCell::OnWakeUp);
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStopSignal, this, &LogicWireCell::OnShutdown);
@@ -18,6 +23,7 @@ void LogicWireCell::LogicFunction()
             if (mState != LogicState::HIGH)
             {
                 mState = LogicState::HIGH;
+                RecordToggle();
                 emit StateChangedSignal();
             }
             return;
@@ -26,6 +32,51 @@ void LogicWireCell::LogicFunction()
     if (mState != LogicState::LOW)
     {
         mState = LogicState::LOW;
+        RecordToggle();
+        emit StateChangedSignal();
+    }
+}
+
+void LogicWireCell::RecordToggle()
+{
+    mToggleCount++;
+
+    // Counting restarts with every change of an input component, the input changes themselves are not limited
+    const auto inputChangeCount = mCoreLogic->GetInputChangeCount();
+    if (inputChangeCount != mInputChangeCount)
+    {
+        mInputChangeCount = inputChangeCount;
+        mTogglesSinceInputChange = 0;
+    }
+
+    mTogglesSinceInputChange++;
+
+    if (!mIsOscillating && mTogglesSinceInputChange > simulation::OSCILLATION_TOGGLE_THRESHOLD)
+    {
+        emit OscillationDetectedSignal();
+    }
+}
+
+uint32_t LogicWireCell::GetToggleCount() const
+{
+    return mToggleCount;
+}
+
+uint32_t LogicWireCell::GetTogglesSinceInputChange() const
+{
+    return (mInputChangeCount == mCoreLogic->GetInputChangeCount()) ? mTogglesSinceInputChange : 0;
+}
+
+bool LogicWireCell::IsOscillating() const
+{
+    return mIsOscillating;
+}
+
+void LogicWireCell::MarkOscillating()
+{
+    if (!mIsOscillating)
+    {
+        mIsOscillating = true;
         emit StateChangedSignal();
     }
 }
@@ -53,7 +104,7 @@ void LogicWireCell::InputReady(uint32_t pInput, LogicState pState)
     if (mInputStates[pInput] != pState)
     {
         mInputStates[pInput] = pState;
-        LogicFunction();
+        EvaluateLogicFunction();
 
         for (size_t i = 0; i < mOutputCells.size(); i++)
         {
@@ -71,6 +122,10 @@ LogicState LogicWireCell::GetOutputState(uint32_t pOutput) const
 void LogicWireCell::OnWakeUp()
 {
     mState = LogicState::LOW;
+    mToggleCount = 0;
+    mTogglesSinceInputChange = 0;
+    mInputChangeCount = mCoreLogic->GetInputChangeCount();
+    mIsOscillating = false;
     mIsActive = true;
     emit StateChangedSignal();
 }
@@ -78,6 +133,8 @@ void LogicWireCell::OnWakeUp()
 void LogicWireCell::OnShutdown()
 {
     mState = LogicState::LOW;
+    mTogglesSinceInputChange = 0;
+    mIsOscillating = false;
     mOutputCells.clear();
     mInputStates.clear();
     mOutputInverted.clear();
@@ -41,6 +41,26 @@ public:
     /// \param pState: The new state of the input
     void InputReady(uint32_t pInput, LogicState pState) override;
 
+    /// \brief Getter for the total amount of state toggles of this net since the simulation has been started
+    /// \return The amount of toggles
+    uint32_t GetToggleCount(void) const;
+
+    /// \brief Getter for the amount of state toggles of this net since the last change of an input component
+    /// \return The amount of toggles
+    uint32_t GetTogglesSinceInputChange(void) const;
+
+    /// \brief Returns whether this net has been flagged as part of an oscillating loop
+    /// The flag is latched until the simulation is reset or stopped
+    /// \return True, if the net has been flagged as oscillating
+    bool IsOscillating(void) const;
+
+    /// \brief Flags this net as part of an oscillating loop and repaints it
+    void MarkOscillating(void);
+
+signals:
+    /// \brief Emitted when this net exceeds the oscillation threshold while it is not flagged yet
+    void OscillationDetectedSignal(void);
+
 public slots:
     /// \brief Sets the in- and outputs low for edit mode and triggers a component repaint
     void OnShutdown(void) override;
@@ -49,7 +69,18 @@ public slots:
     void OnWakeUp(void) override;
 
 protected:
+    /// \brief Records a state toggle and checks for oscillation
+    void RecordToggle(void);
+
+protected:
+    const CoreLogic* mCoreLogic;
+
     LogicState mState;
+
+    uint32_t mToggleCount;
+    uint32_t mTogglesSinceInputChange;
+    uint64_t mInputChangeCount; // The input change count of the core logic when the toggles since the input change were reset
+    bool mIsOscillating;
 };
 
 #endif // LOGICWIRECELL_H
@@ -24,7 +24,7 @@ void LogicOutputCell::InputReady(uint32_t pInput, LogicState pState)
 {
     Q_ASSERT(pInput == 0);
     mInputStates[pInput] = pState;
-    LogicFunction();
+    EvaluateLogicFunction();
 }
 
 void LogicOutputCell::OnWakeUp()
@@ -42,6 +42,8 @@ void LogicOutput::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOpt
 {
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     if (std::static_pointer_cast<LogicOutputCell>(mLogicCell)->GetOutputState() == LogicState::LOW)
     {
         QPen pen(pOption->state & QStyle::State_Selected ? components::SELECTED_BORDER_COLOR : components::FILL_COLOR,
@@ -149,6 +149,7 @@ void TextLabel::UpdatePlainTextEditSize()
 
     mShape.clear();
     mShape.addRect(0, canvas::GRID_SIZE * -0.5f, mWidth, mHeight);
+    UpdateSpatialIndex();
 
     this->setOpacity(1);
     update();
@@ -158,6 +159,8 @@ void TextLabel::paint(QPainter *pPainter, const QStyleOptionGraphicsItem *pOptio
 {
     Q_UNUSED(pWidget);
 
+    CountPaintCall();
+
     const double levelOfDetail = pOption->levelOfDetailFromTransform(pPainter->worldTransform());
 
     if (levelOfDetail >= components::DESCRIPTION_TEXT_MIN_LOD)
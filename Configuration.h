@@ -31,6 +31,48 @@ static constexpr auto JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER = "comp_major";
 static constexpr auto JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER = "comp_minor";
 static constexpr auto JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER = "comp_patch";
 
+// Binary files are split into independently compressed chunks, which are (de)compressed in parallel
+// Files without the container magic are read as a single qCompress blob (format before container version 1)
+// Version 1 stores an index of all chunk sizes in the header, version 2 stores the sizes in front of every chunk
+// and ends with an empty chunk, so that it can be written while the circuit is being serialized
+static constexpr auto CONTAINER_MAGIC = "LSCC";
+static constexpr uint32_t CONTAINER_VERSION = 2;
+static constexpr uint32_t CONTAINER_CHUNK_SIZE = 1024 * 1024;
+static constexpr int32_t CONTAINER_COMPRESSION_LEVEL = 6;
+static constexpr uint32_t CONTAINER_MAX_COMPRESSION_RATIO = 1032; // Upper bound of the deflate compression ratio, larger chunk sizes are invalid
+
+// Binary files store components grouped by type in columns instead of one map per component
+static constexpr bool USE_COLUMNAR_ENCODING = true;
+static constexpr auto JSON_COLUMNAR_IDENTIFIER = "columnar";
+static constexpr auto JSON_COLUMNAR_VERSION_IDENTIFIER = "columnar_version";
+static constexpr uint32_t COLUMNAR_VERSION = 1;
+static constexpr uint32_t COLUMNAR_GROUP_SIZE = 4096; // Maximum components per group, larger circuits have several groups per type
+static const SwVersion COLUMNAR_MIN_VERSION(0, 9, 8); // The version that introduced the columnar encoding
+
+// Files are mapped into memory for loading instead of being copied to the heap
+static constexpr bool USE_MEMORY_MAPPED_LOADING = true;
+
+// Files are decoded on a worker thread, the decoded components are added to the scene in batches on the GUI thread
+static constexpr std::chrono::milliseconds LOAD_BATCH_DURATION(16);
+static constexpr std::chrono::milliseconds LOAD_POLL_INTERVAL(10); // Polling interval while the worker has no decoded components ready
+static constexpr uint32_t LOAD_BATCH_SIZE = 256;
+static constexpr uint32_t LOAD_QUEUE_CAPACITY = 50000;
+
+// Edits of an open circuit are journaled next to the circuit file and compacted into an autosave snapshot
+static constexpr auto JOURNAL_FILE_SUFFIX = ".journal";
+static constexpr auto JOURNAL_COMPACTING_FILE_SUFFIX = ".journal.compacting";
+static constexpr auto AUTOSAVE_FILE_SUFFIX = ".autosave";
+static constexpr auto JSON_JOURNAL_GENERATION_IDENTIFIER = "journal_generation";
+static constexpr auto JSON_JOURNAL_REMOVE_IDENTIFIER = "remove";
+static constexpr auto JSON_JOURNAL_ADD_IDENTIFIER = "add";
+static constexpr std::chrono::milliseconds JOURNAL_COMPACTION_INTERVAL(60000);
+static constexpr uint32_t JOURNAL_COMPACTION_DELTA_THRESHOLD = 1000;
+
+// The connectivity extracted when entering the simulation is cached next to the circuit file, keyed by a hash of the components
+static constexpr auto NETLIST_FILE_SUFFIX = ".netlist";
+static constexpr auto NETLIST_MAGIC = "LSNL";
+static constexpr uint32_t NETLIST_VERSION = 1;
+
 namespace runtime_config
 {
 static constexpr auto RUNTIME_CONFIG_RELATIVE_PATH = "/runtime_config.json";
@@ -47,6 +89,8 @@ static constexpr auto DEFAULT_WINDOW_TITLE = "Linkuit Studio - Untitled";
 static constexpr auto OPEN_FILE_DIALOG_TITLE = "Open Circuit File";
 static constexpr auto SAVE_FILE_DIALOG_TITLE = "Save Circuit File";
 
+static constexpr qsizetype MAX_LISTED_UNDRIVEN_NETS = 20; // Further undriven nets of an imported netlist are only counted
+
 static constexpr bool SHOW_WELCOME_DIALOG_ON_STARTUP = true;
 static constexpr std::chrono::milliseconds SHOW_WELCOME_DIALOG_DELAY{300};
 
@@ -57,6 +101,19 @@ static constexpr bool FADE_OUT_GUI_ON_CTRL = true;
 static constexpr std::chrono::milliseconds FADE_OUT_GUI_TIMEOUT(1000);
 
 static constexpr int32_t FADE_ANIMATION_DURATION = 200;
+
+// The minimap shows the occupied scene area from a cached raster, edits only re-render the changed areas
+static constexpr QSize MINIMAP_SIZE(240, 160);
+static constexpr int32_t MINIMAP_MARGIN = 12; // Distance to the bottom right corner of the canvas in pixels
+// Space around the occupied area relative to its size, so that components added close to the border don't rescale the minimap
+static constexpr double MINIMAP_AREA_PADDING = 0.1;
+static constexpr std::chrono::milliseconds MINIMAP_UPDATE_DELAY(100);
+// More changed areas between two updates are merged into their bounding rectangle
+static constexpr uint8_t MINIMAP_MAX_CHANGED_AREAS = 32;
+static constexpr QColor MINIMAP_BACKGROUND_COLOR(0, 25, 28, 220);
+static constexpr QColor MINIMAP_BORDER_COLOR(0, 64, 45);
+static constexpr QColor MINIMAP_WIRE_COLOR(0, 110, 80);
+static constexpr QColor MINIMAP_VIEWPORT_COLOR(255, 255, 255, 170);
 } // namespace
 
 namespace canvas
@@ -75,11 +132,129 @@ static constexpr int32_t MAX_ZOOM_LEVEL = 300;
 static constexpr int32_t MIN_GRID_ZOOM_LEVEL = 200;
 
 static constexpr QRectF DIMENSIONS(-32000, -32000, 64000, 64000);
+// The scene rect only grows beyond DIMENSIONS for circuits that don't fit, e.g. large imported netlists, up to this size
+static constexpr QRectF MAX_DIMENSIONS(-160000, -160000, 320000, 320000);
+static constexpr double SCENE_RECT_MARGIN = 2000;
+
+// Below this level of detail the scene is drawn from a pyramid of prerendered tiles instead of item by item
+static constexpr double TILE_CACHE_MAX_LOD = 0.3f;
+// Scale of the finest pyramid level, every further level halves the scale
+static constexpr double TILE_CACHE_BASE_SCALE = 0.5f;
+static constexpr uint8_t TILE_CACHE_LEVEL_COUNT = 3;
+static constexpr int32_t TILE_SIZE = 256;
+static constexpr int32_t TILE_CACHE_MAX_TILES = 1024;
+// Time per frame for rendering missing and outdated tiles, the remaining tiles are rendered in the following frames
+static constexpr std::chrono::milliseconds TILE_RENDER_BUDGET(12);
+
+// Cell size of the spatial index used by the editing logic, a few grid units so that most components touch one cell
+static constexpr uint32_t SPATIAL_INDEX_CELL_SIZE = 200;
+
+// Pastes of fewer items are inserted into the indexed scene, because leaving the bulk update mode rebuilds the index of the whole scene
+static constexpr uint32_t BULK_UPDATE_MIN_ITEM_COUNT = 1000;
 } // namespace
 
 namespace simulation
 {
 static constexpr std::chrono::milliseconds PROPAGATION_DELAY(1);
+
+// Settling logic toggles a net only a few times per change of an input component (switch, button or clock),
+// a net that toggles more often than this without any input change is driven by a loop that keeps itself toggling
+static constexpr uint32_t OSCILLATION_TOGGLE_THRESHOLD = 32;
+// When an oscillation is detected, all nets that have toggled at least this often since the last input change are flagged as its loop
+static constexpr uint32_t OSCILLATION_LOOP_MIN_TOGGLES = OSCILLATION_TOGGLE_THRESHOLD / 2;
+static constexpr bool PAUSE_ON_OSCILLATION = false;
+} // namespace
+
+namespace profiling
+{
+static constexpr bool PROFILING_ENABLED = false;
+
+static constexpr std::chrono::milliseconds HEATMAP_REFRESH_INTERVAL(250);
+static constexpr QColor HEATMAP_COLD_COLOR(40, 90, 255, 90);
+static constexpr QColor HEATMAP_HOT_COLOR(255, 40, 20, 170);
+
+static constexpr auto CSV_HEADER = "scope,type,x,y,evaluations,input_events,notifications,evaluation_time_ns";
+
+// Render statistics keep the last frames in a ring buffer, the overlay shows the last frame
+static constexpr size_t RENDER_STATISTICS_FRAME_COUNT = 4096;
+static constexpr std::chrono::milliseconds RENDER_STATISTICS_REFRESH_INTERVAL(250);
+static constexpr uint8_t RENDER_STATISTICS_MAX_LISTED_CLASSES = 5;
+static constexpr QColor RENDER_STATISTICS_BACKGROUND_COLOR(0, 0, 0, 170);
+static constexpr QColor RENDER_STATISTICS_TEXT_COLOR(230, 230, 230);
+
+static constexpr auto RENDER_STATISTICS_CSV_HEADER = "frame,frame_interval_us,paint_time_us,dirty_area_px,update_requests,simulation_ticks,simulation_time_us,paint_calls";
+} // namespace
+
+namespace benchmark
+{
+// Top left corner of generated circuits and the width after which repeated stages wrap into a new row
+static constexpr QPointF ORIGIN(-30000, -30000);
+static constexpr uint32_t MAX_ROW_WIDTH = 36000;
+
+// Circuit sizes for a benchmark scale of 1
+static constexpr uint32_t RIPPLE_ADDER_BIT_WIDTH = 256;
+static constexpr uint32_t COUNTER_CHAIN_LENGTH = 64;
+static constexpr uint8_t COUNTER_BIT_WIDTH = 8;
+static constexpr uint32_t LFSR_COUNT = 64;
+static constexpr uint8_t LFSR_SHIFT_REGISTER_BIT_WIDTH = 8;
+static constexpr uint32_t WIRE_MESH_SIZE = 64;
+
+static constexpr uint32_t SIMULATION_TICKS = 2000;
+
+static constexpr auto TEMPORARY_FILE_NAME = "linkuit_benchmark.lsc";
+} // namespace
+
+namespace tracing
+{
+// Every stimulus pattern is held for a few ticks so that delayed and master-slave cells settle
+static constexpr uint32_t CELL_TRACE_TICKS = 512;
+static constexpr uint32_t CELL_TRACE_HOLD_TICKS = 3;
+static constexpr uint32_t CELL_TRACE_SEED = 1;
+
+static constexpr auto CELL_TRACE_FILE_EXTENSION = ".csv";
+
+// Circuit traces toggle every input and button with the given probability per tick, drawn from a seeded mt19937
+static constexpr uint32_t CIRCUIT_TRACE_DEFAULT_TICKS = 1000;
+static constexpr uint32_t CIRCUIT_TRACE_DEFAULT_SEED = 1;
+static constexpr uint32_t CIRCUIT_TRACE_TOGGLE_PERMILLE = 50;
+} // namespace
+
+namespace netlist_import
+{
+static constexpr auto BLIF_SUFFIX = "blif";
+static constexpr auto VERILOG_SUFFIX = "v";
+
+// Levels with more cells are split into several columns, so that large netlists are placed roughly square
+static constexpr uint32_t MIN_COLUMN_ROWS = 16;
+static constexpr uint32_t MAX_COLUMN_ROWS = 512;
+
+// Clock driving latches without a control signal
+static constexpr uint32_t CLOCK_TOGGLE_TICKS = 100;
+} // namespace
+
+namespace image_export
+{
+static constexpr auto PNG_SUFFIX = "png";
+static constexpr auto SVG_SUFFIX = "svg";
+
+// Raster images are rendered in square tiles (in pixels), only one row of tiles is kept in memory
+static constexpr int32_t TILE_SIZE = 256;
+// Empty border (in scene units) around the exported components
+static constexpr double MARGIN = canvas::GRID_SIZE;
+
+static constexpr double DEFAULT_SCALE = 1;
+static constexpr double MIN_SCALE = 0.05;
+static constexpr double MAX_SCALE = 4;
+
+// Raster images are limited to this width and height (in pixels), so that a row of tiles stays small enough for the memory
+static constexpr int32_t MAX_RASTER_SIZE = 32768;
+
+// The compressed PNG image data is written in chunks of this size (in bytes)
+static constexpr int32_t PNG_CHUNK_SIZE = 64 * 1024;
+// zlib compression level of the PNG image data
+static constexpr int PNG_COMPRESSION_LEVEL = 6;
+// Vector images are painted in one pass, painting is interrupted by a heartbeat after this amount of items
+static constexpr uint32_t ITEMS_PER_HEARTBEAT = 1000;
 } // namespace
 
 namespace components
@@ -122,6 +297,11 @@ static constexpr uint8_t MIN_INPUT_COUNT = 1;
 static constexpr uint8_t MAX_INPUT_COUNT = 9;
 static constexpr uint8_t GRID_WIDTH = 3;
 
+// Gate glyphs are rendered once per power-of-two scale within these exponents and shared between all gates that look alike
+static constexpr int32_t GLYPH_CACHE_MIN_SCALE_EXPONENT = -3;
+static constexpr int32_t GLYPH_CACHE_MAX_SCALE_EXPONENT = 3;
+static constexpr int32_t GLYPH_CACHE_MAX_KB = 64 * 1024;
+
 static const QFont FONT("Calibri Light", 25);
 static constexpr QColor FONT_COLOR(255, 255, 255);
 } // namespace
@@ -132,6 +312,7 @@ namespace wires
 static constexpr uint8_t BOUNDING_RECT_SIZE = 20;
 static constexpr QColor WIRE_LOW_COLOR(0, 64, 45);
 static constexpr QColor WIRE_HIGH_COLOR(0, 143, 100);
+static constexpr QColor WIRE_OSCILLATING_COLOR(230, 90, 50);
 static constexpr uint8_t WIRE_WIDTH = 2;
 } // namespace
 
@@ -1,4 +1,9 @@
 #include "CoreLogic.h"
+#include "CircuitExporter.h"
+#include "ColumnarCircuitCodec.h"
+#include "NetlistImporter.h"
+#include "RenderStatistics.h"
+#include "SpatialIndex.h"
 
 #include "Components/Gates/AndGate.h"
 #include "Components/Gates/OrGate.h"
@@ -36,6 +41,9 @@
 #include "HelperFunctions.h"
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <set>
 
 CoreLogic::CoreLogic(View &pView):
     mView(pView),
@@ -43,6 +51,7 @@ CoreLogic::CoreLogic(View &pView):
     mVerticalPreviewWire(this, WireDirection::VERTICAL, 0),
     mPropagationTimer(this),
     mProcessingTimer(this),
+    mLoadBatchTimer(this),
     mCircuitFileParser(mRuntimeConfigParser)
 {
     mView.Init();
@@ -51,8 +60,13 @@ CoreLogic::CoreLogic(View &pView):
 
     QObject::connect(&mPropagationTimer, &QTimer::timeout, this, &CoreLogic::OnPropagationTimeout);
     QObject::connect(&mProcessingTimer, &QTimer::timeout, this, &CoreLogic::OnProcessingTimeout);
+    QObject::connect(&mLoadBatchTimer, &QTimer::timeout, this, &CoreLogic::OnLoadBatchTimeout);
 
     QObject::connect(&mCircuitFileParser, &CircuitFileParser::LoadCircuitFileSuccessSignal, this, &CoreLogic::ReadJson);
+    QObject::connect(&mCircuitFileParser, &CircuitFileParser::LoadCircuitCborSuccessSignal, this, &CoreLogic::ReadCbor);
+
+    // The saved file is the new base of the journal, the edits journaled so far are contained in it
+    QObject::connect(&mCircuitFileParser, &CircuitFileParser::SaveCircuitFileSuccessSignal, &mCircuitJournal, &CircuitJournal::Start);
 
     if (!mRuntimeConfigParser.LoadRuntimeConfig(GetRuntimeConfigAbsolutePath()))
     {
@@ -149,11 +163,63 @@ void CoreLogic::SetSimulationMode(SimulationMode pNewMode)
 
 void CoreLogic::EnterSimulation()
 {
+    mSimulationTick = 0;
+    mOscillatingNetCount = 0;
+    mRenderStatistics = RenderStatistics::FromScene(mView.Scene());
+
+    const auto start = std::chrono::steady_clock::now();
+
     StartProcessing();
-    ParseWireGroups();
+
+    // The netlist of an unchanged circuit is restored instead of being parsed from the scene geometry
+    // Hashing all components is skipped as well, if nothing has been edited since the last simulation
+    const auto generation = GetCircuitGeneration();
+    if (!mNetlistCache.HasComponents(generation))
+    {
+        mNetlistCache.SetComponents(GetAllComponents(), generation);
+    }
+
+    const bool isNetlistCached = mNetlistCache.Restore(mCircuitFileParser.GetFileInfo());
+
+    if (isNetlistCached)
+    {
+        mWireGroups = mNetlistCache.GetWireGroups();
+        mWireMap.clear();
+    }
+    else
+    {
+        ParseWireGroups();
+        mNetlistCache.BeginRecording(mWireGroups);
+    }
+
+    const auto wireGroupsParsed = std::chrono::steady_clock::now();
     CreateWireLogicCells();
-    ConnectLogicCells();
+    const auto wireCellsCreated = std::chrono::steady_clock::now();
+
+    if (isNetlistCached)
+    {
+        ConnectCachedLogicCells();
+    }
+    else
+    {
+        ConnectLogicCells();
+    }
+
+    const auto cellsConnected = std::chrono::steady_clock::now();
+
+    if (!isNetlistCached)
+    {
+        mNetlistCache.FinishRecording(mCircuitFileParser.GetFileInfo());
+    }
+
+    ApplyProfilingState();
     EndProcessing();
+
+    mSimulationSetupTimings.parseWireGroups = wireGroupsParsed - start;
+    mSimulationSetupTimings.createWireLogicCells = wireCellsCreated - wireGroupsParsed;
+    mSimulationSetupTimings.connectLogicCells = cellsConnected - wireCellsCreated;
+    mSimulationSetupTimings.total = std::chrono::steady_clock::now() - start;
+    mSimulationSetupTimings.isNetlistCached = isNetlistCached;
     SetSimulationMode(SimulationMode::STOPPED);
     emit SimulationStartSignal();
     StepSimulation();
@@ -233,6 +299,7 @@ void CoreLogic::OnToggleValueChanged(uint32_t pValue)
         {
             clockCell->SetToggleTicks(pValue);
             mCircuitFileParser.MarkAsModified();
+            JournalConfiguredComponent(clock);
         }
     }
 }
@@ -247,6 +314,7 @@ void CoreLogic::OnPulseValueChanged(uint32_t pValue)
         {
             clockCell->SetPulseTicks(pValue);
             mCircuitFileParser.MarkAsModified();
+            JournalConfiguredComponent(clock);
         }
     }
 }
@@ -261,6 +329,7 @@ void CoreLogic::OnClockModeChanged(ClockMode pMode)
         {
             clockCell->SetClockMode(pMode);
             mCircuitFileParser.MarkAsModified();
+            JournalConfiguredComponent(clock);
         }
     }
 }
@@ -283,7 +352,232 @@ bool CoreLogic::IsSimulationRunning() const
 
 void CoreLogic::OnPropagationTimeout()
 {
+    mSimulationTick++;
+
+    if (nullptr == mRenderStatistics || !mRenderStatistics->IsEnabled())
+    {
+        emit SimulationAdvanceSignal();
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
     emit SimulationAdvanceSignal();
+    mRenderStatistics->AddSimulationTime(std::chrono::steady_clock::now() - start);
+}
+
+const SimulationSetupTimings& CoreLogic::GetSimulationSetupTimings() const
+{
+    return mSimulationSetupTimings;
+}
+
+uint64_t CoreLogic::GetSimulationTick() const
+{
+    return mSimulationTick;
+}
+
+uint64_t CoreLogic::GetInputChangeCount() const
+{
+    return mInputChangeCount;
+}
+
+void CoreLogic::OnInputStateChanged()
+{
+    mInputChangeCount++;
+}
+
+std::vector<uint32_t> CoreLogic::GetNetToggleCounts() const
+{
+    std::vector<uint32_t> toggleCounts;
+    toggleCounts.reserve(mLogicWireCells.size());
+
+    for (const auto& cell : mLogicWireCells)
+    {
+        toggleCounts.push_back(cell->GetToggleCount());
+    }
+
+    return toggleCounts;
+}
+
+uint32_t CoreLogic::GetOscillatingNetCount() const
+{
+    return mOscillatingNetCount;
+}
+
+void CoreLogic::SetPauseOnOscillation(bool pEnabled)
+{
+    mPauseOnOscillation = pEnabled;
+}
+
+bool CoreLogic::IsPauseOnOscillationEnabled() const
+{
+    return mPauseOnOscillation;
+}
+
+void CoreLogic::SetProfilingEnabled(bool pEnabled)
+{
+    mIsProfilingEnabled = pEnabled;
+
+    if (IsSimulationRunning())
+    {
+        ApplyProfilingState();
+    }
+}
+
+bool CoreLogic::IsProfilingEnabled() const
+{
+    return mIsProfilingEnabled;
+}
+
+void CoreLogic::ApplyProfilingState()
+{
+    for (auto& comp : mView.Scene()->items())
+    {
+        // Wires and full ConPoints share the cell of their net, which is handled below
+        if (nullptr == dynamic_cast<IBaseComponent*>(comp) || nullptr != dynamic_cast<LogicWire*>(comp)
+                || (nullptr != dynamic_cast<ConPoint*>(comp) && static_cast<ConPoint*>(comp)->GetConnectionType() == ConnectionType::FULL))
+        {
+            continue;
+        }
+
+        auto cell = static_cast<IBaseComponent*>(comp)->GetLogicCell();
+        if (nullptr != cell)
+        {
+            cell->SetProfilingEnabled(mIsProfilingEnabled);
+        }
+    }
+
+    for (auto& cell : mLogicWireCells)
+    {
+        cell->SetProfilingEnabled(mIsProfilingEnabled);
+    }
+}
+
+bool CoreLogic::ExportProfileCsv(const QString& pFilePath) const
+{
+    struct ProfileRow
+    {
+        QString scope;
+        QString type;
+        QPointF pos;
+        CellProfile profile;
+    };
+
+    std::vector<ProfileRow> rows;
+    std::map<QString, CellProfile> typeProfiles;
+
+    const auto accumulate = [](CellProfile& pTotal, const CellProfile& pProfile)
+    {
+        pTotal.evaluations += pProfile.evaluations;
+        pTotal.inputEvents += pProfile.inputEvents;
+        pTotal.notifications += pProfile.notifications;
+        pTotal.evaluationTime += pProfile.evaluationTime;
+    };
+
+    for (const auto& comp : mView.Scene()->items())
+    {
+        if (nullptr == dynamic_cast<IBaseComponent*>(comp) || nullptr != dynamic_cast<LogicWire*>(comp)
+                || (nullptr != dynamic_cast<ConPoint*>(comp) && static_cast<ConPoint*>(comp)->GetConnectionType() == ConnectionType::FULL))
+        {
+            continue;
+        }
+
+        auto compBase = static_cast<IBaseComponent*>(comp);
+        if (nullptr == compBase->GetLogicCell() || nullptr == compBase->GetLogicCell()->GetProfile())
+        {
+            continue;
+        }
+
+        const QString type(compBase->metaObject()->className());
+        rows.push_back(ProfileRow{"cell", type, compBase->pos(), *compBase->GetLogicCell()->GetProfile()});
+        accumulate(typeProfiles[type], rows.back().profile);
+    }
+
+    for (size_t i = 0; i < mLogicWireCells.size(); i++)
+    {
+        if (nullptr == mLogicWireCells[i]->GetProfile())
+        {
+            continue;
+        }
+
+        // Wire cells are created in the order of the wire groups, the first wire marks the net position
+        QPointF pos;
+        if (i < mWireGroups.size() && !mWireGroups[i].empty())
+        {
+            pos = mWireGroups[i].front()->pos();
+        }
+
+        rows.push_back(ProfileRow{"net", "Net", pos, *mLogicWireCells[i]->GetProfile()});
+        accumulate(typeProfiles["Net"], rows.back().profile);
+    }
+
+    QFile file(pFilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << profiling::CSV_HEADER << "\n";
+
+    for (const auto& [type, profile] : typeProfiles)
+    {
+        out << "type," << type << ",,," << profile.evaluations << "," << profile.inputEvents << ","
+            << profile.notifications << "," << profile.evaluationTime.count() << "\n";
+    }
+
+    for (const auto& row : rows)
+    {
+        out << row.scope << "," << row.type << "," << row.pos.x() << "," << row.pos.y() << "," << row.profile.evaluations << ","
+            << row.profile.inputEvents << "," << row.profile.notifications << "," << row.profile.evaluationTime.count() << "\n";
+    }
+
+    return (out.status() == QTextStream::Ok);
+}
+
+bool CoreLogic::ExportImage(const QString& pFilePath, double pScale, bool pOnlySelection)
+{
+    if (IsProcessing() || IsLoading())
+    {
+        emit ExportImageFailedSignal(pFilePath, tr("Images cannot be exported while a file is being loaded or processed."));
+        return false;
+    }
+
+    StartProcessing();
+
+    CircuitExporter exporter(*mView.Scene(), [&]()
+    {
+        ProcessingHeartbeat();
+    });
+    const bool success = exporter.Export(pFilePath, pScale, pOnlySelection);
+
+    EndProcessing();
+
+    if (!success)
+    {
+        emit ExportImageFailedSignal(pFilePath, exporter.GetError());
+    }
+
+    return success;
+}
+
+void CoreLogic::OnNetOscillationDetected()
+{
+    // The nets of a loop toggle about equally often, so all of them are flagged and highlighted together
+    for (const auto& cell : mLogicWireCells)
+    {
+        if (!cell->IsOscillating() && cell->GetTogglesSinceInputChange() >= simulation::OSCILLATION_LOOP_MIN_TOGGLES)
+        {
+            cell->MarkOscillating();
+            mOscillatingNetCount++;
+        }
+    }
+
+    if (mPauseOnOscillation)
+    {
+        PauseSimulation();
+    }
+
+    emit OscillationDetectedSignal(mOscillatingNetCount);
 }
 
 bool CoreLogic::IsUndoQueueEmpty() const
@@ -852,13 +1146,14 @@ std::vector<LogicWire*> CoreLogic::DeleteContainedWires(const LogicWire* pWire)
                                components::wires::BOUNDING_RECT_SIZE + 4, pWire->GetLength() + 4);
     }
 
-    const auto&& containedComponents = mView.Scene()->items(collisionRect, Qt::ContainsItemShape, Qt::DescendingOrder);
+    const auto index = SpatialIndex::FromScene(mView.Scene());
+    Q_ASSERT(index);
 
-    for (const auto &wire : containedComponents)
+    for (const auto &wire : index->GetWires(collisionRect, pWire->GetDirection(), Qt::ContainsItemShape))
     {
-        if (dynamic_cast<LogicWire*>(wire) != nullptr && static_cast<LogicWire*>(wire)->GetDirection() == pWire->GetDirection() && wire != pWire)
+        if (wire != pWire)
         {
-            deletedComponents.push_back(static_cast<LogicWire*>(wire));
+            deletedComponents.push_back(wire);
             mView.Scene()->removeItem(wire);
         }
     }
@@ -868,16 +1163,25 @@ std::vector<LogicWire*> CoreLogic::DeleteContainedWires(const LogicWire* pWire)
 
 std::optional<LogicWire*> CoreLogic::GetAdjacentWire(QPointF pCheckPosition, WireDirection pDirection) const
 {
-    const auto&& componentsAtPosition = mView.Scene()->items(pCheckPosition.x(), pCheckPosition.y(), 1, 1, Qt::IntersectsItemShape, Qt::DescendingOrder);
-    const auto&& wiresAtPosition = FilterForWires(componentsAtPosition, pDirection);
+    const auto index = SpatialIndex::FromScene(mView.Scene());
+    Q_ASSERT(index);
 
-    if (wiresAtPosition.size() > 0)
+    const auto&& wiresAtPosition = index->GetWires(QRectF(pCheckPosition.x(), pCheckPosition.y(), 1, 1), pDirection);
+
+    std::optional<LogicWire*> topmostWire;
+
+    // The index returns the wires unordered, the topmost wire is chosen like from the scene's items in descending order
+    for (const auto& wire : wiresAtPosition)
     {
-        Q_ASSERT(static_cast<LogicWire*>(wiresAtPosition.at(0)));
-        return std::optional(static_cast<LogicWire*>(wiresAtPosition.at(0)));
+        Q_ASSERT(wire);
+
+        if (!topmostWire.has_value() || index->IsStackedAbove(wire, topmostWire.value()))
+        {
+            topmostWire = wire;
+        }
     }
 
-    return std::nullopt;
+    return topmostWire;
 }
 
 // Remember that using (dynamic_cast<LogicWire*>(comp) != nullptr) directly is more efficient than iterating over filtered components
@@ -901,14 +1205,19 @@ std::vector<IBaseComponent*> CoreLogic::GetCollidingComponents(IBaseComponent* p
 {
     std::vector<IBaseComponent*> collidingComponents;
 
-    for (auto &comp : mView.Scene()->collidingItems(pComponent))
+    const auto index = SpatialIndex::FromScene(mView.Scene());
+    Q_ASSERT(index);
+
+    // The index only compares the bounding rects of the shapes, the exact shapes are compared afterwards
+    const auto shapeRect = pComponent->mapRectToScene(pComponent->shape().boundingRect());
+
+    for (auto &comp : index->GetComponents(shapeRect))
     {
         Q_ASSERT(comp);
 
-        if (IsCollidingComponent(comp) && (!pOnlyUnselected || !comp->isSelected()))
+        if (comp != pComponent && (!pOnlyUnselected || !comp->isSelected()) && pComponent->collidesWithItem(comp))
         {
-            // comp must be IBaseComponent at this point
-            collidingComponents.push_back(static_cast<IBaseComponent*>(comp));
+            collidingComponents.push_back(comp);
         }
     }
 
@@ -981,7 +1290,10 @@ bool CoreLogic::IsNoCrossingPoint(const ConPoint* pConPoint) const
 
 bool CoreLogic::IsXCrossingPoint(QPointF pPoint) const
 {
-    const auto& wires = FilterForWires(mView.Scene()->items(pPoint, Qt::IntersectsItemBoundingRect));
+    const auto index = SpatialIndex::FromScene(mView.Scene());
+    Q_ASSERT(index);
+
+    const auto& wires = index->GetWires(pPoint);
 
     if (wires.size() <= 1)
     {
@@ -990,7 +1302,7 @@ bool CoreLogic::IsXCrossingPoint(QPointF pPoint) const
 
     for (const auto& wire : wires)
     {
-        if (static_cast<LogicWire*>(wire)->StartsOrEndsIn(pPoint))
+        if (wire->StartsOrEndsIn(pPoint))
         {
             return false; // L-Crossing type wire found, this is no X crossing
         }
@@ -1157,15 +1469,21 @@ bool CoreLogic::IsLCrossing(LogicWire* pWireA, LogicWire* pWireB) const
 
 std::optional<ConPoint*> CoreLogic::GetConPointAtPosition(QPointF pPos, ConnectionType pType) const
 {
-    for (const auto& comp : mView.Scene()->items(pPos, Qt::IntersectsItemShape))
+    const auto index = SpatialIndex::FromScene(mView.Scene());
+    Q_ASSERT(index);
+
+    std::optional<ConPoint*> topmostConPoint;
+
+    for (const auto& conPoint : index->GetConPoints(pPos))
     {
-        if ((nullptr != dynamic_cast<ConPoint*>(comp)) && (pType == static_cast<ConPoint*>(comp)->GetConnectionType()))
+        if (pType == conPoint->GetConnectionType()
+                && (!topmostConPoint.has_value() || index->IsStackedAbove(conPoint, topmostConPoint.value())))
         {
-            return static_cast<ConPoint*>(comp);
+            topmostConPoint = conPoint;
         }
     }
 
-    return std::nullopt;
+    return topmostConPoint;
 }
 
 void CoreLogic::CreateWireLogicCells()
@@ -1175,6 +1493,7 @@ void CoreLogic::CreateWireLogicCells()
     for (const auto& group : mWireGroups)
     {
         auto logicCell = std::make_shared<LogicWireCell>(this);
+        QObject::connect(logicCell.get(), &LogicWireCell::OscillationDetectedSignal, this, &CoreLogic::OnNetOscillationDetected);
         mLogicWireCells.emplace_back(logicCell);
         for (auto& comp : group)
         {
@@ -1230,11 +1549,13 @@ void CoreLogic::ConnectLogicCells()
                     {
                         std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AddInputSlot();
                         compBase->GetLogicCell()->ConnectOutput(wire->GetLogicCell(), std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->GetInputSize() - 1, 0);
+                        mNetlistCache.RecordBinding(mWireMap.at(wire), compBase, 0, true);
                     }
                     else if ((wire->GetDirection() == inputDirection)
                             && wire->contains(wire->mapFromScene(compBase->pos() + compBase->GetInConnectors()[0].pos)))
                     {
                         std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AppendOutput(compBase->GetLogicCell(), 0);
+                        mNetlistCache.RecordBinding(mWireMap.at(wire), compBase, 0, false);
                     }
                 }
             }
@@ -1246,6 +1567,7 @@ void CoreLogic::ConnectLogicCells()
                     {
                         std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AddInputSlot();
                         compBase->GetLogicCell()->ConnectOutput(wire->GetLogicCell(), std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->GetInputSize() - 1, out);
+                        mNetlistCache.RecordBinding(mWireMap.at(wire), compBase, out, true);
                     }
                 }
 
@@ -1254,6 +1576,7 @@ void CoreLogic::ConnectLogicCells()
                     if (wire->contains(wire->mapFromScene(compBase->pos() + compBase->GetInConnectors()[in].pos)))
                     {
                         std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AppendOutput(compBase->GetLogicCell(), in);
+                        mNetlistCache.RecordBinding(mWireMap.at(wire), compBase, in, false);
                     }
                 }
             }
@@ -1261,6 +1584,51 @@ void CoreLogic::ConnectLogicCells()
     }
 }
 
+void CoreLogic::ConnectCachedLogicCells()
+{
+    for (const auto& binding : mNetlistCache.GetBindings())
+    {
+        auto& wireCell = mLogicWireCells[binding.group];
+        auto compBase = mNetlistCache.GetComponent(binding.component);
+
+        // Same order of slots and outputs as in ConnectLogicCells
+        if (binding.isOutput)
+        {
+            wireCell->AddInputSlot();
+            compBase->GetLogicCell()->ConnectOutput(wireCell, wireCell->GetInputSize() - 1, binding.pin);
+        }
+        else
+        {
+            wireCell->AppendOutput(compBase->GetLogicCell(), binding.pin);
+        }
+    }
+}
+
+uint64_t CoreLogic::GetCircuitGeneration() const
+{
+    const auto index = SpatialIndex::FromScene(mView.Scene());
+    Q_ASSERT(index);
+
+    // Both counters only increase, so their sum changes whenever one of them does
+    return index->GetGeneration() + mEditGeneration;
+}
+
+std::vector<IBaseComponent*> CoreLogic::GetAllComponents() const
+{
+    std::vector<IBaseComponent*> components;
+
+    for (const auto& item : mView.Scene()->items())
+    {
+        auto comp = dynamic_cast<IBaseComponent*>(item);
+        if (nullptr != comp)
+        {
+            components.push_back(comp);
+        }
+    }
+
+    return components;
+}
+
 void CoreLogic::StartProcessing()
 {
     mProcessingTimer.start(gui::PROCESSING_OVERLAY_TIMEOUT);
@@ -1284,6 +1652,13 @@ void CoreLogic::EndProcessing()
     mView.FadeOutProcessingOverlay();
     mIsProcessing = false;
     emit ProcessingEndedSignal();
+
+    if (mPendingSaveFile.has_value() && !IsLoading())
+    {
+        const auto fileInfo = mPendingSaveFile.value();
+        mPendingSaveFile.reset();
+        SaveCircuitAs(fileInfo);
+    }
 }
 
 bool CoreLogic::IsProcessing() const
@@ -1707,6 +2082,13 @@ void CoreLogic::PasteCopiedComponents()
 
     mCurrentPaste.clear();
 
+    const bool isBulkUpdate = (mCopiedComponents.size() >= canvas::BULK_UPDATE_MIN_ITEM_COUNT);
+
+    if (isBulkUpdate)
+    {
+        mView.BeginBulkUpdate();
+    }
+
     for (const auto& comp : mCopiedComponents)
     {
         // Create a copy of the copy component
@@ -1721,6 +2103,11 @@ void CoreLogic::PasteCopiedComponents()
         mCurrentPaste.push_back(copy);
     }
 
+    if (isBulkUpdate)
+    {
+        mView.EndBulkUpdate();
+    }
+
     // Delete previous copy action if aborted to prevent memory leak
     if (mCurrentCopyUndoType.has_value() && !mCurrentCopyUndoType.value()->IsCompleted())
     {
@@ -1792,73 +2179,340 @@ QJsonObject CoreLogic::GetJson() const
     return json;
 }
 
-void CoreLogic::NewCircuit()
+void CoreLogic::WriteCbor(QCborStreamWriter& pWriter)
 {
-    EnterControlMode(ControlMode::EDIT); // Always start in edit mode after loading
-
-    // Delete all components
-    for (const auto& item : mView.Scene()->items())
-    {
-        mView.Scene()->removeItem(item);
-    }
-
-    mView.ResetViewport();
-
-    // Clear undo and redo stacks
-    mUndoQueue.clear();
-    mRedoQueue.clear();
-
-    emit UpdateUndoRedoEnabledSignal();
-
-    mCircuitFileParser.ResetCurrentFileInfo();
-}
+    SwVersion minVersion(0, 0, 0);
 
-void CoreLogic::ReadJson(const QFileInfo& pFileInfo, const QJsonObject& pJson)
-{
-    EnterControlMode(ControlMode::EDIT); // Always start in edit mode after loading
+    pWriter.startMap(); // Indefinite length, so the versions can be written after all components have been visited
 
-    if (pJson.contains(file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER) && pJson[file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER].isDouble() &&
-        pJson.contains(file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER) && pJson[file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER].isDouble() &&
-        pJson.contains(file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER) && pJson[file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER].isDouble())
+    // The columnar encoding has no text representation, so it is only used for binary files
+    if (file::USE_COLUMNAR_ENCODING && file::SAVE_FORMAT == file::SaveFormat::BINARY)
     {
-        const auto major = pJson[file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER].toInt();
-        const auto minor = pJson[file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER].toInt();
-        const auto patch = pJson[file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER].toInt();
+        pWriter.append(QLatin1String(file::JSON_COLUMNAR_VERSION_IDENTIFIER));
+        pWriter.append(static_cast<quint64>(file::COLUMNAR_VERSION));
+        pWriter.append(QLatin1String(file::JSON_COLUMNAR_IDENTIFIER));
 
-        if (CompareWithCurrentVersion(SwVersion(major, minor, patch)) > 0) // version is newer
+        ColumnarCircuitCodec codec(pWriter);
+
+        for (const auto& item : mView.Scene()->items())
         {
-            emit FileHasNewerIncompatibleVersionSignal(QString("%0.%1.%2").arg(major).arg(minor).arg(patch));
-            return;
+            if (nullptr != dynamic_cast<IBaseComponent*>(item))
+            {
+                codec.AddComponent(static_cast<IBaseComponent*>(item)->GetJson(), static_cast<IBaseComponent*>(item)->GetMinVersion());
+            }
+
+            ProcessingHeartbeat();
         }
-    }
 
-    if (pJson.contains(file::JSON_MAJOR_VERSION_IDENTIFIER) && pJson[file::JSON_MAJOR_VERSION_IDENTIFIER].isDouble() &&
-        pJson.contains(file::JSON_MINOR_VERSION_IDENTIFIER) && pJson[file::JSON_MINOR_VERSION_IDENTIFIER].isDouble() &&
-        pJson.contains(file::JSON_PATCH_VERSION_IDENTIFIER) && pJson[file::JSON_PATCH_VERSION_IDENTIFIER].isDouble())
+        codec.Finish();
+        minVersion = codec.GetMinVersion();
+    }
+    else
     {
-        const auto major = pJson[file::JSON_MAJOR_VERSION_IDENTIFIER].toInt();
-        const auto minor = pJson[file::JSON_MINOR_VERSION_IDENTIFIER].toInt();
-        const auto patch = pJson[file::JSON_PATCH_VERSION_IDENTIFIER].toInt();
+        pWriter.append(QLatin1String(file::JSON_COMPONENTS_IDENTIFIER));
+        pWriter.startArray();
 
-        if (CompareWithCurrentVersion(SwVersion(major, minor, patch)) > 0) // version is newer
+        for (const auto& item : mView.Scene()->items())
         {
-            emit FileHasNewerCompatibleVersionSignal(QString("%0.%1.%2").arg(major).arg(minor).arg(patch));
+            if (nullptr != dynamic_cast<IBaseComponent*>(item))
+            {
+                QCborValue::fromJsonValue(static_cast<IBaseComponent*>(item)->GetJson()).toCbor(pWriter);
+                auto version = static_cast<IBaseComponent*>(item)->GetMinVersion();
+                minVersion = GetNewerVersion(minVersion, version);
+            }
+
+            ProcessingHeartbeat();
         }
-    }
 
-    // Delete all components
-    for (const auto& item : mView.Scene()->items())
-    {
-        mView.Scene()->removeItem(item);
+        pWriter.endArray();
     }
 
-    mView.ResetViewport();
+    pWriter.append(QLatin1String(file::JSON_MAJOR_VERSION_IDENTIFIER));
+    pWriter.append(static_cast<quint64>(MAJOR_VERSION));
+    pWriter.append(QLatin1String(file::JSON_MINOR_VERSION_IDENTIFIER));
+    pWriter.append(static_cast<quint64>(MINOR_VERSION));
+    pWriter.append(QLatin1String(file::JSON_PATCH_VERSION_IDENTIFIER));
+    pWriter.append(static_cast<quint64>(PATCH_VERSION));
+
+    pWriter.append(QLatin1String(file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER));
+    pWriter.append(static_cast<quint64>(minVersion.major));
+    pWriter.append(QLatin1String(file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER));
+    pWriter.append(static_cast<quint64>(minVersion.minor));
+    pWriter.append(QLatin1String(file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER));
+    pWriter.append(static_cast<quint64>(minVersion.patch));
+
+    pWriter.endMap();
+}
+
+void CoreLogic::SaveCircuit()
+{
+    if (mCircuitFileParser.IsFileOpen())
+    {
+        SaveCircuitAs(mCircuitFileParser.GetFileInfo().value());
+    }
+}
+
+void CoreLogic::SaveCircuitAs(const QFileInfo& pFileInfo)
+{
+    if (IsLoading())
+    {
+        // Saving now would replace the file with the partially loaded circuit
+        emit SaveCircuitRejectedSignal(pFileInfo);
+        return;
+    }
+
+    if (IsProcessing())
+    {
+        // Saved as soon as the running operation has finished, see EndProcessing()
+        mPendingSaveFile = pFileInfo;
+        return;
+    }
+
+    StartProcessing();
+
+    // Files that are open for compaction cannot be replaced on Windows
+    mCircuitJournal.WaitForCompaction();
+
+    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    {
+        mCircuitFileParser.SaveCircuitAs(pFileInfo, [this](QCborStreamWriter& pWriter)
+        {
+            WriteCbor(pWriter);
+        });
+    }
+    else
+    {
+        mCircuitFileParser.SaveJsonAs(pFileInfo, GetJson());
+    }
+    EndProcessing();
+}
+
+void CoreLogic::NewCircuit()
+{
+    EnterControlMode(ControlMode::EDIT); // Always start in edit mode after loading
+
+    // Delete all components
+    mView.RemoveAllComponents();
+
+    mView.FitSceneRect();
+    mView.ResetViewport();
+
+    // Clear undo and redo stacks
+    mUndoQueue.clear();
+    mRedoQueue.clear();
+
+    emit UpdateUndoRedoEnabledSignal();
+
+    mCircuitFileParser.ResetCurrentFileInfo();
+    mCircuitJournal.Stop();
+}
+
+void CoreLogic::LoadCircuitAsync(const QFileInfo& pFileInfo, bool pIsFromRecents)
+{
+    if (IsProcessing() || IsLoading())
+    {
+        return;
+    }
+
+    mCircuitLoader = std::make_unique<CircuitLoader>(pFileInfo);
+    mIsLoadFromRecents = pIsFromRecents;
+    mIsLoadPrepared = false;
+    mLoadedComponentCount = 0;
+
+    StartProcessing();
+    mCircuitLoader->Start();
+    mLoadBatchTimer.start(file::LOAD_POLL_INTERVAL);
+}
+
+void CoreLogic::ImportNetlist(const QFileInfo& pFileInfo)
+{
+    if (IsProcessing() || IsLoading())
+    {
+        return;
+    }
+
+    StartProcessing();
+
+    NetlistImporter importer(this);
+
+    if (!importer.Read(pFileInfo))
+    {
+        EndProcessing();
+        emit ImportNetlistFailedSignal(pFileInfo, importer.GetError());
+        return;
+    }
+
+    ProcessingHeartbeat();
+
+    const auto components = importer.CreateComponents();
+
+    if (!components.has_value())
+    {
+        EndProcessing();
+        emit ImportNetlistFailedSignal(pFileInfo, importer.GetError());
+        return;
+    }
+
+    ProcessingHeartbeat();
+
+    // The imported circuit is untitled, it is saved into a circuit file by the user
+    NewCircuit();
+
+    mView.BeginBulkUpdate();
+
+    for (size_t compIndex = 0; compIndex < components->size(); compIndex++)
+    {
+        if (!CreateComponent(components->at(compIndex)))
+        {
+            qDebug() << "Component unknown";
+        }
+
+        if ((compIndex + 1) % file::LOAD_BATCH_SIZE == 0)
+        {
+            ProcessingHeartbeat();
+        }
+    }
+
+    mView.EndBulkUpdate();
+    mView.FitSceneRect();
+    mView.ResetViewport();
+    EndProcessing();
+
+    mCircuitFileParser.MarkAsModified();
+    emit NetlistImportedSignal(pFileInfo, components->size(), importer.GetUndrivenNets());
+}
+
+void CoreLogic::CancelLoading()
+{
+    if (!IsLoading())
+    {
+        return;
+    }
+
+    StopLoading();
+    NewCircuit(); // Removes the partially loaded circuit
+}
+
+bool CoreLogic::IsLoading() const
+{
+    return (nullptr != mCircuitLoader);
+}
+
+void CoreLogic::SetInteractive(bool pIsInteractive)
+{
+    mIsInteractive = pIsInteractive;
+}
+
+void CoreLogic::OnLoadBatchTimeout()
+{
+    Q_ASSERT(mCircuitLoader);
+
+    // Read before taking, so that no component decoded after the take can be missed
+    const auto state = mCircuitLoader->GetState();
+
+    if (state == CircuitLoaderState::FAILED)
+    {
+        const auto fileInfo = mCircuitLoader->GetFileInfo();
+        const auto isFromRecents = mIsLoadFromRecents;
+        const auto isLoadPrepared = mIsLoadPrepared;
+
+        StopLoading();
+
+        if (isLoadPrepared)
+        {
+            // The file turned out to be invalid after components have been created, which may lack fields
+            NewCircuit();
+        }
+
+        emit AsyncLoadFailedSignal(fileInfo, isFromRecents);
+        return;
+    }
+
+    if (state == CircuitLoaderState::DECODING_HEADER)
+    {
+        return; // Polled again after LOAD_POLL_INTERVAL, decompressing large files takes a while
+    }
+
+    if (!mIsLoadPrepared)
+    {
+        if (!PrepareCircuitLoad(mCircuitLoader->GetHeader().value_or(QJsonObject())))
+        {
+            StopLoading();
+            return;
+        }
+
+        mCircuitFileParser.SetCurrentFile(mCircuitLoader->GetFileInfo());
+        mIsLoadPrepared = true;
+
+        // The index is rebuilt once when loading has been finished or canceled, the processing overlay covers the scene until then
+        mView.BeginBulkUpdate();
+    }
+
+    // Add components until the time of one frame is used up, to keep the GUI responsive
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+
+    bool isQueueEmpty = false;
+    while (!isQueueEmpty && batchTimer.elapsed() < file::LOAD_BATCH_DURATION.count())
+    {
+        const auto components = mCircuitLoader->TakeDecodedComponents(file::LOAD_BATCH_SIZE);
+        isQueueEmpty = components.empty();
+
+        for (const auto& component : components)
+        {
+            if (!CreateComponent(component))
+            {
+                qDebug() << "Component unknown";
+            }
+        }
+
+        mLoadedComponentCount += components.size();
+    }
+
+    emit LoadProgressSignal(mLoadedComponentCount, mCircuitLoader->GetDecodedCount());
+
+    if (state == CircuitLoaderState::FINISHED && isQueueEmpty)
+    {
+        const auto fileInfo = mCircuitLoader->GetFileInfo();
+
+        StopLoading();
+        mRuntimeConfigParser.AddRecentFilePath(fileInfo); // Only completed loads are added, canceled loads are not
+        FinishCircuitLoad(fileInfo);
+        return;
+    }
+
+    // Batches are time-boxed, so the event loop runs between every batch. The next batch follows immediately
+    // while components are queued, otherwise the worker is polled without spinning the GUI thread.
+    mLoadBatchTimer.setInterval(isQueueEmpty ? file::LOAD_POLL_INTERVAL : std::chrono::milliseconds(0));
+}
+
+void CoreLogic::StopLoading()
+{
+    mLoadBatchTimer.stop();
+    mCircuitLoader.reset(); // Cancels and joins the worker thread
+
+    if (mIsLoadPrepared)
+    {
+        mView.EndBulkUpdate();
+        mIsLoadPrepared = false;
+    }
+
+    EndProcessing();
+}
+
+void CoreLogic::ReadJson(const QFileInfo& pFileInfo, const QJsonObject& pJson)
+{
+    if (!PrepareCircuitLoad(pJson))
+    {
+        return;
+    }
 
-    // Create components
     if (pJson.contains(file::JSON_COMPONENTS_IDENTIFIER) && pJson[file::JSON_COMPONENTS_IDENTIFIER].isArray())
     {
         auto components = pJson[file::JSON_COMPONENTS_IDENTIFIER].toArray();
 
+        mView.BeginBulkUpdate();
+
         for (uint32_t compIndex = 0; compIndex < components.size(); compIndex++)
         {
             auto component = components[compIndex].toObject();
@@ -1868,14 +2522,295 @@ void CoreLogic::ReadJson(const QFileInfo& pFileInfo, const QJsonObject& pJson)
                 qDebug() << "Component unknown";
             }
         }
+
+        mView.EndBulkUpdate();
     }
 
+    FinishCircuitLoad(pFileInfo);
+}
+
+void CoreLogic::ReadCbor(const QFileInfo& pFileInfo, const QJsonObject& pHeader, const QByteArray& pCbor)
+{
+    if (!PrepareCircuitLoad(pHeader))
+    {
+        return;
+    }
+
+    mView.BeginBulkUpdate();
+
+    const auto result = CircuitFileParser::ReadCborComponents(pCbor, [this](const QJsonObject& pComponent)
+    {
+        if (!CreateComponent(pComponent))
+        {
+            qDebug() << "Component unknown";
+        }
+        return true;
+    });
+
+    mView.EndBulkUpdate();
+
+    if (result == file::ComponentReadResult::INVALID)
+    {
+        // The components read so far may lack fields, so the partially loaded circuit is discarded
+        NewCircuit();
+        emit mCircuitFileParser.LoadCircuitFileFailedSignal(pFileInfo, false); // Files from the recents are loaded asynchronously
+        return;
+    }
+
+    if (result == file::ComponentReadResult::TRUNCATED)
+    {
+        qDebug() << "Circuit file truncated or corrupted, loaded the readable components";
+    }
+
+    FinishCircuitLoad(pFileInfo);
+}
+
+bool CoreLogic::PrepareCircuitLoad(const QJsonObject& pJson)
+{
+    EnterControlMode(ControlMode::EDIT); // Always start in edit mode after loading
+
+    if (pJson.contains(file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER) && pJson[file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER].isDouble() &&
+        pJson.contains(file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER) && pJson[file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER].isDouble() &&
+        pJson.contains(file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER) && pJson[file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER].isDouble())
+    {
+        const auto major = pJson[file::JSON_COMPATIBLE_MAJOR_VERSION_IDENTIFIER].toInt();
+        const auto minor = pJson[file::JSON_COMPATIBLE_MINOR_VERSION_IDENTIFIER].toInt();
+        const auto patch = pJson[file::JSON_COMPATIBLE_PATCH_VERSION_IDENTIFIER].toInt();
+
+        if (CompareWithCurrentVersion(SwVersion(major, minor, patch)) > 0) // version is newer
+        {
+            emit FileHasNewerIncompatibleVersionSignal(QString("%0.%1.%2").arg(major).arg(minor).arg(patch));
+            return false;
+        }
+    }
+
+    // The components of a newer columnar encoding cannot be decoded, even if the compatible version would allow it
+    if (pJson.contains(file::JSON_COLUMNAR_VERSION_IDENTIFIER) && pJson[file::JSON_COLUMNAR_VERSION_IDENTIFIER].toInteger() > file::COLUMNAR_VERSION)
+    {
+        const auto major = pJson[file::JSON_MAJOR_VERSION_IDENTIFIER].toInt();
+        const auto minor = pJson[file::JSON_MINOR_VERSION_IDENTIFIER].toInt();
+        const auto patch = pJson[file::JSON_PATCH_VERSION_IDENTIFIER].toInt();
+
+        emit FileHasNewerIncompatibleVersionSignal(QString("%0.%1.%2").arg(major).arg(minor).arg(patch));
+        return false;
+    }
+
+    if (pJson.contains(file::JSON_MAJOR_VERSION_IDENTIFIER) && pJson[file::JSON_MAJOR_VERSION_IDENTIFIER].isDouble() &&
+        pJson.contains(file::JSON_MINOR_VERSION_IDENTIFIER) && pJson[file::JSON_MINOR_VERSION_IDENTIFIER].isDouble() &&
+        pJson.contains(file::JSON_PATCH_VERSION_IDENTIFIER) && pJson[file::JSON_PATCH_VERSION_IDENTIFIER].isDouble())
+    {
+        const auto major = pJson[file::JSON_MAJOR_VERSION_IDENTIFIER].toInt();
+        const auto minor = pJson[file::JSON_MINOR_VERSION_IDENTIFIER].toInt();
+        const auto patch = pJson[file::JSON_PATCH_VERSION_IDENTIFIER].toInt();
+
+        if (CompareWithCurrentVersion(SwVersion(major, minor, patch)) > 0) // version is newer
+        {
+            emit FileHasNewerCompatibleVersionSignal(QString("%0.%1.%2").arg(major).arg(minor).arg(patch));
+        }
+    }
+
+    // The edits of the previous circuit have been saved or discarded at this point
+    mCircuitJournal.Stop();
+
+    // Delete all components
+    mView.RemoveAllComponents();
+
+    mView.ResetViewport();
+
+    return true;
+}
+
+void CoreLogic::FinishCircuitLoad(const QFileInfo& pFileInfo)
+{
+    // Circuits that have been imported from large netlists don't fit on the default canvas
+    mView.FitSceneRect();
+
     // Clear undo and redo stacks
     mUndoQueue.clear();
     mRedoQueue.clear();
 
     emit UpdateUndoRedoEnabledSignal();
     emit OpeningFileSuccessfulSignal(pFileInfo);
+
+    if (!mIsInteractive)
+    {
+        return; // Headless runs neither ask about nor touch the journal of the previous session
+    }
+
+    if (CircuitJournal::HasJournal(pFileInfo))
+    {
+        emit RecoverableJournalFoundSignal(pFileInfo); // Journaling starts after the user decided about the edits
+    }
+    else
+    {
+        mCircuitJournal.Start(pFileInfo);
+    }
+}
+
+void CoreLogic::RecoverJournal(const QFileInfo& pFileInfo)
+{
+    if (IsProcessing())
+    {
+        return;
+    }
+
+    StartProcessing();
+
+    const auto components = CircuitJournal::Recover(pFileInfo);
+
+    if (!components.has_value())
+    {
+        EndProcessing();
+        DiscardJournal(pFileInfo);
+        return;
+    }
+
+    mView.RemoveAllComponents();
+    mView.BeginBulkUpdate();
+
+    for (const auto& component : components.value())
+    {
+        if (!CreateComponent(component))
+        {
+            qDebug() << "Component unknown";
+        }
+    }
+
+    mView.EndBulkUpdate();
+    EndProcessing();
+
+    mCircuitJournal.Resume(pFileInfo);
+    mCircuitFileParser.MarkAsModified();
+}
+
+void CoreLogic::DiscardJournal(const QFileInfo& pFileInfo)
+{
+    mCircuitJournal.Start(pFileInfo); // Removes the journal files of the previous session
+}
+
+void CoreLogic::JournalUndoObject(UndoBaseType* pUndoObject, bool pIsUndone)
+{
+    Q_ASSERT(pUndoObject);
+
+    if (!mCircuitJournal.IsActive())
+    {
+        return;
+    }
+
+    std::vector<IBaseComponent*> added;
+    std::vector<IBaseComponent*> deleted;
+    std::vector<IBaseComponent*> moved;
+    std::vector<IBaseComponent*> configured;
+    QPointF offset;
+
+    switch (pUndoObject->Type())
+    {
+        case undo::Type::ADD:
+        {
+            added = static_cast<UndoAddType*>(pUndoObject)->AddedComponents();
+            deleted = static_cast<UndoAddType*>(pUndoObject)->DeletedComponents();
+            break;
+        }
+        case undo::Type::DEL:
+        {
+            deleted = static_cast<UndoDeleteType*>(pUndoObject)->Components();
+            break;
+        }
+        case undo::Type::MOVE:
+        {
+            const auto undoMoveObject = static_cast<UndoMoveType*>(pUndoObject);
+            added = undoMoveObject->AddedComponents();
+            deleted = undoMoveObject->DeletedComponents();
+            moved = undoMoveObject->MovedComponents();
+            offset = undoMoveObject->Offset();
+            break;
+        }
+        case undo::Type::COPY:
+        {
+            const auto undoCopyObject = static_cast<UndoCopyType*>(pUndoObject);
+            added = undoCopyObject->AddedComponents();
+            deleted = undoCopyObject->DeletedComponents();
+            moved = undoCopyObject->MovedComponents();
+            offset = undoCopyObject->Offset();
+            break;
+        }
+        case undo::Type::CONFIGURE:
+        {
+            const auto data = static_cast<UndoConfigureType*>(pUndoObject)->Data();
+            switch (data->Type())
+            {
+                case undo::ConfigType::CONNECTION_TYPE:
+                {
+                    configured.push_back(std::static_pointer_cast<undo::ConnectionTypeChangedData>(data)->conPoint);
+                    break;
+                }
+                case undo::ConfigType::TEXTLABEL_CONTENT:
+                {
+                    configured.push_back(std::static_pointer_cast<undo::TextLabelContentChangedData>(data)->textLabel);
+                    break;
+                }
+                case undo::ConfigType::CONNECTOR_INVERSION:
+                {
+                    configured.push_back(std::static_pointer_cast<undo::ConnectorInversionChangedData>(data)->component);
+                    break;
+                }
+            }
+            break;
+        }
+        default:
+        {
+            throw std::logic_error("Undo type invalid");
+        }
+    }
+
+    if (pIsUndone)
+    {
+        std::swap(added, deleted);
+        offset = -offset;
+    }
+
+    const std::set<IBaseComponent*> addedSet(added.begin(), added.end());
+    const std::set<IBaseComponent*> deletedSet(deleted.begin(), deleted.end());
+    const std::set<IBaseComponent*> movedSet(moved.begin(), moved.end());
+
+    std::set<IBaseComponent*> affected(addedSet);
+    affected.insert(deletedSet.begin(), deletedSet.end());
+    affected.insert(movedSet.begin(), movedSet.end());
+    affected.insert(configured.begin(), configured.end());
+
+    QStringList removedKeys;
+    std::vector<QJsonObject> addedComponents;
+
+    for (const auto& comp : affected)
+    {
+        Q_ASSERT(comp);
+
+        const auto json = comp->GetJson();
+        const bool isInSceneAfter = (nullptr != comp->scene());
+
+        // Components that are both added and deleted (e.g. pasted and merged) have never been part of the circuit
+        const bool isToggled = (addedSet.count(comp) != deletedSet.count(comp));
+        const bool isInSceneBefore = (isToggled != isInSceneAfter);
+
+        if (isInSceneBefore)
+        {
+            removedKeys << CircuitJournal::GetComponentKey(json, movedSet.count(comp) > 0 ? offset : QPointF());
+        }
+        if (isInSceneAfter)
+        {
+            addedComponents.push_back(json);
+        }
+    }
+
+    mCircuitJournal.AppendDelta(removedKeys, addedComponents);
+}
+
+void CoreLogic::JournalConfiguredComponent(IBaseComponent* pComponent)
+{
+    Q_ASSERT(pComponent);
+
+    const auto json = pComponent->GetJson();
+    mCircuitJournal.AppendDelta(QStringList{CircuitJournal::GetComponentKey(json)}, {json});
 }
 
 bool CoreLogic::CreateComponent(const QJsonObject &pJson)
@@ -2054,9 +2989,12 @@ void CoreLogic::AppendUndo(UndoBaseType* pUndoObject)
     Q_ASSERT(pUndoObject);
 
     mCircuitFileParser.MarkAsModified();
+    mEditGeneration++;
     AppendToUndoQueue(pUndoObject, mUndoQueue);
     mRedoQueue.clear();
 
+    JournalUndoObject(pUndoObject, false);
+
     emit UpdateUndoRedoEnabledSignal();
 }
 
@@ -2190,6 +3128,8 @@ void CoreLogic::Undo()
             }
         }
         mCircuitFileParser.MarkAsModified();
+        mEditGeneration++;
+        JournalUndoObject(undoObject, true);
     }
     ClearSelection();
 }
@@ -2312,6 +3252,8 @@ void CoreLogic::Redo()
             }
         }
         mCircuitFileParser.MarkAsModified();
+        mEditGeneration++;
+        JournalUndoObject(redoObject, false);
     }
     ClearSelection();
 }
@@ -11,12 +11,17 @@
 #include "Configuration.h"
 #include "RuntimeConfigParser.h"
 #include "CircuitFileParser.h"
+#include "CircuitLoader.h"
+#include "CircuitJournal.h"
+#include "NetlistCache.h"
 
 #include <QGraphicsItem>
 #include <QTimer>
 #include <deque>
+#include <memory>
 
 class View;
+class RenderStatistics;
 
 ///
 /// \brief The CoreLogic class contains all business logic
@@ -171,6 +176,59 @@ public:
     /// \brief Advances the simulation by one tick if in simulation mode
     void StepSimulation(void);
 
+    /// \brief Getter for the phase durations of the last simulation start
+    /// \return The durations of wire group parsing, wire cell creation and cell connection
+    const SimulationSetupTimings& GetSimulationSetupTimings(void) const;
+
+    // Functions for oscillation detection
+
+    /// \brief Getter for the number of simulation ticks since the simulation has been started
+    /// \return The current simulation tick
+    uint64_t GetSimulationTick(void) const;
+
+    /// \brief Getter for the number of state changes of input components (switches, buttons and clocks) since the program start
+    /// Nets that keep toggling without a change of this number are oscillating
+    /// \return The number of input changes
+    uint64_t GetInputChangeCount(void) const;
+
+    /// \brief Getter for the total toggle counts of all nets (wire groups) since the simulation has been started
+    /// \return A vector containing the toggle count of every net, indexed like the wire groups
+    std::vector<uint32_t> GetNetToggleCounts(void) const;
+
+    /// \brief Getter for the amount of nets that have been flagged as oscillating in the current simulation
+    /// \return The amount of oscillating nets
+    uint32_t GetOscillatingNetCount(void) const;
+
+    /// \brief Sets whether the simulation should be paused when a net starts oscillating
+    /// \param pEnabled: If true, the simulation is paused when an oscillation is detected
+    void SetPauseOnOscillation(bool pEnabled);
+
+    /// \brief Returns whether the simulation is paused when a net starts oscillating
+    /// \return True, if pausing on oscillation is enabled
+    bool IsPauseOnOscillationEnabled(void) const;
+
+    // Functions for activity profiling
+
+    /// \brief Enables or disables activity profiling of all logic cells, enabling resets all counters
+    /// \param pEnabled: If true, the logic cells count evaluations, input events and notifications
+    void SetProfilingEnabled(bool pEnabled);
+
+    /// \brief Returns whether activity profiling is enabled
+    /// \return True, if profiling is enabled
+    bool IsProfilingEnabled(void) const;
+
+    /// \brief Writes the activity counters per component type, per component and per net to a CSV file
+    /// \param pFilePath: The path of the CSV file to write
+    /// \return False, if the file could not be written
+    bool ExportProfileCsv(const QString& pFilePath) const;
+
+    /// \brief Renders the circuit, or the selected components, to a PNG or SVG image while showing the processing overlay
+    /// \param pFilePath: The path of the image file to write, the format is chosen by the suffix
+    /// \param pScale: The size of one scene unit in pixels
+    /// \param pOnlySelection: If true, only the selected components are exported
+    /// \return False, if the image could not be written, ExportImageFailedSignal has been emitted then
+    bool ExportImage(const QString& pFilePath, double pScale, bool pOnlySelection);
+
     // Functions for undo and redo
 
     /// \brief Returns true, if the undo queue has no elements
@@ -206,9 +264,51 @@ public:
     /// \return A JSON object containing the circuit information
     QJsonObject GetJson(void) const;
 
+    /// \brief Writes the current circuit into the given CBOR stream, one component at a time
+    /// The result is equivalent to GetJson(), but no document of the whole circuit is built in memory
+    /// \param pWriter: The CBOR stream to write into
+    void WriteCbor(QCborStreamWriter& pWriter);
+
+    /// \brief Saves the current circuit into the currently open file
+    void SaveCircuit(void);
+
+    /// \brief Saves the current circuit into the given file
+    /// If another operation is processing, the circuit is saved after it has finished, saving is rejected while loading
+    /// \param pFileInfo: The file to save into
+    void SaveCircuitAs(const QFileInfo& pFileInfo);
+
     /// \brief Resets the canvas
     void NewCircuit(void);
 
+    /// \brief Loads the given circuit file without blocking the GUI
+    /// The file is decoded on a worker thread, the components are added to the scene in batches
+    /// \param pFileInfo: The file to load
+    /// \param pIsFromRecents: Whether the file to open is from the recent files list
+    void LoadCircuitAsync(const QFileInfo& pFileInfo, bool pIsFromRecents = false);
+
+    /// \brief Replaces the canvas with the placed and routed circuit of the given BLIF or structural Verilog netlist
+    /// \param pFileInfo: The netlist file to import
+    void ImportNetlist(const QFileInfo& pFileInfo);
+
+    /// \brief Cancels the running asynchronous load and resets the canvas
+    void CancelLoading(void);
+
+    /// \brief Returns true, if a circuit file is currently being loaded asynchronously
+    /// \return True, if a circuit file is currently being loaded
+    bool IsLoading(void) const;
+
+    /// \brief Sets whether the application runs with a user interface, headless runs (export, tracing, benchmark) must not show dialogs
+    /// \param pIsInteractive: True, if the user can interact with the main window
+    void SetInteractive(bool pIsInteractive);
+
+    /// \brief Restores the unsaved edits of the previous session from the journal of the opened circuit file
+    /// \param pFileInfo: The opened circuit file
+    void RecoverJournal(const QFileInfo& pFileInfo);
+
+    /// \brief Discards the journal of the previous session and starts a new journal for the opened circuit file
+    /// \param pFileInfo: The opened circuit file
+    void DiscardJournal(const QFileInfo& pFileInfo);
+
     // ////////////////////////////
 
 signals:
@@ -243,6 +343,10 @@ signals:
     /// \brief Emitted when the core logic has stopped the simulation
     void SimulationStopSignal(void);
 
+    /// \brief Emitted when a net has exceeded the oscillation threshold
+    /// \param pOscillatingNetCount: The total amount of oscillating nets in the current simulation
+    void OscillationDetectedSignal(uint32_t pOscillatingNetCount);
+
     /// \brief Emitted when the undo/redo button enabled state should be updated
     void UpdateUndoRedoEnabledSignal(void);
 
@@ -254,10 +358,44 @@ signals:
     /// \param pVersion: The software version of the file
     void FileHasNewerIncompatibleVersionSignal(QString pVersion);
 
+    /// \brief Emitted after every batch of components added during an asynchronous load
+    /// \param pCreatedCount: The amount of components added to the scene so far
+    /// \param pDecodedCount: The amount of components decoded so far
+    void LoadProgressSignal(uint32_t pCreatedCount, uint32_t pDecodedCount);
+
+    /// \brief Emitted when an asynchronously loaded file could not be read or decoded
+    /// \param pFileInfo: Info about the file
+    /// \param pIsFromRecents: Whether the file is from the recent files list
+    void AsyncLoadFailedSignal(const QFileInfo& pFileInfo, bool pIsFromRecents);
+
+    /// \brief Emitted when the circuit could not be saved because a file is being loaded
+    /// \param pFileInfo: Info about the file that should have been saved
+    void SaveCircuitRejectedSignal(const QFileInfo& pFileInfo);
+
+    /// \brief Emitted when a netlist has been imported
+    /// \param pFileInfo: Info about the netlist file
+    /// \param pComponentCount: The amount of components, wires and ConPoints that have been created
+    /// \param pUndrivenNets: The names of the nets that are read but not driven by any cell
+    void NetlistImportedSignal(const QFileInfo& pFileInfo, uint32_t pComponentCount, const QStringList& pUndrivenNets);
+
+    /// \brief Emitted when a netlist could not be imported
+    /// \param pFileInfo: Info about the netlist file
+    /// \param pError: The reason why the netlist could not be imported
+    void ImportNetlistFailedSignal(const QFileInfo& pFileInfo, const QString& pError);
+
+    /// \brief Emitted when an image could not be exported
+    /// \param pFilePath: The path of the image file
+    /// \param pError: The reason why the image could not be exported
+    void ExportImageFailedSignal(const QString& pFilePath, const QString& pError);
+
     /// \brief Emitted when a file has been opened and parsed successfully
     /// \param pFileInfo: Reference to the associated file info
     void OpeningFileSuccessfulSignal(const QFileInfo &pFileInfo);
 
+    /// \brief Emitted when a circuit file has been opened that has unsaved edits of a previous session in its journal, only in interactive mode
+    /// \param pFileInfo: Reference to the associated file info
+    void RecoverableJournalFoundSignal(const QFileInfo &pFileInfo);
+
     /// \brief Emitted when the clock configurator should be displayed with the given settings
     /// \param pMode: The clock mode (either toggle or pulse)
     /// \param pToggle: The toggle speed
@@ -285,6 +423,9 @@ public slots:
     /// \param pPulse: The pulse duration
     void OnShowClockConfiguratorRequest(ClockMode pMode, uint32_t pToggle, uint32_t pPulse);
 
+    /// \brief Counts a state change of an input component, which restarts the oscillation detection of all nets
+    void OnInputStateChanged(void);
+
     /// \brief Sets the pulse value of the selected clock to the new value
     /// \param pValue: The new pulse value
     void OnPulseValueChanged(uint32_t pValue);
@@ -311,6 +452,12 @@ public slots:
     /// \brief Displays the processing overlay (loading screen); invoked by mProcessingTimer
     void OnProcessingTimeout(void);
 
+    /// \brief Adds the next batch of decoded components to the scene; invoked by mLoadBatchTimer
+    void OnLoadBatchTimeout(void);
+
+    /// \brief Flags all nets of the oscillating loop, counts them and pauses the simulation if configured; invoked by wire logic cells
+    void OnNetOscillationDetected(void);
+
 protected:
     /// \brief Performs all neccessary steps to enter simulation mode
     void EnterSimulation(void);
@@ -445,9 +592,23 @@ protected:
     /// \brief Creates logic cells for wire groups, including full ConPoints
     void CreateWireLogicCells(void);
 
-    /// \brief Connects all logic cells based on their connector positions
+    /// \brief Connects all logic cells based on their connector positions, the connections are recorded in the netlist cache
     void ConnectLogicCells(void);
 
+    /// \brief Connects all logic cells based on the bindings of the restored netlist
+    void ConnectCachedLogicCells(void);
+
+    /// \brief Returns a counter that changes whenever components are added, moved or removed or an edit is done, undone or redone
+    /// \return The current generation of the circuit
+    uint64_t GetCircuitGeneration(void) const;
+
+    /// \brief Returns all components in the scene
+    /// \return A vector of all components
+    std::vector<IBaseComponent*> GetAllComponents(void) const;
+
+    /// \brief Applies the current profiling setting to all component and wire logic cells
+    void ApplyProfilingState(void);
+
     // Functions for undo and redo
 
     /// \brief Appends the given undo/redo object to the undo queue and clears the redo queue
@@ -481,6 +642,33 @@ protected:
     /// \param pJson: The JSON data of the circuit to load
     void ReadJson(const QFileInfo& pFileInfo, const QJsonObject& pJson);
 
+    /// \brief Loads a circuit from the given CBOR data, decoding one component at a time
+    /// \param pFileInfo: The file info of the loaded file
+    /// \param pHeader: The top level entries of the circuit, without components
+    /// \param pCbor: The uncompressed CBOR data of the circuit to load
+    void ReadCbor(const QFileInfo& pFileInfo, const QJsonObject& pHeader, const QByteArray& pCbor);
+
+    /// \brief Checks the file versions and clears the scene for loading a new circuit
+    /// \param pJson: The JSON data of the circuit to load, only the top level version entries are used
+    /// \return False, if the circuit has a newer, incompatible version and must not be loaded
+    bool PrepareCircuitLoad(const QJsonObject& pJson);
+
+    /// \brief Clears the undo and redo queues after loading a circuit and notifies about the opened file
+    /// \param pFileInfo: The file info of the loaded file
+    void FinishCircuitLoad(const QFileInfo& pFileInfo);
+
+    /// \brief Stops the batch timer, releases the loader and re-enables the GUI
+    void StopLoading(void);
+
+    /// \brief Appends the changes of the given undo object to the autosave journal
+    /// \param pUndoObject: The undo object whose action has just been performed, undone or redone
+    /// \param pIsUndone: Whether the action has been undone, which reverses the direction of the changes
+    void JournalUndoObject(UndoBaseType* pUndoObject, bool pIsUndone);
+
+    /// \brief Appends the current configuration of the given component to the autosave journal
+    /// \param pComponent: The component that has been configured
+    void JournalConfiguredComponent(IBaseComponent* pComponent);
+
     /// \brief Creates a circuit component using the provided JSON data
     /// \param pJson: The JSON data of the circuit component
     /// \return True, if the component has been added
@@ -518,7 +706,21 @@ protected:
 
     std::vector<std::shared_ptr<LogicWireCell>> mLogicWireCells;
 
+    NetlistCache mNetlistCache;
+    uint64_t mEditGeneration = 0; // Covers edits that neither add, move nor remove components, e.g. changing a ConPoint type
+
     QTimer mPropagationTimer; // Main timer to set the propagation delay
+    RenderStatistics* mRenderStatistics = nullptr; // Statistics of the simulated scene, looked up once per simulation
+
+    SimulationSetupTimings mSimulationSetupTimings;
+
+    // Variables for oscillation detection
+    uint64_t mSimulationTick = 0;
+    uint64_t mInputChangeCount = 0;
+    uint32_t mOscillatingNetCount = 0;
+    bool mPauseOnOscillation = simulation::PAUSE_ON_OSCILLATION;
+
+    bool mIsProfilingEnabled = profiling::PROFILING_ENABLED;
 
     // Undo and redo queues
     std::deque<UndoBaseType*> mUndoQueue;
@@ -527,12 +729,22 @@ protected:
     QTimer mProcessingTimer;
 
     bool mIsProcessing = false;
+    bool mIsInteractive = false;
+    std::optional<QFileInfo> mPendingSaveFile;
+
+    // Variables for asynchronous loading
+    std::unique_ptr<CircuitLoader> mCircuitLoader;
+    QTimer mLoadBatchTimer;
+    bool mIsLoadFromRecents = false;
+    bool mIsLoadPrepared = false;
+    uint32_t mLoadedComponentCount = 0;
 
     std::vector<IBaseComponent*> mCopiedComponents;
     std::vector<IBaseComponent*> mCurrentPaste;
     std::optional<UndoCopyType*> mCurrentCopyUndoType;
 
     CircuitFileParser mCircuitFileParser;
+    CircuitJournal mCircuitJournal;
     RuntimeConfigParser mRuntimeConfigParser;
 };
 
@@ -89,6 +89,14 @@ void MainWindow::InitializeMessageBoxes()
     mErrorSaveFileBox.setText(tr("The circuit could not be saved."));
     mErrorSaveFileBox.setStandardButtons(QMessageBox::Ok);
     mErrorSaveFileBox.setDefaultButton(QMessageBox::Ok);
+
+    mRecoverJournalBox.setIcon(QMessageBox::Icon::Question);
+    mRecoverJournalBox.setWindowTitle("Linkuit Studio");
+    mRecoverJournalBox.setWindowIcon(QIcon(":/images/icons/icon_default.png"));
+    mRecoverJournalBox.setText(tr("There are unsaved changes to this circuit from a previous session."));
+    mRecoverJournalBox.setInformativeText(tr("Would you like to restore these changes?"));
+    mRecoverJournalBox.setStandardButtons(QMessageBox::Yes | QMessageBox::Discard);
+    mRecoverJournalBox.setDefaultButton(QMessageBox::Yes);
 }
 
 void MainWindow::InitializeTutorial()
@@ -104,13 +112,25 @@ void MainWindow::ConnectGuiSignalsAndSlots()
 
     QObject::connect(&mCoreLogic, &CoreLogic::OpeningFileSuccessfulSignal, this, &MainWindow::OnCircuitFileOpenedSuccessfully);
     QObject::connect(&mCoreLogic.GetCircuitFileParser(), &CircuitFileParser::LoadCircuitFileFailedSignal, this, &MainWindow::OnCircuitFileOpeningFailed);
+    QObject::connect(&mCoreLogic, &CoreLogic::AsyncLoadFailedSignal, this, &MainWindow::OnCircuitFileOpeningFailed);
+    QObject::connect(&mCoreLogic, &CoreLogic::ImportNetlistFailedSignal, this, &MainWindow::OnNetlistImportFailed);
+    QObject::connect(&mCoreLogic, &CoreLogic::NetlistImportedSignal, this, &MainWindow::OnNetlistImported);
 
     QObject::connect(&mCoreLogic.GetCircuitFileParser(), &CircuitFileParser::SaveCircuitFileSuccessSignal, this, &MainWindow::OnCircuitFileSavedSuccessfully);
     QObject::connect(&mCoreLogic.GetCircuitFileParser(), &CircuitFileParser::SaveCircuitFileFailedSignal, this, &MainWindow::OnCircuitFileSavingFailed);
+    QObject::connect(&mCoreLogic, &CoreLogic::ExportImageFailedSignal, this, [&](const QString& pFilePath, const QString& pError)
+    {
+        QMessageBox::warning(this, "Linkuit Studio", tr("The image could not be written to %0.\n%1").arg(pFilePath, pError));
+    });
+    QObject::connect(&mCoreLogic, &CoreLogic::SaveCircuitRejectedSignal, this, [&](const QFileInfo& pFileInfo)
+    {
+        QMessageBox::warning(this, "Linkuit Studio", tr("%0 could not be saved while a file is being loaded.\nPlease save again after loading has finished.").arg(pFileInfo.fileName()));
+    });
 
     QObject::connect(&mCoreLogic, &CoreLogic::OpeningFileSuccessfulSignal, this, &MainWindow::OnCircuitFileOpenedSuccessfully);
     QObject::connect(&mCoreLogic, &CoreLogic::FileHasNewerCompatibleVersionSignal, this, &MainWindow::OnCircuitFileHasNewerCompatibleVersion);
     QObject::connect(&mCoreLogic, &CoreLogic::FileHasNewerIncompatibleVersionSignal, this, &MainWindow::OnCircuitFileHasNewerIncompatibleVersion);
+    QObject::connect(&mCoreLogic, &CoreLogic::RecoverableJournalFoundSignal, this, &MainWindow::OnRecoverableJournalFound);
 
     // Connect to core logic signals
 
@@ -141,6 +161,11 @@ void MainWindow::ConnectGuiSignalsAndSlots()
         ShowItemConfigurator(GetConfiguratorModeForComponentType(pNewType));
     });
 
+    QObject::connect(&mCoreLogic, &CoreLogic::OscillationDetectedSignal, this, [&](uint32_t pOscillatingNetCount)
+    {
+        mUi->uLabelStatus->setText(tr("Oscillation detected on %0 net(s).").arg(pOscillatingNetCount));
+    });
+
     QObject::connect(&mCoreLogic, &CoreLogic::UpdateUndoRedoEnabledSignal, this, [this]()
     {
         UpdateUndoRedoEnabled(true);
@@ -166,6 +191,11 @@ void MainWindow::ConnectGuiSignalsAndSlots()
         FadeOutGui();
     });
 
+    QObject::connect(&mCoreLogic, &CoreLogic::LoadProgressSignal, this, [&](uint32_t pCreatedCount, uint32_t pDecodedCount)
+    {
+        mUi->uLabelStatus->setText(tr("Loading... %0 / %1 components (Esc to cancel)").arg(pCreatedCount).arg(pDecodedCount));
+    });
+
     QObject::connect(&mCoreLogic, &CoreLogic::ProcessingEndedSignal, this, [&]()
     {
         mUi->menuBar->setEnabled(true);
@@ -336,6 +366,7 @@ void MainWindow::ConnectGuiSignalsAndSlots()
     QObject::connect(mUi->uActionStep, &QAction::triggered, this, &MainWindow::StepSimulation);
     QObject::connect(mUi->uActionReset, &QAction::triggered, this, &MainWindow::ResetSimulation);
     QObject::connect(mUi->uActionPause, &QAction::triggered, this, &MainWindow::PauseSimulation);
+    QObject::connect(mUi->uActionPauseOnOscillation, &QAction::toggled, &mCoreLogic, &CoreLogic::SetPauseOnOscillation);
     QObject::connect(mUi->uActionAbout, &QAction::triggered, &mAboutDialog, &AboutDialog::show);
     QObject::connect(mUi->uActionClose, &QAction::triggered, this, &MainWindow::close);
 
@@ -364,7 +395,24 @@ void MainWindow::ConnectGuiSignalsAndSlots()
 
             if (!fileInfo.absoluteFilePath().isEmpty())
             {
-                mCoreLogic.GetCircuitFileParser().LoadJson(fileInfo);
+                mCoreLogic.LoadCircuitAsync(fileInfo);
+            }
+        }
+    });
+
+    QObject::connect(mUi->uActionImportNetlist, &QAction::triggered, this, [&]()
+    {
+        mFadeOutOnCtrlTimer.stop();
+
+        if (!IsSaveChangesIfModifiedCanceled())
+        {
+            QString path = mCoreLogic.GetCircuitFileParser().IsFileOpen() ? mCoreLogic.GetCircuitFileParser().GetFileInfo().value().absolutePath() : mCoreLogic.GetRuntimeConfigParser().GetLastFilePath();
+            const auto fileInfo = QFileInfo(QFileDialog::getOpenFileName(this, tr("Import Netlist"), path, tr("Netlists (*.blif *.v)")));
+
+            if (!fileInfo.absoluteFilePath().isEmpty())
+            {
+                setWindowTitle(tr(gui::DEFAULT_WINDOW_TITLE));
+                mCoreLogic.ImportNetlist(fileInfo);
             }
         }
     });
@@ -374,7 +422,7 @@ void MainWindow::ConnectGuiSignalsAndSlots()
         mCoreLogic.AbortPastingIfInCopy();
         if (mCoreLogic.GetCircuitFileParser().IsFileOpen())
         {
-            mCoreLogic.GetCircuitFileParser().SaveJson(mCoreLogic.GetJson());
+            mCoreLogic.SaveCircuit();
         }
         else
         {
@@ -393,7 +441,7 @@ void MainWindow::ConnectGuiSignalsAndSlots()
 
         if (fileInfo.absoluteFilePath() != "")
         {
-            mCoreLogic.GetCircuitFileParser().SaveJsonAs(fileInfo, mCoreLogic.GetJson());
+            mCoreLogic.SaveCircuitAs(fileInfo);
         }
     });
 
@@ -436,7 +484,62 @@ void MainWindow::ConnectGuiSignalsAndSlots()
 
     QObject::connect(mUi->uActionScreenshot, &QAction::triggered, this, [&]()
     {
-        qDebug() << "Not implemented";
+        mFadeOutOnCtrlTimer.stop();
+        FadeInGui();
+
+        const auto filePath = QFileDialog::getSaveFileName(this, tr("Export Image"), mCoreLogic.GetRuntimeConfigParser().GetLastFilePath(), tr("PNG Images (*.png);;SVG Images (*.svg)"));
+
+        if (filePath.isEmpty())
+        {
+            return;
+        }
+
+        bool ok = false;
+        const double scale = QInputDialog::getDouble(this, tr("Export Image"), tr("Scale (1 = 100 %):"),
+                                                     image_export::DEFAULT_SCALE, image_export::MIN_SCALE, image_export::MAX_SCALE, 2, &ok);
+
+        if (!ok)
+        {
+            return;
+        }
+
+        // Only the selected components are exported if there is a selection
+        const bool onlySelection = !mView.Scene()->selectedItems().isEmpty();
+
+        mCoreLogic.ExportImage(filePath, scale, onlySelection);
+    });
+
+    QObject::connect(mUi->uActionMinimap, &QAction::toggled, &mView, &View::SetMinimapVisible);
+    QObject::connect(mUi->uActionMinimapSimulationState, &QAction::toggled, &mView, &View::SetMinimapStateTinted);
+
+    QObject::connect(mUi->uActionProfiler, &QAction::toggled, &mCoreLogic, &CoreLogic::SetProfilingEnabled);
+
+    QObject::connect(mUi->uActionExportProfile, &QAction::triggered, this, [&]()
+    {
+        mFadeOutOnCtrlTimer.stop();
+        FadeInGui();
+
+        const auto filePath = QFileDialog::getSaveFileName(this, tr("Export Profile"), mCoreLogic.GetRuntimeConfigParser().GetLastFilePath(), tr("CSV Files (*.csv)"));
+
+        if (!filePath.isEmpty() && !mCoreLogic.ExportProfileCsv(filePath))
+        {
+            QMessageBox::warning(this, "Linkuit Studio", tr("The profile could not be written to %0.").arg(filePath));
+        }
+    });
+
+    QObject::connect(mUi->uActionRenderStatistics, &QAction::toggled, &mView, &View::SetRenderStatisticsEnabled);
+
+    QObject::connect(mUi->uActionExportRenderStatistics, &QAction::triggered, this, [&]()
+    {
+        mFadeOutOnCtrlTimer.stop();
+        FadeInGui();
+
+        const auto filePath = QFileDialog::getSaveFileName(this, tr("Export Render Statistics"), mCoreLogic.GetRuntimeConfigParser().GetLastFilePath(), tr("CSV Files (*.csv)"));
+
+        if (!filePath.isEmpty() && !mView.ExportRenderStatisticsCsv(filePath))
+        {
+            QMessageBox::warning(this, "Linkuit Studio", tr("The render statistics could not be written to %0.").arg(filePath));
+        }
     });
 
     QObject::connect(mUi->uActionStartTutorial, &QAction::triggered, this, [&]()
@@ -531,6 +634,18 @@ void MainWindow::OnCircuitFileHasNewerCompatibleVersion(const QString& pVersion)
     mNewerVersionCompatibleBox.exec();
 }
 
+void MainWindow::OnRecoverableJournalFound(const QFileInfo& pFileInfo)
+{
+    if (mRecoverJournalBox.exec() == QMessageBox::Yes)
+    {
+        mCoreLogic.RecoverJournal(pFileInfo);
+    }
+    else
+    {
+        mCoreLogic.DiscardJournal(pFileInfo);
+    }
+}
+
 void MainWindow::OnCircuitFileHasNewerIncompatibleVersion(const QString& pVersion)
 {
     mNewerVersionIncompatibleBox.setIcon(QMessageBox::Icon::Critical);
@@ -563,6 +678,23 @@ void MainWindow::OnCircuitFileOpeningFailed(const QFileInfo& pFileInfo, bool pIs
     }
 }
 
+void MainWindow::OnNetlistImportFailed(const QFileInfo& pFileInfo, const QString& pError)
+{
+    mErrorOpenFileBox.setText(tr("The netlist %0 could not be imported.\n%1").arg(pFileInfo.fileName(), pError));
+    mErrorOpenFileBox.exec();
+}
+
+void MainWindow::OnNetlistImported(const QFileInfo& pFileInfo, uint32_t pComponentCount, const QStringList& pUndrivenNets)
+{
+    mUi->uLabelStatus->setText(tr("Imported %0 components from %1.").arg(pComponentCount).arg(pFileInfo.fileName()));
+
+    if (!pUndrivenNets.isEmpty())
+    {
+        QMessageBox::warning(this, "Linkuit Studio", tr("%0 net(s) of %1 are not driven by any cell and stay low:\n%2")
+                             .arg(pUndrivenNets.size()).arg(pFileInfo.fileName(), pUndrivenNets.mid(0, gui::MAX_LISTED_UNDRIVEN_NETS).join(", ")));
+    }
+}
+
 void MainWindow::OnCircuitFileSavedSuccessfully(const QFileInfo& pFileInfo)
 {
     setWindowTitle(tr("Linkuit Studio - %0").arg(pFileInfo.fileName()));
@@ -579,7 +711,7 @@ void MainWindow::OpenRecentFile(const QFileInfo& pFileInfo)
 {
     if (!IsSaveChangesIfModifiedCanceled())
     {
-        mCoreLogic.GetCircuitFileParser().LoadJson(pFileInfo, true);
+        mCoreLogic.LoadCircuitAsync(pFileInfo, true);
     }
 }
 
@@ -1081,6 +1213,7 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionNew->setEnabled(true);
             mUi->uActionOpen->setEnabled(true);
+            mUi->uActionImportNetlist->setEnabled(true);
 
             mUi->uActionCut->setEnabled(true);
             mUi->uActionCopy->setEnabled(true);
@@ -1118,6 +1251,7 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionNew->setEnabled(true);
             mUi->uActionOpen->setEnabled(true);
+            mUi->uActionImportNetlist->setEnabled(true);
 
             mUi->uActionCut->setEnabled(false);
             mUi->uActionCopy->setEnabled(false);
@@ -1155,6 +1289,7 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionNew->setEnabled(true);
             mUi->uActionOpen->setEnabled(true);
+            mUi->uActionImportNetlist->setEnabled(true);
 
             mUi->uActionCut->setEnabled(true);
             mUi->uActionCopy->setEnabled(true);
@@ -1190,6 +1325,7 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionNew->setEnabled(true);
             mUi->uActionOpen->setEnabled(true);
+            mUi->uActionImportNetlist->setEnabled(true);
 
             mUi->uActionCut->setEnabled(true);
             mUi->uActionCopy->setEnabled(true);
@@ -1228,6 +1364,7 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionNew->setEnabled(true);
             mUi->uActionOpen->setEnabled(true);
+            mUi->uActionImportNetlist->setEnabled(true);
 
             mUi->uActionCut->setEnabled(false);
             mUi->uActionCopy->setEnabled(false);
@@ -1570,6 +1707,7 @@ void MainWindow::InitializeGuiIcons()
     // Icons for menu bar elements
     mUi->uActionNew->setIcon(mAwesome.icon(fa::fileo, mMenuBarIconVariant));
     mUi->uActionOpen->setIcon(mAwesome.icon(fa::folderopeno, mMenuBarIconVariant));
+    mUi->uActionImportNetlist->setIcon(mAwesome.icon(fa::sitemap, mMenuBarIconVariant));
     mUi->uActionSave->setIcon(mAwesome.icon(fa::floppyo, mMenuBarIconVariant));
 
     mUi->uActionCut->setIcon(mAwesome.icon(fa::scissors, mMenuBarIconVariant));
@@ -1683,6 +1821,12 @@ void MainWindow::InitializeGlobalShortcuts()
 
     QObject::connect(mEscapeShortcut, &QShortcut::activated, this, [&]()
     {
+        if (mCoreLogic.IsLoading())
+        {
+            mCoreLogic.CancelLoading();
+            return;
+        }
+
         mCoreLogic.EnterControlMode(ControlMode::EDIT);
         mScene.clearSelection();
         mUi->uToolboxTree->clearSelection();
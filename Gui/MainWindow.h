@@ -73,11 +73,26 @@ protected slots:
     /// \param pVersion: The newer file version
     void OnCircuitFileHasNewerIncompatibleVersion(const QString& pVersion);
 
+    /// \brief Asks whether the unsaved edits of the previous session should be restored from the journal
+    /// \param pFileInfo: Info about the opened circuit file
+    void OnRecoverableJournalFound(const QFileInfo& pFileInfo);
+
     /// \brief Shows an error dialog box when opening the circuit file failed
     /// \param pFileInfo: Info about the circuit file that could not be opened
     /// \param pIsFromRecents: Whether the file is from the recent files list
     void OnCircuitFileOpeningFailed(const QFileInfo& pFileInfo, bool pIsFromRecents);
 
+    /// \brief Shows an error message box with the reason why the netlist could not be imported
+    /// \param pFileInfo: Info about the netlist file
+    /// \param pError: The reason why the netlist could not be imported
+    void OnNetlistImportFailed(const QFileInfo& pFileInfo, const QString& pError);
+
+    /// \brief Shows a summary of the imported netlist in the status bar and warns about undriven nets
+    /// \param pFileInfo: Info about the netlist file
+    /// \param pComponentCount: The amount of components, wires and ConPoints that have been created
+    /// \param pUndrivenNets: The names of the nets that are read but not driven by any cell
+    void OnNetlistImported(const QFileInfo& pFileInfo, uint32_t pComponentCount, const QStringList& pUndrivenNets);
+
     /// \brief Configures the GUI and inserts the newly saved file into the recent files
     /// \param pFileInfo: Info about the newly saved circuit file
     void OnCircuitFileSavedSuccessfully(const QFileInfo& pFileInfo);
@@ -322,6 +337,7 @@ protected:
     QMessageBox mErrorSaveFileBox;
     QMessageBox mNewerVersionCompatibleBox;
     QMessageBox mNewerVersionIncompatibleBox;
+    QMessageBox mRecoverJournalBox;
 
     // Icon color variants
 
@@ -0,0 +1,346 @@
+#include "Minimap.h"
+#include "Configuration.h"
+#include "Components/IBaseComponent.h"
+#include "Components/LogicWire.h"
+#include "Components/ConPoint.h"
+#include "ViewportTracker.h"
+#include "SceneHelper.h"
+
+#include <QEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <algorithm>
+
+Minimap::Minimap(QGraphicsView &pGraphicsView) :
+    QWidget(&pGraphicsView),
+    mGraphicsView(pGraphicsView)
+{
+    setFixedSize(gui::MINIMAP_SIZE);
+    setCursor(Qt::PointingHandCursor);
+
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(gui::MINIMAP_UPDATE_DELAY);
+    QObject::connect(&mUpdateTimer, &QTimer::timeout, this, &Minimap::UpdateRaster);
+
+    mGraphicsView.installEventFilter(this);
+}
+
+void Minimap::SetScene(QGraphicsScene *pScene)
+{
+    mScene = pScene;
+    UpdateConnections();
+
+    mIsOutdated = true;
+    mUpdateTimer.start();
+}
+
+void Minimap::SetViewportRect(const QRectF &pRect)
+{
+    mViewportRect = pRect;
+
+    if (isVisible())
+    {
+        update();
+    }
+}
+
+void Minimap::SetStateTinted(bool pTinted)
+{
+    mIsStateTinted = pTinted;
+    UpdateConnections();
+
+    mIsOutdated = true;
+    mUpdateTimer.start();
+}
+
+void Minimap::SetSimulationRunning(bool pRunning)
+{
+    if (!pRunning && mIsStateTinted && !mArea.isNull())
+    {
+        AddChangedArea(mArea); // The logic states have been reset outside of the viewport as well
+        ScheduleUpdate();
+    }
+}
+
+void Minimap::OnSceneChanged(const QList<QRectF> &pRegion)
+{
+    for (const auto& rect : pRegion)
+    {
+        AddChangedArea(rect);
+    }
+
+    ScheduleUpdate();
+}
+
+void Minimap::OnUpdateDeferred(const QRectF &pRect)
+{
+    AddChangedArea(pRect);
+    ScheduleUpdate();
+}
+
+void Minimap::AddChangedArea(const QRectF &pRect)
+{
+    if (mIsOutdated || pRect.isNull())
+    {
+        return;
+    }
+
+    // Changes outside of the shown area may have grown the occupied area
+    if (mArea.isNull() || !mArea.contains(pRect))
+    {
+        mIsOutdated = true;
+        mChangedAreas.clear();
+        return;
+    }
+
+    mChangedAreas.push_back(pRect);
+
+    if (mChangedAreas.size() > gui::MINIMAP_MAX_CHANGED_AREAS)
+    {
+        QRectF boundingRect;
+        for (const auto& rect : mChangedAreas)
+        {
+            boundingRect = boundingRect.united(rect);
+        }
+
+        mChangedAreas.assign(1, boundingRect);
+    }
+}
+
+void Minimap::ScheduleUpdate()
+{
+    if (isVisible() && !mUpdateTimer.isActive())
+    {
+        mUpdateTimer.start();
+    }
+}
+
+void Minimap::UpdateRaster()
+{
+    if (!isVisible() || nullptr == mScene)
+    {
+        return; // Updated when shown
+    }
+
+    if (mIsOutdated)
+    {
+        Rebuild();
+    }
+    else
+    {
+        for (const auto& rect : mChangedAreas)
+        {
+            RenderArea(rect);
+        }
+    }
+
+    mChangedAreas.clear();
+    update();
+}
+
+bool Minimap::eventFilter(QObject *pObject, QEvent *pEvent)
+{
+    if (pObject == &mGraphicsView && pEvent->type() == QEvent::Resize)
+    {
+        move(mGraphicsView.width() - width() - gui::MINIMAP_MARGIN, mGraphicsView.height() - height() - gui::MINIMAP_MARGIN);
+    }
+
+    return QWidget::eventFilter(pObject, pEvent);
+}
+
+void Minimap::showEvent(QShowEvent *pEvent)
+{
+    QWidget::showEvent(pEvent);
+
+    move(mGraphicsView.width() - width() - gui::MINIMAP_MARGIN, mGraphicsView.height() - height() - gui::MINIMAP_MARGIN);
+
+    UpdateConnections();
+
+    mIsOutdated = true;
+    mUpdateTimer.start();
+}
+
+void Minimap::hideEvent(QHideEvent *pEvent)
+{
+    QWidget::hideEvent(pEvent);
+
+    UpdateConnections();
+    mUpdateTimer.stop();
+}
+
+void Minimap::UpdateConnections()
+{
+    QObject::disconnect(mUpdateDeferredConnection);
+
+    const bool isSceneObserved = (nullptr != mScene && isVisible());
+
+    if (!isSceneObserved || mObservedScene != mScene)
+    {
+        // Qt keeps updating the views only through the changed signal, until their scene is set again
+        if (QObject::disconnect(mSceneChangedConnection))
+        {
+            RestoreDirectViewUpdates(mObservedScene);
+        }
+        mObservedScene = nullptr;
+    }
+
+    if (!isSceneObserved)
+    {
+        return;
+    }
+
+    if (nullptr == mObservedScene)
+    {
+        mSceneChangedConnection = QObject::connect(mScene, &QGraphicsScene::changed, this, &Minimap::OnSceneChanged);
+        mObservedScene = mScene;
+    }
+
+    // Components outside of the viewport do not repaint their logic state changes, so the scene does not report them
+    const auto tracker = ViewportTracker::FromScene(mScene);
+    if (mIsStateTinted && nullptr != tracker)
+    {
+        mUpdateDeferredConnection = QObject::connect(tracker, &ViewportTracker::UpdateDeferredSignal, this, &Minimap::OnUpdateDeferred);
+    }
+}
+
+void Minimap::paintEvent(QPaintEvent *pEvent)
+{
+    Q_UNUSED(pEvent);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), gui::MINIMAP_BACKGROUND_COLOR);
+    painter.drawImage(QPointF(0, 0), mRaster);
+
+    if (!mArea.isNull() && !mViewportRect.isNull())
+    {
+        painter.setPen(QPen(gui::MINIMAP_VIEWPORT_COLOR, 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(mSceneToMinimap.mapRect(mViewportRect).intersected(QRectF(rect()).adjusted(0, 0, -1, -1)));
+    }
+
+    painter.setPen(QPen(gui::MINIMAP_BORDER_COLOR, 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+}
+
+void Minimap::mousePressEvent(QMouseEvent *pEvent)
+{
+    if (pEvent->button() == Qt::LeftButton)
+    {
+        CenterViewOn(pEvent->pos());
+    }
+
+    pEvent->accept(); // Clicks on the minimap never reach the canvas
+}
+
+void Minimap::mouseMoveEvent(QMouseEvent *pEvent)
+{
+    if (pEvent->buttons() & Qt::LeftButton)
+    {
+        CenterViewOn(pEvent->pos());
+    }
+
+    pEvent->accept();
+}
+
+void Minimap::Rebuild()
+{
+    Q_ASSERT(mScene);
+
+    mIsOutdated = false;
+    mChangedAreas.clear();
+
+    const qreal devicePixelRatio = devicePixelRatioF();
+    mRaster = QImage(size() * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    mRaster.setDevicePixelRatio(devicePixelRatio);
+    mRaster.fill(Qt::transparent);
+
+    const auto occupiedArea = mScene->itemsBoundingRect();
+
+    if (occupiedArea.isEmpty())
+    {
+        mArea = QRectF();
+        return;
+    }
+
+    const double padding = std::max(occupiedArea.width(), occupiedArea.height()) * gui::MINIMAP_AREA_PADDING;
+    const auto paddedArea = occupiedArea.adjusted(-padding, -padding, padding, padding);
+
+    // The shown area is widened to the aspect ratio of the minimap, so that it fills the whole minimap
+    const double scale = std::min(width() / paddedArea.width(), height() / paddedArea.height());
+    mArea = QRectF(paddedArea.center() - QPointF(width(), height()) / (2 * scale), QSizeF(size()) / scale);
+    mSceneToMinimap = QTransform::fromScale(scale, scale).translate(-mArea.left(), -mArea.top());
+
+    RenderArea(mArea);
+}
+
+void Minimap::RenderArea(const QRectF &pRect)
+{
+    if (mArea.isNull())
+    {
+        return;
+    }
+
+    // Whole pixels are cleared and rendered again, so that no partially covered pixels remain at the border
+    const QRect pixelRect = mSceneToMinimap.mapRect(pRect).toAlignedRect().adjusted(-1, -1, 1, 1).intersected(rect());
+
+    if (pixelRect.isEmpty())
+    {
+        return;
+    }
+
+    // Grown by one pixel, lines of components just outside of the area reach into its border pixels
+    const double pixelSize = 1 / mSceneToMinimap.m11();
+    const auto sceneRect = mSceneToMinimap.inverted().mapRect(QRectF(pixelRect)).adjusted(-pixelSize, -pixelSize, pixelSize, pixelSize);
+    const auto items = mScene->items(sceneRect, Qt::IntersectsItemBoundingRect, Qt::AscendingOrder);
+
+    QPainter painter(&mRaster);
+    painter.setClipRect(pixelRect);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(pixelRect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setTransform(mSceneToMinimap);
+
+    // Cosmetic pens, so that every wire and component is at least one pixel wide
+    QPen wirePen(gui::MINIMAP_WIRE_COLOR, 0);
+
+    for (const auto& item : items)
+    {
+        const auto wire = dynamic_cast<const LogicWire*>(item);
+
+        if (nullptr != wire && wire->isVisible())
+        {
+            if (mIsStateTinted)
+            {
+                wirePen.setColor(wire->GetColor(false));
+            }
+
+            painter.setPen(wirePen);
+            painter.drawLine(wire->GetLine());
+        }
+    }
+
+    painter.setPen(QPen(components::FILL_COLOR, 0));
+    painter.setBrush(components::FILL_COLOR);
+
+    for (const auto& item : items)
+    {
+        if (nullptr != item->parentItem() || !item->isVisible() || nullptr == dynamic_cast<const IBaseComponent*>(item)
+                || nullptr != dynamic_cast<const LogicWire*>(item) || nullptr != dynamic_cast<const ConPoint*>(item))
+        {
+            continue;
+        }
+
+        painter.drawRect(item->sceneBoundingRect());
+    }
+}
+
+void Minimap::CenterViewOn(QPointF pPos)
+{
+    if (mArea.isNull())
+    {
+        return;
+    }
+
+    mGraphicsView.centerOn(mSceneToMinimap.inverted().map(pPos));
+}
@@ -0,0 +1,126 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QImage>
+#include <QTimer>
+#include <QTransform>
+#include <QWidget>
+#include <vector>
+
+///
+/// \brief The Minimap class shows an overview of the occupied scene area in the bottom right corner of the canvas.
+/// The overview is drawn from a cached low resolution raster, changed areas of the scene are re-rendered
+/// shortly after the change, the whole raster is only rendered again when the occupied area grows beyond it.
+/// Clicking or dragging on the minimap centers the view on that position.
+///
+class Minimap : public QWidget
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the Minimap
+    /// \param pGraphicsView: The view whose viewport is shown and moved, becomes the parent of the minimap
+    Minimap(QGraphicsView &pGraphicsView);
+
+    /// \brief Sets the scene to show, the raster is rendered again
+    /// \param pScene: Pointer to the scene
+    void SetScene(QGraphicsScene *pScene);
+
+    /// \brief Sets the area of the scene that is visible in the view
+    /// \param pRect: The visible area in scene coordinates
+    void SetViewportRect(const QRectF &pRect);
+
+public slots:
+    /// \brief Enables or disables tinting the wires by their logic state
+    /// \param pTinted: If true, wires are drawn in the color of their logic state
+    void SetStateTinted(bool pTinted);
+
+    /// \brief Refreshes the tinted logic states when the simulation stops, because all states have been reset
+    /// \param pRunning: True, if a simulation is running
+    void SetSimulationRunning(bool pRunning);
+
+protected slots:
+    /// \brief Collects the changed areas of the scene and schedules their re-rendering
+    /// \param pRegion: The changed areas in scene coordinates
+    void OnSceneChanged(const QList<QRectF> &pRegion);
+
+    /// \brief Schedules the re-rendering of a component outside of the viewport whose logic state has changed
+    /// \param pRect: The scene bounding rect of the component
+    void OnUpdateDeferred(const QRectF &pRect);
+
+    /// \brief Re-renders all changed areas, or the whole raster if the occupied area has grown
+    void UpdateRaster(void);
+
+protected:
+    /// \brief Moves the minimap into the corner of the view when the view is resized
+    /// \param pObject: The watched object
+    /// \param pEvent: The event
+    /// \return Always false, the event is passed on
+    bool eventFilter(QObject *pObject, QEvent *pEvent) override;
+
+    /// \brief Starts watching the scene for changes and renders the whole raster, changes are not tracked while hidden
+    /// \param pEvent: The show event
+    void showEvent(QShowEvent *pEvent) override;
+
+    /// \brief Stops watching the scene for changes
+    /// \param pEvent: The hide event
+    void hideEvent(QHideEvent *pEvent) override;
+
+    /// \brief Connects to the changes of the scene while the minimap is visible, and to the deferred repaints
+    /// of components outside of the viewport while the logic states are tinted as well.
+    /// After disconnecting from the changes, the views of the scene are reset to be updated directly again
+    void UpdateConnections(void);
+
+    /// \brief Draws the raster and the visible area of the view
+    /// \param pEvent: The paint event
+    void paintEvent(QPaintEvent *pEvent) override;
+
+    /// \brief Centers the view on the clicked position
+    /// \param pEvent: The mouse press event
+    void mousePressEvent(QMouseEvent *pEvent) override;
+
+    /// \brief Centers the view on the dragged position
+    /// \param pEvent: The mouse move event
+    void mouseMoveEvent(QMouseEvent *pEvent) override;
+
+    /// \brief Adds a changed area to be re-rendered, the whole raster is rendered again if it lies outside of the shown area
+    /// \param pRect: The changed area in scene coordinates
+    void AddChangedArea(const QRectF &pRect);
+
+    /// \brief Starts the update delay, unless an update is already scheduled or the minimap is hidden
+    void ScheduleUpdate(void);
+
+    /// \brief Fits the occupied area of the scene into the minimap and renders the whole raster
+    void Rebuild(void);
+
+    /// \brief Renders the components within the given area into the raster
+    /// \param pRect: The area in scene coordinates
+    void RenderArea(const QRectF &pRect);
+
+    /// \brief Centers the view on the scene position below the given minimap position
+    /// \param pPos: The position in minimap coordinates
+    void CenterViewOn(QPointF pPos);
+
+protected:
+    QGraphicsView &mGraphicsView;
+    QGraphicsScene *mScene = nullptr;
+
+    QImage mRaster;
+    QRectF mArea; // The shown area in scene coordinates, null if the scene is empty
+    QTransform mSceneToMinimap;
+    QRectF mViewportRect;
+
+    std::vector<QRectF> mChangedAreas;
+    bool mIsOutdated = true; // If true, the whole raster is rendered again with the next update
+
+    QTimer mUpdateTimer;
+
+    QMetaObject::Connection mSceneChangedConnection;
+    QGraphicsScene *mObservedScene = nullptr; // The scene mSceneChangedConnection belongs to
+    QMetaObject::Connection mUpdateDeferredConnection;
+
+    bool mIsStateTinted = false;
+};
+
+#endif // MINIMAP_H
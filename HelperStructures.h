@@ -2,6 +2,7 @@
 #define HELPERSTRUCTURES_H
 
 #include <QString>
+#include <chrono>
 
 namespace helpers
 {
@@ -22,6 +23,16 @@ struct SwVersion
     uint8_t patch;
 };
 
+/// \brief SimulationSetupTimings contains the durations of the phases of entering the simulation
+struct SimulationSetupTimings
+{
+    std::chrono::nanoseconds parseWireGroups{0};
+    std::chrono::nanoseconds createWireLogicCells{0};
+    std::chrono::nanoseconds connectLogicCells{0};
+    std::chrono::nanoseconds total{0};
+    bool isNetlistCached = false; // The connectivity has been restored from the netlist cache instead of being parsed
+};
+
 namespace file
 {
     enum class SaveFormat
@@ -62,6 +73,14 @@ namespace file
         D_MS_FLIPFLOP,
         JK_MS_FLIPFLOP // only append!
     };
+
+    enum class ComponentReadResult
+    {
+        COMPLETE = 0,   // All components have been read
+        STOPPED,        // The component handler has stopped reading
+        TRUNCATED,      // The data ends early or is damaged, the components before have been read
+        INVALID         // The data does not follow the circuit format, the components read so far may lack fields
+    };
 } // namespace file
 
 enum class ComponentType
@@ -1,4 +1,4 @@
-QT += core gui
+QT += core gui svg
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -19,6 +19,12 @@ DEFINES += FULL_VERSION='\\"$$FULL_VERSION\\"'
 
 VERSION = "$$FULL_VERSION"
 
+win32: LIBS += -lpsapi
+
+# The PNG export streams its image data through zlib, Windows builds use the zlib bundled with Qt
+unix: LIBS += -lz
+win32: QT += zlib-private
+
 SOURCES += \
    $${PWD}/main.cpp
 
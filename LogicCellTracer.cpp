@@ -0,0 +1,448 @@
+#include "LogicCellTracer.h"
+#include "Configuration.h"
+
+#include "Components/Gates/LogicCells/LogicAndGateCell.h"
+#include "Components/Gates/LogicCells/LogicOrGateCell.h"
+#include "Components/Gates/LogicCells/LogicXorGateCell.h"
+#include "Components/Gates/LogicCells/LogicNotGateCell.h"
+#include "Components/Gates/LogicCells/LogicBufferGateCell.h"
+#include "Components/Inputs/LogicCells/LogicInputCell.h"
+#include "Components/Inputs/LogicCells/LogicButtonCell.h"
+#include "Components/Inputs/LogicCells/LogicClockCell.h"
+#include "Components/Inputs/LogicCells/LogicConstantCell.h"
+#include "Components/Outputs/LogicCells/LogicOutputCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicHalfAdderCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicFullAdderCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicRsFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicRsClockedFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicRsMsFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicDFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicDMsFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicTFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicJKFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicJkMsFlipFlopCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicMultiplexerCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicDemultiplexerCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicDecoderCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicEncoderCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicCounterCell.h"
+#include "Components/ComplexLogic/LogicCells/LogicShiftRegisterCell.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <random>
+
+namespace
+{
+LogicState ToState(bool pHigh)
+{
+    return pHigh ? LogicState::HIGH : LogicState::LOW;
+}
+
+uint32_t CountHigh(const std::vector<LogicState>& pStates)
+{
+    return std::count(pStates.begin(), pStates.end(), LogicState::HIGH);
+}
+
+// Interprets pCount states starting at pFirst as a binary number, the first state being the least significant bit
+uint32_t ToValue(const std::vector<LogicState>& pStates, size_t pFirst, size_t pCount)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < pCount; i++)
+    {
+        value |= (pStates[pFirst + i] == LogicState::HIGH) ? (1u << i) : 0;
+    }
+    return value;
+}
+
+std::vector<LogicState> AndTable(const std::vector<LogicState>& pIn)
+{
+    return {ToState(CountHigh(pIn) == pIn.size())};
+}
+
+std::vector<LogicState> OrTable(const std::vector<LogicState>& pIn)
+{
+    return {ToState(CountHigh(pIn) > 0)};
+}
+
+// The XOR gate is high if exactly one input is high, not on odd parity
+std::vector<LogicState> XorTable(const std::vector<LogicState>& pIn)
+{
+    return {ToState(CountHigh(pIn) == 1)};
+}
+
+// The not gate is a buffer whose output is inverted by default
+std::vector<LogicState> BufferTable(const std::vector<LogicState>& pIn)
+{
+    return {pIn[0]};
+}
+
+std::vector<LogicState> AdderTable(const std::vector<LogicState>& pIn)
+{
+    const auto count = CountHigh(pIn);
+    return {ToState(count % 2 == 1), ToState(count >= 2)};
+}
+
+CellTruthTable MultiplexerTable(uint8_t pDigitCount)
+{
+    return [pDigitCount](const std::vector<LogicState>& pIn) -> std::vector<LogicState>
+    {
+        return {pIn[pDigitCount + ToValue(pIn, 0, pDigitCount)]};
+    };
+}
+
+CellTruthTable DemultiplexerTable(uint8_t pDigitCount)
+{
+    return [pDigitCount](const std::vector<LogicState>& pIn)
+    {
+        std::vector<LogicState> out(1u << pDigitCount, LogicState::LOW);
+        out[ToValue(pIn, 0, pDigitCount)] = pIn[pDigitCount];
+        return out;
+    };
+}
+
+CellTruthTable DecoderTable(uint8_t pInputCount)
+{
+    return [pInputCount](const std::vector<LogicState>& pIn)
+    {
+        std::vector<LogicState> out(1u << pInputCount, LogicState::LOW);
+        out[ToValue(pIn, 0, pInputCount)] = LogicState::HIGH;
+        return out;
+    };
+}
+
+// Priority encoder over the first 2^(n - 1) inputs, the last output is high if any of them is high
+CellTruthTable EncoderTable(uint8_t pOutputCount)
+{
+    return [pOutputCount](const std::vector<LogicState>& pIn)
+    {
+        int32_t value = -1;
+        for (uint32_t i = 0; i < (1u << (pOutputCount - 1)); i++)
+        {
+            if (pIn[i] == LogicState::HIGH)
+            {
+                value = i;
+            }
+        }
+
+        std::vector<LogicState> out(pOutputCount, LogicState::LOW);
+        for (uint8_t bit = 0; bit < pOutputCount - 1; bit++)
+        {
+            out[bit] = ToState(value >= 0 && ((value >> bit) & 1));
+        }
+        out[pOutputCount - 1] = ToState(value >= 0);
+        return out;
+    };
+}
+
+// Drives the inputs of the traced cell from its outputs, like the wire cells of a circuit do,
+// so that the inversions of the traced cell's inputs are applied by NotifySuccessor()
+class StimulusCell : public LogicBaseCell
+{
+public:
+    StimulusCell(uint32_t pOutputs):
+        LogicBaseCell(0, pOutputs),
+        mOutputStates(pOutputs, LogicState::LOW)
+    {}
+
+    void Drive(uint32_t pOutput, LogicState pState)
+    {
+        mOutputStates[pOutput] = pState;
+        NotifySuccessor(pOutput, pState);
+    }
+
+    LogicState GetOutputState(uint32_t pOutput) const override
+    {
+        return mOutputStates[pOutput];
+    }
+
+protected:
+    std::vector<LogicState> mOutputStates;
+};
+}
+
+LogicCellTracer::LogicCellTracer()
+{
+    mCellDefinitions = {
+        {"and_2", [](){ return std::make_shared<LogicAndGateCell>(2); }, nullptr, AndTable},
+        {"and_3", [](){ return std::make_shared<LogicAndGateCell>(3); }, nullptr, AndTable},
+        {"or_2", [](){ return std::make_shared<LogicOrGateCell>(2); }, nullptr, OrTable},
+        {"or_3", [](){ return std::make_shared<LogicOrGateCell>(3); }, nullptr, OrTable},
+        {"xor_2", [](){ return std::make_shared<LogicXorGateCell>(2); }, nullptr, XorTable},
+        {"xor_3", [](){ return std::make_shared<LogicXorGateCell>(3); }, nullptr, XorTable},
+        {"not", [](){ return std::make_shared<LogicNotGateCell>(); }, nullptr, BufferTable},
+        {"buffer", [](){ return std::make_shared<LogicBufferGateCell>(); }, nullptr, BufferTable},
+        {"input", [](){ return std::make_shared<LogicInputCell>(); },
+            [](LogicBaseCell& pCell){ static_cast<LogicInputCell&>(pCell).ToggleState(); }},
+        {"button", [](){ return std::make_shared<LogicButtonCell>(); },
+            [](LogicBaseCell& pCell){ static_cast<LogicButtonCell&>(pCell).ButtonClick(); }},
+        {"clock", [](){ return std::make_shared<LogicClockCell>(); }},
+        {"constant_low", [](){ return std::make_shared<LogicConstantCell>(LogicState::LOW); }},
+        {"constant_high", [](){ return std::make_shared<LogicConstantCell>(LogicState::HIGH); }},
+        {"output", [](){ return std::make_shared<LogicOutputCell>(); }},
+        {"half_adder", [](){ return std::make_shared<LogicHalfAdderCell>(); }, nullptr, AdderTable},
+        {"full_adder", [](){ return std::make_shared<LogicFullAdderCell>(); }, nullptr, AdderTable},
+        {"rs_flipflop", [](){ return std::make_shared<LogicRsFlipFlopCell>(); }},
+        {"rs_clocked_flipflop", [](){ return std::make_shared<LogicRsClockedFlipFlopCell>(); }},
+        {"rs_ms_flipflop", [](){ return std::make_shared<LogicRsMsFlipFlopCell>(); }},
+        {"d_flipflop", [](){ return std::make_shared<LogicDFlipFlopCell>(); }},
+        {"d_ms_flipflop", [](){ return std::make_shared<LogicDMsFlipFlopCell>(); }},
+        {"t_flipflop", [](){ return std::make_shared<LogicTFlipFlopCell>(); }},
+        {"jk_flipflop", [](){ return std::make_shared<LogicJKFlipFlopCell>(); }},
+        {"jk_ms_flipflop", [](){ return std::make_shared<LogicJkMsFlipFlopCell>(); }},
+        {"multiplexer_1", [](){ return std::make_shared<LogicMultiplexerCell>(1); }, nullptr, MultiplexerTable(1)},
+        {"multiplexer_2", [](){ return std::make_shared<LogicMultiplexerCell>(2); }, nullptr, MultiplexerTable(2)},
+        {"demultiplexer_1", [](){ return std::make_shared<LogicDemultiplexerCell>(1); }, nullptr, DemultiplexerTable(1)},
+        {"demultiplexer_2", [](){ return std::make_shared<LogicDemultiplexerCell>(2); }, nullptr, DemultiplexerTable(2)},
+        {"decoder_2", [](){ return std::make_shared<LogicDecoderCell>(2); }, nullptr, DecoderTable(2)},
+        {"decoder_3", [](){ return std::make_shared<LogicDecoderCell>(3); }, nullptr, DecoderTable(3)},
+        {"encoder_2", [](){ return std::make_shared<LogicEncoderCell>(2); }, nullptr, EncoderTable(2)},
+        {"encoder_3", [](){ return std::make_shared<LogicEncoderCell>(3); }, nullptr, EncoderTable(3)},
+        {"counter_4", [](){ return std::make_shared<LogicCounterCell>(4); }},
+        {"shift_register_4", [](){ return std::make_shared<LogicShiftRegisterCell>(4); }}
+    };
+}
+
+bool LogicCellTracer::RecordTraces(const QString& pDirectory) const
+{
+    // A build that contradicts the truth tables must not become the reference
+    if (!CheckTruthTables() || !QDir().mkpath(pDirectory))
+    {
+        return false;
+    }
+
+    for (const auto& definition : mCellDefinitions)
+    {
+        for (const auto& variant : {CellTraceVariant::PLAIN, CellTraceVariant::INVERTED_INPUTS, CellTraceVariant::INVERTED_OUTPUTS})
+        {
+            QFile traceFile(QDir(pDirectory).filePath(GetTraceFileName(definition, variant)));
+
+            if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Text))
+            {
+                return false;
+            }
+
+            QTextStream stream(&traceFile);
+            for (const auto& line : TraceCell(definition, variant))
+            {
+                stream << line << Qt::endl;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool LogicCellTracer::VerifyTraces(const QString& pDirectory) const
+{
+    QTextStream err(stderr);
+    bool allMatching = CheckTruthTables();
+    uint32_t traceCount = 0;
+
+    for (const auto& definition : mCellDefinitions)
+    {
+        for (const auto& variant : {CellTraceVariant::PLAIN, CellTraceVariant::INVERTED_INPUTS, CellTraceVariant::INVERTED_OUTPUTS})
+        {
+            const auto fileName = GetTraceFileName(definition, variant);
+            QFile traceFile(QDir(pDirectory).filePath(fileName));
+            traceCount++;
+
+            if (!traceFile.open(QIODevice::ReadOnly | QIODevice::Text))
+            {
+                err << fileName << ": golden trace missing" << Qt::endl;
+                allMatching = false;
+                continue;
+            }
+
+            const auto golden = QString(traceFile.readAll()).split('\n', Qt::SkipEmptyParts);
+            const auto actual = TraceCell(definition, variant);
+
+            for (int32_t line = 0; line < std::max(golden.size(), actual.size()); line++)
+            {
+                const auto expected = (line < golden.size()) ? golden[line] : QString("<end of trace>");
+                const auto result = (line < actual.size()) ? actual[line] : QString("<end of trace>");
+
+                if (expected != result)
+                {
+                    // Line 0 is the header, so the line number equals the tick number
+                    err << fileName << ": first divergence at tick " << line << Qt::endl
+                        << "    columns:  " << actual.front() << Qt::endl
+                        << "    expected: " << expected << Qt::endl
+                        << "    actual:   " << result << Qt::endl;
+                    allMatching = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    err << (allMatching ? "All " : "Not all ") << traceCount << " cell traces match" << Qt::endl;
+    return allMatching;
+}
+
+bool LogicCellTracer::CheckTruthTables() const
+{
+    QTextStream err(stderr);
+    bool allHolding = true;
+    uint32_t tableCount = 0;
+
+    for (const auto& definition : mCellDefinitions)
+    {
+        if (nullptr == definition.truthTable)
+        {
+            continue;
+        }
+
+        for (const auto& variant : {CellTraceVariant::PLAIN, CellTraceVariant::INVERTED_INPUTS, CellTraceVariant::INVERTED_OUTPUTS})
+        {
+            QStringList violations;
+            TraceCell(definition, variant, &violations);
+            tableCount++;
+
+            if (!violations.empty())
+            {
+                err << GetTraceFileName(definition, variant) << ": " << violations.size() << " ticks contradict the truth table, first: "
+                    << violations.front() << Qt::endl;
+                allHolding = false;
+            }
+        }
+    }
+
+    err << (allHolding ? "All " : "Not all ") << tableCount << " cell truth tables hold" << Qt::endl;
+    return allHolding;
+}
+
+QStringList LogicCellTracer::TraceCell(const CellDefinition& pDefinition, CellTraceVariant pVariant, QStringList* pViolations) const
+{
+    const auto cell = pDefinition.create();
+    Q_ASSERT(cell);
+
+    const auto stimulusCell = std::make_shared<StimulusCell>(cell->GetInputCount());
+    for (uint32_t input = 0; input < cell->GetInputCount(); input++)
+    {
+        stimulusCell->ConnectOutput(cell, input, input);
+        cell->SetConnected(input);
+
+        if (pVariant == CellTraceVariant::INVERTED_INPUTS)
+        {
+            cell->InvertInput(input);
+        }
+    }
+
+    if (pVariant == CellTraceVariant::INVERTED_OUTPUTS)
+    {
+        cell->SetOutputInversions(std::vector<bool>(cell->GetOutputCount(), true));
+    }
+
+    cell->OnWakeUp();
+
+    // Like the wire cells after waking up, the stimulus notifies every input once, so that inverted inputs start high
+    for (uint32_t input = 0; input < cell->GetInputCount(); input++)
+    {
+        stimulusCell->Drive(input, LogicState::LOW);
+    }
+
+    QStringList trace;
+
+    QStringList header{"tick"};
+    for (uint32_t input = 0; input < cell->GetInputCount(); input++)
+    {
+        header << QString("in%0").arg(input);
+    }
+    for (uint32_t output = 0; output < cell->GetOutputCount(); output++)
+    {
+        header << QString("out%0").arg(output);
+    }
+    trace << header.join(',');
+
+    // The raw generator output is used, as the distributions of the standard library differ between implementations
+    std::mt19937 random(tracing::CELL_TRACE_SEED);
+
+    for (uint32_t tick = 1; tick <= tracing::CELL_TRACE_TICKS; tick++)
+    {
+        const bool isPatternChange = (tick % tracing::CELL_TRACE_HOLD_TICKS == 0);
+
+        if (isPatternChange)
+        {
+            // Only one input changes at a time, so that edges on clock inputs are isolated. Unlike with a Gray code,
+            // where the upper bits only toggle in fixed states of the lower bits, edges meet varying states of the other inputs
+            if (cell->GetInputCount() > 0)
+            {
+                const uint32_t input = random() % cell->GetInputCount();
+                stimulusCell->Drive(input, InvertState(stimulusCell->GetOutputState(input)));
+            }
+
+            if (pDefinition.stimulate)
+            {
+                pDefinition.stimulate(*cell);
+            }
+        }
+
+        cell->OnSimulationAdvance();
+
+        QStringList row{QString::number(tick)};
+        for (uint32_t input = 0; input < cell->GetInputCount(); input++)
+        {
+            row << QString::number(static_cast<int32_t>(cell->GetInputState(input)));
+        }
+        for (uint32_t output = 0; output < cell->GetOutputCount(); output++)
+        {
+            row << QString::number(static_cast<int32_t>(cell->GetOutputState(output)));
+        }
+        trace << row.join(',');
+
+        // The outputs have settled on the last tick a pattern is held, the first pattern is skipped to not depend on the wake up
+        if (nullptr != pViolations && nullptr != pDefinition.truthTable
+                && tick >= tracing::CELL_TRACE_HOLD_TICKS && tick % tracing::CELL_TRACE_HOLD_TICKS == tracing::CELL_TRACE_HOLD_TICKS - 1)
+        {
+            std::vector<LogicState> inputs;
+            for (uint32_t input = 0; input < cell->GetInputCount(); input++)
+            {
+                inputs.push_back(cell->GetInputState(input));
+            }
+
+            const auto expected = pDefinition.truthTable(inputs);
+            Q_ASSERT(expected.size() == cell->GetOutputCount());
+
+            for (uint32_t output = 0; output < cell->GetOutputCount(); output++)
+            {
+                const auto expectedState = cell->IsOutputInverted(output) ? InvertState(expected[output]) : expected[output];
+
+                if (cell->GetOutputState(output) != expectedState)
+                {
+                    *pViolations << QString("tick %0, out%1 is %2 instead of %3").arg(tick).arg(output)
+                                    .arg(static_cast<int32_t>(cell->GetOutputState(output))).arg(static_cast<int32_t>(expectedState));
+                }
+            }
+        }
+    }
+
+    cell->OnShutdown();
+
+    return trace;
+}
+
+QString LogicCellTracer::GetTraceFileName(const CellDefinition& pDefinition, CellTraceVariant pVariant) const
+{
+    switch (pVariant)
+    {
+        case CellTraceVariant::PLAIN:
+        {
+            return pDefinition.name + tracing::CELL_TRACE_FILE_EXTENSION;
+        }
+        case CellTraceVariant::INVERTED_INPUTS:
+        {
+            return pDefinition.name + "_inverted_inputs" + tracing::CELL_TRACE_FILE_EXTENSION;
+        }
+        case CellTraceVariant::INVERTED_OUTPUTS:
+        {
+            return pDefinition.name + "_inverted_outputs" + tracing::CELL_TRACE_FILE_EXTENSION;
+        }
+        default:
+        {
+            throw std::logic_error("Cell trace variant invalid");
+        }
+    }
+}
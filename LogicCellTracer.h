@@ -0,0 +1,78 @@
+#ifndef LOGICCELLTRACER_H
+#define LOGICCELLTRACER_H
+
+#include "Components/LogicBaseCell.h"
+
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+/// \brief CellTraceVariant contains the inversion setups every logic cell is traced with
+enum class CellTraceVariant
+{
+    PLAIN = 0,
+    INVERTED_INPUTS,
+    INVERTED_OUTPUTS
+};
+
+/// \brief CellTruthTable maps the input states of a combinational cell, with input inversions applied,
+/// to its output states before output inversion
+using CellTruthTable = std::function<std::vector<LogicState>(const std::vector<LogicState>&)>;
+
+///
+/// \brief The LogicCellTracer class drives every logic cell type of the components with a deterministic stimulus
+/// and records the in- and output states tick by tick, to catch behaviour changes against golden traces
+/// Wire and diode cells are not traced, as they depend on the core logic
+///
+class LogicCellTracer
+{
+public:
+    /// \brief Constructor for the LogicCellTracer
+    LogicCellTracer(void);
+
+    /// \brief Traces all cells and writes one golden trace file per cell and variant into the given directory
+    /// \param pDirectory: The directory to write the traces to, it is created if it does not exist
+    /// \return False, if a trace could not be written
+    bool RecordTraces(const QString& pDirectory) const;
+
+    /// \brief Traces all cells, checks the combinational cells against their truth tables
+    /// and compares the result against the golden traces in the given directory
+    /// The first divergence of every cell is reported on stderr
+    /// \param pDirectory: The directory containing the golden traces
+    /// \return True, if all truth tables hold and all traces match
+    bool VerifyTraces(const QString& pDirectory) const;
+
+protected:
+    /// \brief CellDefinition describes how to create a logic cell, how to stimulate cells without inputs
+    /// and, for combinational cells, the truth table the settled outputs must match
+    struct CellDefinition
+    {
+        QString name;
+        std::function<std::shared_ptr<LogicBaseCell>(void)> create;
+        std::function<void(LogicBaseCell&)> stimulate = nullptr;
+        CellTruthTable truthTable = nullptr;
+    };
+
+    /// \brief Traces the given cell definition in the given variant
+    /// \param pDefinition: The cell definition to trace
+    /// \param pVariant: The inversion variant
+    /// \param pViolations: If not null, every settled tick that contradicts the truth table of the cell is appended
+    /// \return The trace, one CSV line per tick with a header line first
+    QStringList TraceCell(const CellDefinition& pDefinition, CellTraceVariant pVariant, QStringList* pViolations = nullptr) const;
+
+    /// \brief Traces all cells with a truth table and reports the contradicting ticks on stderr
+    /// The truth tables are independent of any recorded trace, so they also catch a faulty build recording the golden traces
+    /// \return True, if all truth tables hold
+    bool CheckTruthTables(void) const;
+
+    /// \brief Returns the file name of the trace of the given cell definition and variant
+    /// \param pDefinition: The cell definition
+    /// \param pVariant: The inversion variant
+    /// \return The file name of the trace
+    QString GetTraceFileName(const CellDefinition& pDefinition, CellTraceVariant pVariant) const;
+
+protected:
+    std::vector<CellDefinition> mCellDefinitions;
+};
+
+#endif // LOGICCELLTRACER_H
@@ -0,0 +1,283 @@
+#include "NetlistCache.h"
+#include "Configuration.h"
+
+#include <QCborMap>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+
+NetlistCache::NetlistCache()
+{}
+
+bool NetlistCache::HasComponents(uint64_t pGeneration) const
+{
+    return (mGeneration.has_value() && mGeneration.value() == pGeneration);
+}
+
+void NetlistCache::SetComponents(const std::vector<IBaseComponent*>& pComponents, uint64_t pGeneration)
+{
+    // The canonical order is the order of the encoded component data, which is the same on every load
+    std::vector<std::pair<QByteArray, IBaseComponent*>> encodedComponents;
+    encodedComponents.reserve(pComponents.size());
+
+    for (const auto& comp : pComponents)
+    {
+        encodedComponents.emplace_back(QCborMap::fromJsonObject(comp->GetJson()).toCborValue().toCbor(), comp);
+    }
+
+    std::sort(encodedComponents.begin(), encodedComponents.end(), [](const auto& pA, const auto& pB)
+    {
+        return pA.first < pB.first;
+    });
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray(FULL_VERSION)); // Connection rules may change between versions
+    hash.addData(QByteArray::number(file::NETLIST_VERSION));
+
+    mComponents.clear();
+    mComponents.reserve(encodedComponents.size());
+    mComponentIndices.clear();
+    mComponentIndices.reserve(encodedComponents.size());
+
+    for (const auto& [data, comp] : encodedComponents)
+    {
+        hash.addData(QByteArray::number(data.size()));
+        hash.addData(data);
+
+        mComponentIndices[comp] = mComponents.size();
+        mComponents.push_back(comp);
+    }
+
+    mHash = hash.result();
+    mGeneration = pGeneration;
+}
+
+bool NetlistCache::Restore(const std::optional<QFileInfo>& pCircuitFile)
+{
+    if (mNetlistHash.has_value() && mNetlistHash.value() == mHash)
+    {
+        return true;
+    }
+
+    if (!pCircuitFile.has_value() || !ReadSidecar(GetSidecarPath(pCircuitFile.value())))
+    {
+        return false;
+    }
+
+    if (!IsNetlistValid())
+    {
+        qDebug() << "Netlist cache corrupted, parsing the circuit";
+        mNetlistHash.reset();
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<std::vector<IBaseComponent*>> NetlistCache::GetWireGroups() const
+{
+    std::vector<std::vector<IBaseComponent*>> wireGroups;
+    wireGroups.reserve(mWireGroups.size());
+
+    for (const auto& group : mWireGroups)
+    {
+        auto& components = wireGroups.emplace_back();
+        components.reserve(group.size());
+
+        for (const auto& index : group)
+        {
+            components.push_back(mComponents[index]);
+        }
+    }
+
+    return wireGroups;
+}
+
+const std::vector<NetlistBinding>& NetlistCache::GetBindings() const
+{
+    return mBindings;
+}
+
+IBaseComponent* NetlistCache::GetComponent(uint32_t pIndex) const
+{
+    Q_ASSERT(pIndex < mComponents.size());
+    return mComponents[pIndex];
+}
+
+void NetlistCache::BeginRecording(const std::vector<std::vector<IBaseComponent*>>& pWireGroups)
+{
+    mNetlistHash.reset();
+    mBindings.clear();
+    mWireGroups.clear();
+    mWireGroups.reserve(pWireGroups.size());
+
+    for (const auto& group : pWireGroups)
+    {
+        auto& indices = mWireGroups.emplace_back();
+        indices.reserve(group.size());
+
+        for (const auto& comp : group)
+        {
+            indices.push_back(mComponentIndices.at(comp));
+        }
+    }
+}
+
+void NetlistCache::RecordBinding(uint32_t pGroup, IBaseComponent* pComponent, uint32_t pPin, bool pIsOutput)
+{
+    mBindings.push_back(NetlistBinding{pGroup, mComponentIndices.at(pComponent), pPin, pIsOutput});
+}
+
+void NetlistCache::FinishRecording(const std::optional<QFileInfo>& pCircuitFile)
+{
+    mNetlistHash = mHash;
+
+    if (pCircuitFile.has_value() && !WriteSidecar(GetSidecarPath(pCircuitFile.value())))
+    {
+        qDebug() << "Could not write netlist cache";
+    }
+}
+
+QString NetlistCache::GetSidecarPath(const QFileInfo& pCircuitFile)
+{
+    return pCircuitFile.absoluteFilePath() + file::NETLIST_FILE_SUFFIX;
+}
+
+bool NetlistCache::ReadSidecar(const QString& pPath)
+{
+    QFile sidecar(pPath);
+
+    if (!sidecar.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&sidecar);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    QByteArray magic(4, '\0');
+    quint32 version = 0;
+    QByteArray hash;
+
+    if (stream.readRawData(magic.data(), magic.size()) != magic.size() || magic != file::NETLIST_MAGIC)
+    {
+        return false;
+    }
+
+    stream >> version >> hash;
+
+    if (stream.status() != QDataStream::Ok || version != file::NETLIST_VERSION || hash != mHash)
+    {
+        return false; // Stale sidecar, the circuit has changed since the netlist has been written
+    }
+
+    quint32 groupCount = 0;
+    stream >> groupCount;
+
+    std::vector<std::vector<uint32_t>> wireGroups;
+
+    for (quint32 i = 0; i < groupCount && stream.status() == QDataStream::Ok; i++)
+    {
+        quint32 groupSize = 0;
+        stream >> groupSize;
+
+        auto& group = wireGroups.emplace_back();
+        for (quint32 k = 0; k < groupSize && stream.status() == QDataStream::Ok; k++)
+        {
+            quint32 index = 0;
+            stream >> index;
+            group.push_back(index);
+        }
+    }
+
+    quint32 bindingCount = 0;
+    stream >> bindingCount;
+
+    std::vector<NetlistBinding> bindings;
+
+    for (quint32 i = 0; i < bindingCount && stream.status() == QDataStream::Ok; i++)
+    {
+        NetlistBinding binding;
+        stream >> binding.group >> binding.component >> binding.pin >> binding.isOutput;
+        bindings.push_back(binding);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    mNetlistHash = hash;
+    mWireGroups = std::move(wireGroups);
+    mBindings = std::move(bindings);
+    return true;
+}
+
+bool NetlistCache::WriteSidecar(const QString& pPath) const
+{
+    QSaveFile sidecar(pPath);
+
+    if (!sidecar.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&sidecar);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream.writeRawData(file::NETLIST_MAGIC, 4);
+    stream << static_cast<quint32>(file::NETLIST_VERSION) << mHash;
+
+    stream << static_cast<quint32>(mWireGroups.size());
+    for (const auto& group : mWireGroups)
+    {
+        stream << static_cast<quint32>(group.size());
+        for (const auto& index : group)
+        {
+            stream << static_cast<quint32>(index);
+        }
+    }
+
+    stream << static_cast<quint32>(mBindings.size());
+    for (const auto& binding : mBindings)
+    {
+        stream << binding.group << binding.component << binding.pin << binding.isOutput;
+    }
+
+    return (stream.status() == QDataStream::Ok) && sidecar.commit();
+}
+
+bool NetlistCache::IsNetlistValid() const
+{
+    for (const auto& group : mWireGroups)
+    {
+        for (const auto& index : group)
+        {
+            if (index >= mComponents.size())
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const auto& binding : mBindings)
+    {
+        if (binding.group >= mWireGroups.size() || binding.component >= mComponents.size())
+        {
+            return false;
+        }
+
+        const auto& comp = mComponents[binding.component];
+        const auto pinCount = (binding.isOutput ? comp->GetOutConnectorCount() : comp->GetInConnectorCount());
+
+        if (binding.pin >= pinCount || nullptr == comp->GetLogicCell())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
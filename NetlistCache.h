@@ -0,0 +1,111 @@
+#ifndef NETLISTCACHE_H
+#define NETLISTCACHE_H
+
+#include "Components/IBaseComponent.h"
+
+#include <QByteArray>
+#include <QFileInfo>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/// \brief NetlistBinding contains a connection between a component connector and a wire group
+struct NetlistBinding
+{
+    uint32_t group;     // Index of the wire group
+    uint32_t component; // Index of the component in canonical order
+    uint32_t pin;       // Index of the input or output connector
+    bool isOutput;      // True, if the component drives the wire group
+};
+
+///
+/// \brief The NetlistCache class stores the connectivity that is extracted from the scene when entering the simulation.
+/// The netlist is keyed by a hash over the data of all components and kept in memory and in a sidecar file next to the circuit,
+/// so that the simulation of an unchanged circuit can be set up without parsing wire groups and connections again.
+///
+/// Components are referenced by their index in a canonical order, which only depends on their data and not on the scene.
+/// Bindings are stored in the order they have been made, because it determines the slot order of the wire logic cells.
+///
+class NetlistCache
+{
+public:
+    /// \brief Constructor for the NetlistCache
+    NetlistCache(void);
+
+    /// \brief Returns true, if the components have been set for the given circuit generation and need not be hashed again
+    /// \param pGeneration: The current generation of the circuit, which changes with every edit
+    /// \return True, if the canonical order and the content hash are up to date
+    bool HasComponents(uint64_t pGeneration) const;
+
+    /// \brief Brings the given components into canonical order and computes the content hash over their data
+    /// \param pComponents: All components of the circuit
+    /// \param pGeneration: The current generation of the circuit
+    void SetComponents(const std::vector<IBaseComponent*>& pComponents, uint64_t pGeneration);
+
+    /// \brief Makes the netlist of the current components available, the sidecar file is only read if the netlist in memory doesn't match
+    /// \param pCircuitFile: The circuit file, or nothing for untitled circuits
+    /// \return True, if a valid netlist with a matching hash has been found
+    bool Restore(const std::optional<QFileInfo>& pCircuitFile);
+
+    /// \brief Getter for the wire groups of the restored netlist
+    /// \return The wire groups, containing wires and full ConPoints
+    std::vector<std::vector<IBaseComponent*>> GetWireGroups(void) const;
+
+    /// \brief Getter for the bindings of the restored netlist
+    /// \return The bindings in the order they have been made
+    const std::vector<NetlistBinding>& GetBindings(void) const;
+
+    /// \brief Returns the component with the given canonical index
+    /// \param pIndex: The canonical index of the component
+    /// \return The component
+    IBaseComponent* GetComponent(uint32_t pIndex) const;
+
+    /// \brief Starts recording a new netlist for the current components
+    /// \param pWireGroups: The parsed wire groups
+    void BeginRecording(const std::vector<std::vector<IBaseComponent*>>& pWireGroups);
+
+    /// \brief Appends a binding to the recorded netlist
+    /// \param pGroup: Index of the wire group
+    /// \param pComponent: The connected component
+    /// \param pPin: Index of the input or output connector
+    /// \param pIsOutput: True, if the component drives the wire group
+    void RecordBinding(uint32_t pGroup, IBaseComponent* pComponent, uint32_t pPin, bool pIsOutput);
+
+    /// \brief Finishes the recorded netlist and writes it to the sidecar file of the circuit
+    /// \param pCircuitFile: The circuit file, or nothing for untitled circuits
+    void FinishRecording(const std::optional<QFileInfo>& pCircuitFile);
+
+    /// \brief Returns the path of the sidecar file of the given circuit file
+    /// \param pCircuitFile: The circuit file
+    /// \return The path of the sidecar file
+    static QString GetSidecarPath(const QFileInfo& pCircuitFile);
+
+protected:
+    /// \brief Reads the netlist from the given sidecar file
+    /// \param pPath: The path of the sidecar file
+    /// \return False, if the file could not be read or belongs to other components
+    bool ReadSidecar(const QString& pPath);
+
+    /// \brief Writes the netlist to the given sidecar file
+    /// \param pPath: The path of the sidecar file
+    /// \return False, if the file could not be written
+    bool WriteSidecar(const QString& pPath) const;
+
+    /// \brief Checks that all indices of the netlist refer to existing components and connectors
+    /// \return True, if the netlist can be applied to the current components
+    bool IsNetlistValid(void) const;
+
+protected:
+    // The current components in canonical order
+    std::vector<IBaseComponent*> mComponents;
+    std::unordered_map<IBaseComponent*, uint32_t> mComponentIndices;
+    QByteArray mHash;
+    std::optional<uint64_t> mGeneration;
+
+    // The compiled netlist, kept in memory between simulation runs
+    std::optional<QByteArray> mNetlistHash;
+    std::vector<std::vector<uint32_t>> mWireGroups;
+    std::vector<NetlistBinding> mBindings;
+};
+
+#endif // NETLISTCACHE_H
@@ -0,0 +1,1492 @@
+#include "NetlistImporter.h"
+#include "CoreLogic.h"
+#include "Configuration.h"
+#include "HelperFunctions.h"
+
+#include "Components/Gates/AndGate.h"
+#include "Components/Gates/OrGate.h"
+#include "Components/Gates/XorGate.h"
+#include "Components/Gates/NotGate.h"
+#include "Components/Gates/BufferGate.h"
+#include "Components/Inputs/LogicInput.h"
+#include "Components/Inputs/LogicClock.h"
+#include "Components/Inputs/LogicConstant.h"
+#include "Components/Inputs/LogicCells/LogicClockCell.h"
+#include "Components/Outputs/LogicOutput.h"
+#include "Components/ComplexLogic/DFlipFlop.h"
+#include "Components/LogicWire.h"
+#include "Components/ConPoint.h"
+
+#include <QFile>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+
+namespace
+{
+bool IsCombinational(NetlistCellType pType)
+{
+    return (pType == NetlistCellType::AND_GATE || pType == NetlistCellType::OR_GATE || pType == NetlistCellType::XOR_GATE
+            || pType == NetlistCellType::NOT_GATE || pType == NetlistCellType::BUFFER_GATE);
+}
+
+bool IsSource(NetlistCellType pType)
+{
+    return (pType == NetlistCellType::INPUT || pType == NetlistCellType::CONSTANT || pType == NetlistCellType::CLOCK);
+}
+
+/// \brief Assigns tracks to intervals with the left-edge algorithm, an interval may only reuse a track that ends before it starts
+/// \param pIntervals: Start and end of every interval
+/// \param pTracks: The assigned track of every interval
+/// \return The amount of tracks used
+template<typename T>
+uint32_t AssignTracks(const std::vector<std::pair<T, T>>& pIntervals, std::vector<uint32_t>& pTracks)
+{
+    std::vector<uint32_t> order(pIntervals.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t pA, uint32_t pB)
+    {
+        return pIntervals[pA].first < pIntervals[pB].first;
+    });
+
+    // Tracks ordered by the end of their last interval
+    std::priority_queue<std::pair<T, uint32_t>, std::vector<std::pair<T, uint32_t>>, std::greater<std::pair<T, uint32_t>>> trackEnds;
+    uint32_t trackCount = 0;
+
+    pTracks.resize(pIntervals.size());
+
+    for (const auto& index : order)
+    {
+        if (!trackEnds.empty() && trackEnds.top().first < pIntervals[index].first)
+        {
+            pTracks[index] = trackEnds.top().second;
+            trackEnds.pop();
+        }
+        else
+        {
+            pTracks[index] = trackCount++;
+        }
+
+        trackEnds.emplace(pIntervals[index].second, pTracks[index]);
+    }
+
+    return trackCount;
+}
+}
+
+NetlistImporter::NetlistImporter(const CoreLogic* pCoreLogic):
+    mCoreLogic(pCoreLogic)
+{
+    Q_ASSERT(mCoreLogic);
+}
+
+NetlistImporter::~NetlistImporter() = default;
+
+bool NetlistImporter::Read(const QFileInfo& pFileInfo)
+{
+    QFile file(pFileInfo.absoluteFilePath());
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return SetError(0, QString("The file could not be opened."));
+    }
+
+    const auto text = QString::fromUtf8(file.readAll());
+    const auto suffix = pFileInfo.suffix().toLower();
+
+    bool isRead = false;
+
+    if (suffix == netlist_import::BLIF_SUFFIX)
+    {
+        isRead = ReadBlif(text);
+    }
+    else if (suffix == netlist_import::VERILOG_SUFFIX)
+    {
+        isRead = ReadVerilog(text);
+    }
+    else
+    {
+        return SetError(0, QString("Unknown netlist format .%0, expected .%1 or .%2.").arg(suffix, netlist_import::BLIF_SUFFIX, netlist_import::VERILOG_SUFFIX));
+    }
+
+    return isRead && FinishNetlist();
+}
+
+const QString& NetlistImporter::GetError() const
+{
+    return mError;
+}
+
+const QStringList& NetlistImporter::GetUndrivenNets() const
+{
+    return mUndrivenNets;
+}
+
+bool NetlistImporter::ReadBlif(const QString& pText)
+{
+    struct Cover
+    {
+        std::vector<uint32_t> inputs;
+        uint32_t output;
+        QStringList cubes;
+        std::optional<bool> isOnSet;
+    };
+
+    std::optional<Cover> cover;
+    QSet<QString> inputNames;
+    bool isModelRead = false;
+
+    const auto finishCover = [&]()
+    {
+        if (cover.has_value())
+        {
+            AddCover(cover->inputs, cover->output, cover->cubes, cover->isOnSet.value_or(true));
+            cover.reset();
+        }
+    };
+
+    const auto lines = pText.split('\n');
+    QString logicalLine;
+
+    for (int32_t lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+    {
+        auto line = lines[lineIndex];
+        line.truncate(line.indexOf('#') >= 0 ? line.indexOf('#') : line.size());
+        line = line.trimmed();
+
+        if (line.endsWith('\\')) // Continued in the next line
+        {
+            logicalLine += line.chopped(1) + ' ';
+            continue;
+        }
+
+        logicalLine += line;
+        const auto tokens = logicalLine.simplified().split(' ', Qt::SkipEmptyParts);
+        logicalLine.clear();
+
+        const int32_t lineNumber = lineIndex + 1;
+
+        if (tokens.isEmpty())
+        {
+            continue;
+        }
+
+        const auto& keyword = tokens[0];
+
+        if (!keyword.startsWith('.'))
+        {
+            if (!cover.has_value())
+            {
+                return SetError(lineNumber, QString("Cover line outside of a .names block."));
+            }
+
+            const auto inputCount = cover->inputs.size();
+            const auto cube = (inputCount == 0 ? QString() : tokens[0]);
+            const auto value = tokens.back();
+
+            if (tokens.size() != (inputCount == 0 ? 1 : 2) || cube.size() != static_cast<qsizetype>(inputCount)
+                    || (value != "0" && value != "1")
+                    || std::any_of(cube.cbegin(), cube.cend(), [](QChar pChar){ return pChar != '0' && pChar != '1' && pChar != '-'; }))
+            {
+                return SetError(lineNumber, QString("Invalid cover line."));
+            }
+
+            if (cover->isOnSet.has_value() && cover->isOnSet.value() != (value == "1"))
+            {
+                return SetError(lineNumber, QString("Covers with both on-set and off-set lines are not supported."));
+            }
+
+            cover->isOnSet = (value == "1");
+            cover->cubes.append(cube);
+        }
+        else if (keyword == ".model")
+        {
+            if (isModelRead)
+            {
+                break; // Only the first model is imported
+            }
+            isModelRead = true;
+        }
+        else if (keyword == ".inputs" || keyword == ".clock")
+        {
+            for (qsizetype i = 1; i < tokens.size(); i++)
+            {
+                if (!inputNames.contains(tokens[i]))
+                {
+                    inputNames.insert(tokens[i]);
+                    AddSource(NetlistCellType::INPUT, GetNet(tokens[i]));
+                }
+            }
+        }
+        else if (keyword == ".outputs")
+        {
+            mOutputNames.append(tokens.mid(1));
+        }
+        else if (keyword == ".names")
+        {
+            finishCover();
+
+            if (tokens.size() < 2)
+            {
+                return SetError(lineNumber, QString(".names without output."));
+            }
+
+            Cover names;
+            for (qsizetype i = 1; i < tokens.size() - 1; i++)
+            {
+                names.inputs.push_back(GetNet(tokens[i]));
+            }
+            names.output = GetNet(tokens.back());
+            cover = names;
+        }
+        else if (keyword == ".latch")
+        {
+            finishCover();
+
+            if (tokens.size() < 3)
+            {
+                return SetError(lineNumber, QString(".latch needs an input and an output."));
+            }
+
+            std::optional<uint32_t> clock;
+            bool isClockInverted = false;
+
+            if (tokens.size() >= 5 && tokens[4] != "NIL")
+            {
+                clock = GetNet(tokens[4]);
+                isClockInverted = (tokens[3] == "fe" || tokens[3] == "al"); // Level-sensitive latches are approximated by flip-flops
+            }
+            else if (!mImplicitClockNet.has_value())
+            {
+                mImplicitClockNet = CreateNet();
+                AddSource(NetlistCellType::CLOCK, mImplicitClockNet.value());
+            }
+
+            Cell flipFlop{NetlistCellType::D_FLIPFLOP, {GetNet(tokens[1]), clock.value_or(mImplicitClockNet.value_or(0))}, {false, isClockInverted}, GetNet(tokens[2])};
+            mCells.push_back(flipFlop);
+        }
+        else if (keyword == ".end")
+        {
+            break;
+        }
+        else if (keyword == ".subckt" || keyword == ".gate" || keyword == ".mlatch" || keyword == ".search" || keyword == ".exdc" || keyword == ".start_kiss")
+        {
+            return SetError(lineNumber, QString("%0 is not supported, only flat netlists can be imported.").arg(keyword));
+        }
+        else
+        {
+            finishCover(); // Timing and other annotations don't affect the logic
+        }
+    }
+
+    finishCover();
+    return true;
+}
+
+bool NetlistImporter::ReadVerilog(const QString& pText)
+{
+    struct Token
+    {
+        QString text;
+        int32_t line;
+    };
+
+    // Tokenize; bit selects are part of the name, so that every bit is a separate net
+    std::vector<Token> tokens;
+    int32_t line = 1;
+
+    for (qsizetype i = 0; i < pText.size();)
+    {
+        const QChar c = pText[i];
+        const QChar next = (i + 1 < pText.size() ? pText[i + 1] : QChar());
+
+        if (c == '\n')
+        {
+            line++;
+            i++;
+        }
+        else if (c.isSpace())
+        {
+            i++;
+        }
+        else if ((c == '/' && next == '/') || c == '`') // Comments and compiler directives end with the line
+        {
+            while (i < pText.size() && pText[i] != '\n')
+            {
+                i++;
+            }
+        }
+        else if (c == '/' && next == '*')
+        {
+            const auto end = pText.indexOf("*/", i + 2);
+            const auto commentEnd = (end < 0 ? pText.size() : end + 2);
+            line += pText.mid(i, commentEnd - i).count('\n');
+            i = commentEnd;
+        }
+        else if (c == '\\') // Escaped identifier, terminated by white space
+        {
+            const auto start = ++i;
+            while (i < pText.size() && !pText[i].isSpace())
+            {
+                i++;
+            }
+            tokens.push_back(Token{pText.mid(start, i - start), line});
+        }
+        else if (c.isLetterOrNumber() || c == '_' || c == '$' || c == '\'')
+        {
+            const auto start = i;
+            while (i < pText.size() && (pText[i].isLetterOrNumber() || pText[i] == '_' || pText[i] == '$' || pText[i] == '\''))
+            {
+                i++;
+            }
+
+            auto name = pText.mid(start, i - start);
+
+            auto select = i;
+            while (select < pText.size() && pText[select] == ' ')
+            {
+                select++;
+            }
+
+            if (select < pText.size() && pText[select] == '[')
+            {
+                const auto close = pText.indexOf(']', select);
+                bool isIndex = false;
+                const auto index = (close > 0 ? pText.mid(select + 1, close - select - 1).trimmed().toUInt(&isIndex) : 0);
+
+                if (isIndex)
+                {
+                    name += QString("[%0]").arg(index);
+                    i = close + 1;
+                }
+            }
+
+            tokens.push_back(Token{name, line});
+        }
+        else
+        {
+            tokens.push_back(Token{QString(c), line});
+            i++;
+        }
+    }
+
+    QSet<QString> inputNames;
+    std::optional<uint32_t> constantNets[2];
+
+    // Returns the net of a terminal, constants are driven by a shared constant per state
+    const auto getTerminal = [&](const Token& pToken) -> std::optional<uint32_t>
+    {
+        const auto text = pToken.text.toLower();
+
+        if (text == "1'b0" || text == "1'b1" || text == "1'h0" || text == "1'h1" || text == "1'd0" || text == "1'd1")
+        {
+            const bool isHigh = text.endsWith('1');
+            if (!constantNets[isHigh].has_value())
+            {
+                constantNets[isHigh] = CreateNet();
+                AddSource(NetlistCellType::CONSTANT, constantNets[isHigh].value(), isHigh ? LogicState::HIGH : LogicState::LOW);
+            }
+            return constantNets[isHigh];
+        }
+
+        if (pToken.text.isEmpty() || pToken.text[0].isDigit() || (pToken.text.size() == 1 && !pToken.text[0].isLetter() && pToken.text[0] != '_'))
+        {
+            return std::nullopt; // Punctuation or a number
+        }
+
+        return GetNet(pToken.text);
+    };
+
+    // Declares the ports of an input or output declaration, beginning at the direction keyword
+    const auto declarePorts = [&](const std::vector<Token>& pStatement, size_t pBegin, size_t pEnd) -> bool
+    {
+        bool isInput = true;
+        std::optional<std::pair<int32_t, int32_t>> range;
+
+        for (size_t i = pBegin; i < pEnd; i++)
+        {
+            const auto& text = pStatement[i].text;
+
+            if (text == "input" || text == "output")
+            {
+                isInput = (text == "input");
+                range.reset();
+            }
+            else if (text == "inout")
+            {
+                return SetError(pStatement[i].line, QString("Bidirectional ports are not supported."));
+            }
+            else if (text == "wire" || text == "reg" || text == ",")
+            {
+                continue;
+            }
+            else if (text == "[")
+            {
+                if (i + 4 >= pEnd || pStatement[i + 2].text != ":" || pStatement[i + 4].text != "]")
+                {
+                    return SetError(pStatement[i].line, QString("Invalid range."));
+                }
+                range = std::make_pair(pStatement[i + 1].text.toInt(), pStatement[i + 3].text.toInt());
+                i += 4;
+            }
+            else if (text == ")" || text == "(")
+            {
+                continue;
+            }
+            else
+            {
+                QStringList names;
+                if (range.has_value())
+                {
+                    const auto step = (range->first >= range->second ? -1 : 1);
+                    for (int32_t bit = range->first; bit != range->second + step; bit += step)
+                    {
+                        names.append(QString("%0[%1]").arg(text).arg(bit));
+                    }
+                }
+                else
+                {
+                    names.append(text);
+                }
+
+                for (const auto& name : names)
+                {
+                    if (!isInput)
+                    {
+                        mOutputNames.append(name);
+                    }
+                    else if (!inputNames.contains(name))
+                    {
+                        inputNames.insert(name);
+                        AddSource(NetlistCellType::INPUT, GetNet(name));
+                    }
+                }
+            }
+        }
+
+        return true;
+    };
+
+    size_t begin = 0;
+    while (begin < tokens.size())
+    {
+        if (tokens[begin].text == "endmodule")
+        {
+            break; // Only the first module is imported
+        }
+
+        size_t end = begin;
+        while (end < tokens.size() && tokens[end].text != ";")
+        {
+            end++;
+        }
+
+        if (end == tokens.size())
+        {
+            return SetError(tokens[begin].line, QString("Missing semicolon."));
+        }
+
+        const std::vector<Token> statement(tokens.begin() + begin, tokens.begin() + end);
+        begin = end + 1;
+
+        if (statement.empty())
+        {
+            continue; // Empty statement, e.g. a stray semicolon after an instance
+        }
+
+        const auto keyword = statement[0].text;
+        const auto lowerKeyword = keyword.toLower();
+
+        if (keyword == "module")
+        {
+            // Directions of ANSI-style ports are declared in the header, plain port lists are declared by the following statements
+            const auto direction = std::find_if(statement.begin(), statement.end(), [](const Token& pToken)
+            {
+                return pToken.text == "input" || pToken.text == "output" || pToken.text == "inout";
+            });
+
+            if (!declarePorts(statement, direction - statement.begin(), statement.size()))
+            {
+                return false;
+            }
+        }
+        else if (keyword == "input" || keyword == "output")
+        {
+            if (!declarePorts(statement, 0, statement.size()))
+            {
+                return false;
+            }
+        }
+        else if (keyword == "wire" || keyword == "reg")
+        {
+            continue; // Nets are created when they are used
+        }
+        else if (keyword == "assign")
+        {
+            // assign a = b, c = ~d, e = 1'b0
+            size_t i = 1;
+            while (i < statement.size())
+            {
+                const bool isInverted = (i + 2 < statement.size() && statement[i + 2].text == "~");
+                const auto rhsIndex = i + (isInverted ? 3 : 2);
+
+                if (rhsIndex >= statement.size() || statement[i + 1].text != "=")
+                {
+                    return SetError(statement[0].line, QString("Only assignments of nets, inverted nets and constants are supported."));
+                }
+
+                const auto lhs = getTerminal(statement[i]);
+                const auto rhs = getTerminal(statement[rhsIndex]);
+
+                if (!lhs.has_value() || !rhs.has_value() || (rhsIndex + 1 < statement.size() && statement[rhsIndex + 1].text != ","))
+                {
+                    return SetError(statement[0].line, QString("Only assignments of nets, inverted nets and constants are supported."));
+                }
+
+                if (isInverted)
+                {
+                    AddGate(NetlistCellType::NOT_GATE, {rhs.value()}, {false}, lhs.value(), false);
+                }
+                else
+                {
+                    // The nets are joined, so that no buffer delays the assigned signal
+                    const auto a = FindNet(lhs.value());
+                    const auto b = FindNet(rhs.value());
+                    if (a != b)
+                    {
+                        mNetParents[a] = b;
+                    }
+                }
+
+                i = rhsIndex + 2;
+            }
+        }
+        else if (lowerKeyword == "and" || lowerKeyword == "or" || lowerKeyword == "xor" || lowerKeyword == "nand" || lowerKeyword == "nor"
+                 || lowerKeyword == "xnor" || lowerKeyword == "not" || lowerKeyword == "buf" || lowerKeyword == "dff")
+        {
+            size_t i = 1;
+
+            if (i < statement.size() && statement[i].text == "#") // Delays are ignored, every gate has the simulation's gate delay
+            {
+                i++;
+                if (i < statement.size() && statement[i].text == "(")
+                {
+                    while (i < statement.size() && statement[i].text != ")")
+                    {
+                        i++;
+                    }
+                }
+                i++;
+            }
+
+            while (i < statement.size())
+            {
+                if (statement[i].text != "(") // Optional instance name
+                {
+                    i++;
+                }
+
+                if (i >= statement.size() || statement[i].text != "(")
+                {
+                    return SetError(statement[0].line, QString("Invalid %0 instance.").arg(keyword));
+                }
+
+                // Terminals are either positional or named, like .D(d)
+                std::vector<std::optional<uint32_t>> terminals;
+                std::map<QString, uint32_t> namedTerminals;
+                i++;
+
+                while (i < statement.size() && statement[i].text != ")")
+                {
+                    if (statement[i].text == ",")
+                    {
+                        i++;
+                    }
+                    else if (statement[i].text == "." && i + 4 < statement.size() && statement[i + 2].text == "(" && statement[i + 4].text == ")")
+                    {
+                        const auto net = getTerminal(statement[i + 3]);
+                        if (!net.has_value())
+                        {
+                            return SetError(statement[i].line, QString("Invalid terminal %0.").arg(statement[i + 3].text));
+                        }
+                        namedTerminals[statement[i + 1].text.toUpper()] = net.value();
+                        i += 5;
+                    }
+                    else
+                    {
+                        terminals.push_back(getTerminal(statement[i]));
+                        if (!terminals.back().has_value())
+                        {
+                            return SetError(statement[i].line, QString("Invalid terminal %0.").arg(statement[i].text));
+                        }
+                        i++;
+                    }
+                }
+
+                i++; // Closing parenthesis
+
+                if (lowerKeyword == "dff")
+                {
+                    // Positional terminals are (Q, D, CLK), like the output-first order of primitive gates
+                    const auto findNamed = [&](const QStringList& pNames) -> std::optional<uint32_t>
+                    {
+                        for (const auto& name : pNames)
+                        {
+                            if (namedTerminals.count(name) > 0)
+                            {
+                                return namedTerminals[name];
+                            }
+                        }
+                        return std::nullopt;
+                    };
+
+                    auto q = (terminals.size() == 3 ? terminals[0] : findNamed({"Q"}));
+                    auto d = (terminals.size() == 3 ? terminals[1] : findNamed({"D"}));
+                    auto clock = (terminals.size() == 3 ? terminals[2] : findNamed({"CLK", "CK", "C", "CLOCK"}));
+
+                    if (!q.has_value() || !d.has_value() || !clock.has_value())
+                    {
+                        return SetError(statement[0].line, QString("A dff needs the terminals Q, D and CLK."));
+                    }
+
+                    mCells.push_back(Cell{NetlistCellType::D_FLIPFLOP, {d.value(), clock.value()}, {false, false}, q.value()});
+                }
+                else
+                {
+                    if (terminals.size() < 2 || !namedTerminals.empty())
+                    {
+                        return SetError(statement[0].line, QString("A %0 gate needs an output and at least one input.").arg(keyword));
+                    }
+
+                    if (lowerKeyword == "not" || lowerKeyword == "buf")
+                    {
+                        // Several outputs driven by the last terminal
+                        for (size_t out = 0; out + 1 < terminals.size(); out++)
+                        {
+                            AddGate(lowerKeyword == "not" ? NetlistCellType::NOT_GATE : NetlistCellType::BUFFER_GATE,
+                                    {terminals.back().value()}, {false}, terminals[out].value(), false);
+                        }
+                    }
+                    else
+                    {
+                        std::vector<uint32_t> inputs;
+                        for (size_t in = 1; in < terminals.size(); in++)
+                        {
+                            inputs.push_back(terminals[in].value());
+                        }
+
+                        const bool isInverted = lowerKeyword.startsWith('n') || lowerKeyword == "xnor";
+                        const auto type = lowerKeyword.endsWith("and") ? NetlistCellType::AND_GATE
+                                        : (lowerKeyword.endsWith("xor") || lowerKeyword == "xnor") ? NetlistCellType::XOR_GATE
+                                        : NetlistCellType::OR_GATE;
+
+                        AddGate(type, inputs, std::vector<bool>(inputs.size(), false), terminals[0].value(), isInverted);
+                    }
+                }
+
+                if (i < statement.size() && statement[i].text == ",") // Further instances in the same statement
+                {
+                    i++;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+        else
+        {
+            return SetError(statement[0].line, QString("Unsupported statement or cell type %0.").arg(keyword));
+        }
+    }
+
+    return true;
+}
+
+void NetlistImporter::AddCover(const std::vector<uint32_t>& pInputs, uint32_t pOutput, const QStringList& pCubes, bool pIsOnSet)
+{
+    if (pCubes.isEmpty()) // Empty cover, the output is never in the set
+    {
+        AddSource(NetlistCellType::CONSTANT, pOutput, pIsOnSet ? LogicState::LOW : LogicState::HIGH);
+        return;
+    }
+
+    if (pInputs.size() == 2 && pCubes.size() == 2)
+    {
+        auto cubes = pCubes;
+        cubes.sort();
+
+        if (cubes == QStringList{"01", "10"} || cubes == QStringList{"00", "11"})
+        {
+            AddGate(NetlistCellType::XOR_GATE, pInputs, {false, false}, pOutput, (cubes[0] == "00") == pIsOnSet);
+            return;
+        }
+    }
+
+    std::vector<uint32_t> orInputs;
+    std::vector<bool> orInversions;
+
+    for (const auto& cube : pCubes)
+    {
+        std::vector<uint32_t> literals;
+        std::vector<bool> inversions;
+
+        for (qsizetype i = 0; i < cube.size(); i++)
+        {
+            if (cube[i] != '-')
+            {
+                literals.push_back(pInputs[i]);
+                inversions.push_back(cube[i] == '0');
+            }
+        }
+
+        if (literals.empty()) // Cube without literals covers every input combination
+        {
+            AddSource(NetlistCellType::CONSTANT, pOutput, pIsOnSet ? LogicState::HIGH : LogicState::LOW);
+            return;
+        }
+
+        if (pCubes.size() == 1 && literals.size() > 1)
+        {
+            AddGate(NetlistCellType::AND_GATE, literals, inversions, pOutput, !pIsOnSet);
+            return;
+        }
+
+        if (literals.size() == 1)
+        {
+            orInputs.push_back(literals[0]);
+            orInversions.push_back(inversions[0]);
+        }
+        else
+        {
+            const auto product = CreateNet();
+            AddGate(NetlistCellType::AND_GATE, literals, inversions, product, false);
+            orInputs.push_back(product);
+            orInversions.push_back(false);
+        }
+    }
+
+    if (orInputs.size() == 1)
+    {
+        const bool isInverted = (orInversions[0] == pIsOnSet);
+        AddGate(isInverted ? NetlistCellType::NOT_GATE : NetlistCellType::BUFFER_GATE, orInputs, {false}, pOutput, false);
+    }
+    else
+    {
+        AddGate(NetlistCellType::OR_GATE, orInputs, orInversions, pOutput, !pIsOnSet);
+    }
+}
+
+void NetlistImporter::AddGate(NetlistCellType pType, std::vector<uint32_t> pInputs, std::vector<bool> pInversions, uint32_t pOutput, bool pIsOutputInverted)
+{
+    Q_ASSERT(!pInputs.empty() && pInputs.size() == pInversions.size());
+
+    // XOR gates are high for exactly one high input, so parity is built from a tree of two-input gates
+    const size_t maxInputs = (pType == NetlistCellType::XOR_GATE ? 2 : components::gates::MAX_INPUT_COUNT);
+
+    if (pInputs.size() > maxInputs)
+    {
+        std::vector<uint32_t> subOutputs;
+
+        for (size_t first = 0; first < pInputs.size(); first += maxInputs)
+        {
+            const auto last = std::min(first + maxInputs, pInputs.size());
+
+            if (last - first == 1)
+            {
+                // A single remaining input is passed on, its inversion is applied by the next level
+                const auto net = CreateNet();
+                AddGate(pInversions[first] ? NetlistCellType::NOT_GATE : NetlistCellType::BUFFER_GATE, {pInputs[first]}, {false}, net, false);
+                subOutputs.push_back(net);
+                continue;
+            }
+
+            const auto net = CreateNet();
+            AddGate(pType, std::vector<uint32_t>(pInputs.begin() + first, pInputs.begin() + last),
+                    std::vector<bool>(pInversions.begin() + first, pInversions.begin() + last), net, false);
+            subOutputs.push_back(net);
+        }
+
+        AddGate(pType, subOutputs, std::vector<bool>(subOutputs.size(), false), pOutput, pIsOutputInverted);
+        return;
+    }
+
+    mCells.push_back(Cell{pType, std::move(pInputs), std::move(pInversions), pOutput, pIsOutputInverted});
+}
+
+void NetlistImporter::AddSource(NetlistCellType pType, uint32_t pOutput, LogicState pState)
+{
+    Cell cell{pType, {}, {}, pOutput};
+    cell.constantState = pState;
+    mCells.push_back(cell);
+}
+
+uint32_t NetlistImporter::GetNet(const QString& pName)
+{
+    const auto net = mNetIndices.constFind(pName);
+
+    if (net != mNetIndices.constEnd())
+    {
+        return net.value();
+    }
+
+    const auto index = CreateNet();
+    mNetNames[index] = pName;
+    mNetIndices.insert(pName, index);
+    return index;
+}
+
+uint32_t NetlistImporter::CreateNet()
+{
+    const uint32_t index = mNetNames.size();
+    mNetNames.emplace_back();
+    mNetParents.push_back(index);
+    return index;
+}
+
+uint32_t NetlistImporter::FindNet(uint32_t pNet)
+{
+    while (mNetParents[pNet] != pNet)
+    {
+        mNetParents[pNet] = mNetParents[mNetParents[pNet]]; // Path halving
+        pNet = mNetParents[pNet];
+    }
+    return pNet;
+}
+
+bool NetlistImporter::FinishNetlist()
+{
+    QSet<QString> outputNames;
+    for (const auto& name : mOutputNames)
+    {
+        if (!outputNames.contains(name))
+        {
+            outputNames.insert(name);
+            mCells.push_back(Cell{NetlistCellType::OUTPUT, {GetNet(name)}, {false}, std::nullopt});
+        }
+    }
+
+    if (mCells.empty())
+    {
+        return SetError(0, QString("The netlist contains no cells."));
+    }
+
+    mNetDrivers.assign(mNetNames.size(), std::nullopt);
+    mNetSinks.assign(mNetNames.size(), {});
+
+    for (uint32_t cellIndex = 0; cellIndex < mCells.size(); cellIndex++)
+    {
+        auto& cell = mCells[cellIndex];
+
+        for (uint32_t in = 0; in < cell.inputs.size(); in++)
+        {
+            cell.inputs[in] = FindNet(cell.inputs[in]);
+            mNetSinks[cell.inputs[in]].push_back(Pin{cellIndex, in, false});
+        }
+
+        if (cell.output.has_value())
+        {
+            cell.output = FindNet(cell.output.value());
+
+            if (mNetDrivers[cell.output.value()].has_value())
+            {
+                const auto& name = mNetNames[cell.output.value()];
+                return SetError(0, QString("The net %0 has several drivers.").arg(name.isEmpty() ? QString("<unnamed>") : name));
+            }
+
+            mNetDrivers[cell.output.value()] = Pin{cellIndex, 0, true};
+        }
+    }
+
+    // Undriven nets are still routed between their sinks, they stay low in the simulation and are reported to the user
+    mUndrivenNets.clear();
+    for (uint32_t net = 0; net < mNetNames.size(); net++)
+    {
+        if (!mNetSinks[net].empty() && !mNetDrivers[net].has_value())
+        {
+            mUndrivenNets << (mNetNames[net].isEmpty() ? QString("<unnamed>") : mNetNames[net]);
+        }
+    }
+
+    return true;
+}
+
+void NetlistImporter::Place()
+{
+    const uint32_t cellCount = mCells.size();
+
+    // Levelize the combinational logic, the outputs of sources and flip-flops start at level 0
+    std::vector<uint32_t> levels(cellCount, 0);
+    std::vector<uint32_t> pendingInputs(cellCount, 0);
+    std::vector<bool> isLevelized(cellCount, false);
+
+    const auto isCombinationalDriver = [&](uint32_t pNet)
+    {
+        return mNetDrivers[pNet].has_value() && IsCombinational(mCells[mNetDrivers[pNet]->cell].type);
+    };
+
+    const auto getLevel = [&](uint32_t pCell)
+    {
+        uint32_t level = 0;
+        for (const auto& net : mCells[pCell].inputs)
+        {
+            if (isCombinationalDriver(net))
+            {
+                level = std::max(level, levels[mNetDrivers[net]->cell]);
+            }
+        }
+        return IsSource(mCells[pCell].type) ? 0 : level + 1;
+    };
+
+    std::queue<uint32_t> ready;
+
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        for (const auto& net : mCells[cell].inputs)
+        {
+            pendingInputs[cell] += isCombinationalDriver(net) ? 1 : 0;
+        }
+
+        if (pendingInputs[cell] == 0)
+        {
+            ready.push(cell);
+        }
+    }
+
+    // Cells in combinational loops are never ready, they are levelized in index order afterwards
+    for (uint32_t next = 0; next < cellCount || !ready.empty();)
+    {
+        if (ready.empty())
+        {
+            if (!isLevelized[next])
+            {
+                ready.push(next);
+            }
+            next++;
+            continue;
+        }
+
+        const auto cell = ready.front();
+        ready.pop();
+
+        if (isLevelized[cell])
+        {
+            continue;
+        }
+
+        isLevelized[cell] = true;
+        levels[cell] = getLevel(cell);
+
+        if (IsCombinational(mCells[cell].type) && mCells[cell].output.has_value())
+        {
+            for (const auto& sink : mNetSinks[mCells[cell].output.value()])
+            {
+                if (pendingInputs[sink.cell] > 0 && --pendingInputs[sink.cell] == 0)
+                {
+                    ready.push(sink.cell);
+                }
+            }
+        }
+    }
+
+    uint32_t maxLevel = 0;
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        if (mCells[cell].type != NetlistCellType::OUTPUT)
+        {
+            maxLevel = std::max(maxLevel, levels[cell]);
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> levelCells(maxLevel + 2);
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        levelCells[mCells[cell].type == NetlistCellType::OUTPUT ? maxLevel + 1 : levels[cell]].push_back(cell);
+    }
+
+    // Levels are split into columns of limited height, so that large netlists stay roughly square
+    const uint32_t rowsPerColumn = std::clamp(static_cast<uint32_t>(std::ceil(std::sqrt(cellCount))), netlist_import::MIN_COLUMN_ROWS, netlist_import::MAX_COLUMN_ROWS);
+
+    mCellColumns.assign(cellCount, 0);
+    mCellRows.assign(cellCount, 0);
+    std::vector<bool> isPlaced(cellCount, false);
+    std::vector<double> barycenters(cellCount, 0);
+    mColumnCount = 0;
+    mRowCount = 0;
+
+    for (auto& cells : levelCells)
+    {
+        if (cells.empty())
+        {
+            continue;
+        }
+
+        // Order by the barycenter of the rows of already placed drivers to shorten the vertical trunks
+        for (const auto& cell : cells)
+        {
+            double sum = 0;
+            uint32_t count = 0;
+
+            for (const auto& net : mCells[cell].inputs)
+            {
+                if (mNetDrivers[net].has_value() && isPlaced[mNetDrivers[net]->cell])
+                {
+                    sum += mCellRows[mNetDrivers[net]->cell];
+                    count++;
+                }
+            }
+
+            barycenters[cell] = (count > 0 ? sum / count : std::numeric_limits<double>::max());
+        }
+
+        std::stable_sort(cells.begin(), cells.end(), [&](uint32_t pA, uint32_t pB)
+        {
+            return barycenters[pA] < barycenters[pB];
+        });
+
+        for (uint32_t i = 0; i < cells.size(); i++)
+        {
+            mCellColumns[cells[i]] = mColumnCount + i / rowsPerColumn;
+            mCellRows[cells[i]] = i % rowsPerColumn;
+            isPlaced[cells[i]] = true;
+        }
+
+        mColumnCount += (cells.size() + rowsPerColumn - 1) / rowsPerColumn;
+        mRowCount = std::max(mRowCount, std::min<uint32_t>(cells.size(), rowsPerColumn));
+    }
+}
+
+std::optional<std::vector<QJsonObject>> NetlistImporter::CreateComponents()
+{
+    constexpr double g = canvas::GRID_SIZE;
+
+    Place();
+
+    // Every row has a slot for even columns, a slot for odd columns and a routing band below
+    double maxHeight = 0;
+    std::vector<double> columnWidths(mColumnCount, 0);
+
+    for (uint32_t cell = 0; cell < mCells.size(); cell++)
+    {
+        const auto& geometry = GetGeometry(mCells[cell]);
+        maxHeight = std::max(maxHeight, geometry.height);
+        columnWidths[mCellColumns[cell]] = std::max(columnWidths[mCellColumns[cell]], geometry.width);
+    }
+
+    const double slotHeight = maxHeight + g;
+
+    // Output connectors are reached from the channel right of their column, input connectors from the channel left of it
+    const auto getChannel = [&](const Pin& pPin)
+    {
+        return mCellColumns[pPin.cell] + (pPin.isOutput ? 1 : 0);
+    };
+
+    struct Route
+    {
+        std::vector<Pin> pins; // Sorted by channel
+        std::optional<uint32_t> band;
+        uint32_t track = 0;
+        size_t firstTrunk = 0;
+        size_t trunkCount = 0;
+    };
+
+    std::vector<Route> routes;
+    std::vector<std::pair<uint32_t, uint32_t>> trackIntervals;
+    std::vector<std::vector<size_t>> bandRoutes(mRowCount);
+
+    for (uint32_t net = 0; net < mNetNames.size(); net++)
+    {
+        Route route;
+
+        if (mNetDrivers[net].has_value())
+        {
+            route.pins.push_back(mNetDrivers[net].value());
+        }
+        route.pins.insert(route.pins.end(), mNetSinks[net].begin(), mNetSinks[net].end());
+
+        if (route.pins.size() < 2)
+        {
+            continue; // Nothing to connect
+        }
+
+        const auto bandCell = route.pins.front().cell; // The driver, if there is one
+
+        std::stable_sort(route.pins.begin(), route.pins.end(), [&](const Pin& pA, const Pin& pB)
+        {
+            return getChannel(pA) < getChannel(pB);
+        });
+
+        if (getChannel(route.pins.front()) != getChannel(route.pins.back()))
+        {
+            route.band = mCellRows[bandCell];
+            bandRoutes[route.band.value()].push_back(routes.size());
+        }
+
+        routes.push_back(std::move(route));
+    }
+
+    // Horizontal tracks; tracks of different nets may not share a channel, their trunk positions are not known yet
+    std::vector<uint32_t> bandTrackCounts(mRowCount, 0);
+
+    for (uint32_t band = 0; band < mRowCount; band++)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> intervals;
+        for (const auto& index : bandRoutes[band])
+        {
+            intervals.emplace_back(getChannel(routes[index].pins.front()), getChannel(routes[index].pins.back()));
+        }
+
+        std::vector<uint32_t> tracks;
+        bandTrackCounts[band] = AssignTracks(intervals, tracks);
+
+        for (size_t i = 0; i < tracks.size(); i++)
+        {
+            routes[bandRoutes[band][i]].track = tracks[i];
+        }
+    }
+
+    std::vector<double> rowTops(mRowCount + 1, 0);
+    for (uint32_t row = 0; row < mRowCount; row++)
+    {
+        rowTops[row + 1] = rowTops[row] + 2 * slotHeight + bandTrackCounts[row] * g;
+    }
+
+    const auto getCellTop = [&](uint32_t pCell)
+    {
+        return rowTops[mCellRows[pCell]] + (mCellColumns[pCell] % 2) * slotHeight;
+    };
+
+    const auto getPinOffset = [&](const Pin& pPin)
+    {
+        const auto& geometry = GetGeometry(mCells[pPin.cell]);
+        return (pPin.isOutput ? geometry.outputs : geometry.inputs)[pPin.connector];
+    };
+
+    const auto getPinY = [&](const Pin& pPin)
+    {
+        return getCellTop(pPin.cell) + getPinOffset(pPin).y();
+    };
+
+    const auto getTrackY = [&](const Route& pRoute)
+    {
+        return rowTops[pRoute.band.value()] + 2 * slotHeight + pRoute.track * g;
+    };
+
+    // Vertical trunks, one per net and channel
+    struct Trunk
+    {
+        uint32_t channel;
+        double top;
+        double bottom;
+        uint32_t track = 0;
+    };
+
+    std::vector<Trunk> trunks;
+    std::vector<std::vector<size_t>> channelTrunks(mColumnCount + 1);
+
+    for (auto& route : routes)
+    {
+        route.firstTrunk = trunks.size();
+
+        for (const auto& pin : route.pins)
+        {
+            const auto channel = getChannel(pin);
+            const auto y = getPinY(pin);
+
+            if (trunks.size() == route.firstTrunk || trunks.back().channel != channel)
+            {
+                const auto trackY = (route.band.has_value() ? getTrackY(route) : y);
+                channelTrunks[channel].push_back(trunks.size());
+                trunks.push_back(Trunk{channel, std::min(y, trackY), std::max(y, trackY)});
+            }
+            else
+            {
+                trunks.back().top = std::min(trunks.back().top, y);
+                trunks.back().bottom = std::max(trunks.back().bottom, y);
+            }
+        }
+
+        route.trunkCount = trunks.size() - route.firstTrunk;
+    }
+
+    std::vector<uint32_t> channelTrackCounts(mColumnCount + 1, 0);
+
+    for (uint32_t channel = 0; channel <= mColumnCount; channel++)
+    {
+        std::vector<std::pair<double, double>> intervals;
+        for (const auto& index : channelTrunks[channel])
+        {
+            intervals.emplace_back(trunks[index].top, trunks[index].bottom);
+        }
+
+        std::vector<uint32_t> tracks;
+        channelTrackCounts[channel] = AssignTracks(intervals, tracks);
+
+        for (size_t i = 0; i < tracks.size(); i++)
+        {
+            trunks[channelTrunks[channel][i]].track = tracks[i];
+        }
+    }
+
+    std::vector<double> channelLefts(mColumnCount + 1, 0);
+    std::vector<double> columnLefts(mColumnCount, 0);
+    double width = 0;
+
+    for (uint32_t channel = 0; channel <= mColumnCount; channel++)
+    {
+        channelLefts[channel] = width;
+        width += (channelTrackCounts[channel] + 1) * g;
+
+        if (channel < mColumnCount)
+        {
+            columnLefts[channel] = width;
+            width += columnWidths[channel];
+        }
+    }
+
+    const double height = rowTops[mRowCount];
+
+    // The scene rect is grown for circuits that exceed the default canvas, see View::FitSceneRect()
+    if (width + 2 * canvas::SCENE_RECT_MARGIN > canvas::MAX_DIMENSIONS.width() || height + 2 * canvas::SCENE_RECT_MARGIN > canvas::MAX_DIMENSIONS.height())
+    {
+        SetError(0, QString("The placed netlist needs %0 x %1 grid cells, which exceeds the canvas.").arg(width / g).arg(height / g));
+        return std::nullopt;
+    }
+
+    // The circuit is centered on the canvas
+    const auto origin = SnapToGrid(canvas::MAX_DIMENSIONS.center() - QPointF(width / 2, height / 2));
+
+    const auto getTrunkX = [&](const Trunk& pTrunk)
+    {
+        return channelLefts[pTrunk.channel] + (pTrunk.track + 1) * g;
+    };
+
+    std::vector<QJsonObject> components;
+    components.reserve(mCells.size() + 4 * routes.size());
+
+    for (uint32_t cell = 0; cell < mCells.size(); cell++)
+    {
+        const auto& geometry = GetGeometry(mCells[cell]);
+        auto& prototype = GetPrototype(mCells[cell]);
+
+        prototype.setPos(origin + QPointF(columnLefts[mCellColumns[cell]], getCellTop(cell)) + geometry.offset);
+
+        if (IsCombinational(mCells[cell].type))
+        {
+            prototype.GetLogicCell()->SetInputInversions(mCells[cell].inputInversions);
+            prototype.GetLogicCell()->SetOutputInversions(std::vector<bool>{mCells[cell].isOutputInverted});
+        }
+        else if (mCells[cell].type == NetlistCellType::D_FLIPFLOP)
+        {
+            prototype.GetLogicCell()->SetInputInversions(mCells[cell].inputInversions);
+        }
+
+        components.push_back(prototype.GetJson());
+    }
+
+    LogicWire horizontalWire(mCoreLogic, WireDirection::HORIZONTAL, canvas::GRID_SIZE);
+    LogicWire verticalWire(mCoreLogic, WireDirection::VERTICAL, canvas::GRID_SIZE);
+    ConPoint conPoint(mCoreLogic);
+
+    std::vector<QJsonObject> conPoints;
+
+    const auto addWire = [&](QPointF pA, QPointF pB)
+    {
+        auto& wire = (pA.y() == pB.y() ? horizontalWire : verticalWire);
+        wire.SetLength(static_cast<uint32_t>(std::abs((pB - pA).manhattanLength())));
+        wire.setPos(origin + QPointF(std::min(pA.x(), pB.x()), std::min(pA.y(), pB.y())));
+        components.push_back(wire.GetJson());
+    };
+
+    const auto addConPoint = [&](QPointF pPos)
+    {
+        conPoint.setPos(origin + pPos);
+        conPoints.push_back(conPoint.GetJson());
+    };
+
+    for (const auto& route : routes)
+    {
+        size_t trunkIndex = route.firstTrunk;
+
+        for (const auto& pin : route.pins)
+        {
+            while (trunks[trunkIndex].channel != getChannel(pin))
+            {
+                trunkIndex++;
+            }
+
+            const auto& trunk = trunks[trunkIndex];
+            const QPointF pinPos(columnLefts[mCellColumns[pin.cell]] + getPinOffset(pin).x(), getPinY(pin));
+            const QPointF junction(getTrunkX(trunk), pinPos.y());
+
+            addWire(pinPos, junction);
+
+            // Corners at the trunk ends are L-crossings, every other junction needs a ConPoint
+            if (junction.y() != trunk.top && junction.y() != trunk.bottom)
+            {
+                addConPoint(junction);
+            }
+        }
+
+        for (size_t i = route.firstTrunk; i < route.firstTrunk + route.trunkCount; i++)
+        {
+            const auto& trunk = trunks[i];
+            Q_ASSERT(trunk.bottom > trunk.top);
+            addWire(QPointF(getTrunkX(trunk), trunk.top), QPointF(getTrunkX(trunk), trunk.bottom));
+
+            if (route.band.has_value())
+            {
+                const auto trackY = getTrackY(route);
+                const bool isTrackEnd = (i == route.firstTrunk || i + 1 == route.firstTrunk + route.trunkCount);
+
+                if (!isTrackEnd || (trackY != trunk.top && trackY != trunk.bottom))
+                {
+                    addConPoint(QPointF(getTrunkX(trunk), trackY));
+                }
+            }
+        }
+
+        if (route.band.has_value())
+        {
+            const auto trackY = getTrackY(route);
+            addWire(QPointF(getTrunkX(trunks[route.firstTrunk]), trackY), QPointF(getTrunkX(trunks[route.firstTrunk + route.trunkCount - 1]), trackY));
+        }
+    }
+
+    components.insert(components.end(), conPoints.begin(), conPoints.end());
+    return components;
+}
+
+const NetlistImporter::CellGeometry& NetlistImporter::GetGeometry(const Cell& pCell)
+{
+    const auto key = std::make_pair(pCell.type, static_cast<int32_t>(pCell.type == NetlistCellType::CONSTANT ? static_cast<int32_t>(pCell.constantState) : pCell.inputs.size()));
+    const auto geometry = mGeometries.find(key);
+
+    if (geometry != mGeometries.end())
+    {
+        return geometry->second;
+    }
+
+    constexpr double g = canvas::GRID_SIZE;
+    const auto& prototype = GetPrototype(pCell);
+
+    auto left = prototype.boundingRect().left();
+    auto top = prototype.boundingRect().top();
+    auto right = prototype.boundingRect().right();
+    auto bottom = prototype.boundingRect().bottom();
+
+    for (const auto& connectors : {prototype.GetInConnectors(), prototype.GetOutConnectors()})
+    {
+        for (const auto& connector : connectors)
+        {
+            left = std::min(left, connector.pos.x());
+            top = std::min(top, connector.pos.y());
+            right = std::max(right, connector.pos.x());
+            bottom = std::max(bottom, connector.pos.y());
+        }
+    }
+
+    // The slot is aligned to the grid, so that the connectors stay on the grid
+    left = std::floor(left / g) * g;
+    top = std::floor(top / g) * g;
+    right = std::ceil(right / g) * g;
+    bottom = std::ceil(bottom / g) * g;
+
+    CellGeometry cellGeometry{QPointF(-left, -top), right - left, bottom - top, {}, {}};
+
+    for (const auto& connector : prototype.GetInConnectors())
+    {
+        cellGeometry.inputs.push_back(connector.pos + cellGeometry.offset);
+    }
+
+    for (const auto& connector : prototype.GetOutConnectors())
+    {
+        cellGeometry.outputs.push_back(connector.pos + cellGeometry.offset);
+    }
+
+    return mGeometries.emplace(key, cellGeometry).first->second;
+}
+
+IBaseComponent& NetlistImporter::GetPrototype(const Cell& pCell)
+{
+    const auto key = std::make_pair(pCell.type, static_cast<int32_t>(pCell.type == NetlistCellType::CONSTANT ? static_cast<int32_t>(pCell.constantState) : pCell.inputs.size()));
+    auto& prototype = mPrototypes[key];
+
+    if (nullptr != prototype)
+    {
+        return *prototype;
+    }
+
+    const auto inputCount = static_cast<uint8_t>(pCell.inputs.size());
+
+    switch (pCell.type)
+    {
+        case NetlistCellType::INPUT:
+        {
+            prototype = std::make_unique<LogicInput>(mCoreLogic);
+            break;
+        }
+        case NetlistCellType::OUTPUT:
+        {
+            prototype = std::make_unique<LogicOutput>(mCoreLogic);
+            break;
+        }
+        case NetlistCellType::CONSTANT:
+        {
+            prototype = std::make_unique<LogicConstant>(mCoreLogic, pCell.constantState);
+            break;
+        }
+        case NetlistCellType::CLOCK:
+        {
+            prototype = std::make_unique<LogicClock>(mCoreLogic, Direction::RIGHT);
+            std::static_pointer_cast<LogicClockCell>(prototype->GetLogicCell())->SetToggleTicks(netlist_import::CLOCK_TOGGLE_TICKS);
+            break;
+        }
+        case NetlistCellType::AND_GATE:
+        {
+            prototype = std::make_unique<AndGate>(mCoreLogic, inputCount, Direction::RIGHT);
+            break;
+        }
+        case NetlistCellType::OR_GATE:
+        {
+            prototype = std::make_unique<OrGate>(mCoreLogic, inputCount, Direction::RIGHT);
+            break;
+        }
+        case NetlistCellType::XOR_GATE:
+        {
+            prototype = std::make_unique<XorGate>(mCoreLogic, inputCount, Direction::RIGHT);
+            break;
+        }
+        case NetlistCellType::NOT_GATE:
+        {
+            prototype = std::make_unique<NotGate>(mCoreLogic, Direction::RIGHT);
+            break;
+        }
+        case NetlistCellType::BUFFER_GATE:
+        {
+            prototype = std::make_unique<BufferGate>(mCoreLogic, Direction::RIGHT);
+            break;
+        }
+        case NetlistCellType::D_FLIPFLOP:
+        {
+            prototype = std::make_unique<DFlipFlop>(mCoreLogic, Direction::RIGHT);
+            break;
+        }
+        default:
+        {
+            throw std::logic_error("Netlist cell type invalid");
+        }
+    }
+
+    return *prototype;
+}
+
+bool NetlistImporter::SetError(int32_t pLine, const QString& pMessage)
+{
+    mError = (pLine > 0 ? QString("Line %0: %1").arg(pLine).arg(pMessage) : pMessage);
+    return false;
+}
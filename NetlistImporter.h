@@ -0,0 +1,195 @@
+#ifndef NETLISTIMPORTER_H
+#define NETLISTIMPORTER_H
+
+#include "HelperStructures.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonObject>
+#include <QPointF>
+#include <QStringList>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class CoreLogic;
+class IBaseComponent;
+
+/// \brief NetlistCellType contains the kinds of cells an imported netlist is mapped to
+enum class NetlistCellType
+{
+    INPUT = 0,
+    OUTPUT,
+    CONSTANT,
+    CLOCK,
+    AND_GATE,
+    OR_GATE,
+    XOR_GATE,
+    NOT_GATE,
+    BUFFER_GATE,
+    D_FLIPFLOP
+};
+
+///
+/// \brief The NetlistImporter class reads a gate-level netlist and creates the components, wires and ConPoints of an equivalent circuit.
+/// Supported are BLIF (.names covers and .latch) and a structural Verilog subset (and, or, xor, nand, nor, xnor, not, buf, dff and assign).
+///
+/// Cells are placed in columns by their logic level and ordered by the barycenter of their drivers. Gates of even and odd columns
+/// are placed in separate slots of every row, so that output and input connectors that share a routing channel never share a y coordinate.
+/// Every net gets a vertical trunk in the channel left of each column it feeds and right of its driver; nets that span several channels
+/// are joined by a horizontal track in the routing band below the driver's row. Tracks are assigned with the left-edge algorithm,
+/// so different nets never overlap, and ConPoints are only placed at junctions of a single net.
+///
+class NetlistImporter
+{
+public:
+    /// \brief Constructor for the NetlistImporter
+    /// \param pCoreLogic: Pointer to the core logic, used to construct the components
+    NetlistImporter(const CoreLogic* pCoreLogic);
+
+    /// \brief Destructor for the NetlistImporter
+    ~NetlistImporter(void);
+
+    /// \brief Reads a netlist file, the format is chosen by the file suffix (.blif or .v)
+    /// \param pFileInfo: The netlist file
+    /// \return False, if the file could not be read or contains unsupported constructs
+    bool Read(const QFileInfo& pFileInfo);
+
+    /// \brief Places and routes the netlist that has been read
+    /// \return The components in the circuit file JSON format, or nothing if the circuit doesn't fit on the largest canvas
+    std::optional<std::vector<QJsonObject>> CreateComponents(void);
+
+    /// \brief Getter for the reason why reading or creating the circuit failed
+    /// \return The error message
+    const QString& GetError(void) const;
+
+    /// \brief Getter for the names of the nets that are read by cells but driven by none, valid after CreateComponents()
+    /// \return The names of the undriven nets
+    const QStringList& GetUndrivenNets(void) const;
+
+protected:
+    /// \brief Cell contains a component of the netlist and the nets connected to it
+    struct Cell
+    {
+        NetlistCellType type;
+        std::vector<uint32_t> inputs; // Nets connected to the input connectors
+        std::vector<bool> inputInversions;
+        std::optional<uint32_t> output; // Net driven by the first output connector
+        bool isOutputInverted = false;
+        LogicState constantState = LogicState::LOW;
+    };
+
+    /// \brief Pin contains a connector of a cell
+    struct Pin
+    {
+        uint32_t cell;
+        uint32_t connector;
+        bool isOutput;
+    };
+
+    /// \brief CellGeometry contains the size and connector positions of a component, relative to the top left corner of its slot
+    struct CellGeometry
+    {
+        QPointF offset; // Position of the component in its slot
+        double width;
+        double height;
+        std::vector<QPointF> inputs;
+        std::vector<QPointF> outputs;
+    };
+
+    /// \brief Reads a BLIF netlist
+    /// \param pText: The content of the file
+    /// \return False, if the netlist could not be read
+    bool ReadBlif(const QString& pText);
+
+    /// \brief Reads a structural Verilog netlist
+    /// \param pText: The content of the file
+    /// \return False, if the netlist could not be read
+    bool ReadVerilog(const QString& pText);
+
+    /// \brief Maps a BLIF sum-of-products cover to gates
+    /// \param pInputs: The input nets
+    /// \param pOutput: The output net
+    /// \param pCubes: The input patterns of the cover
+    /// \param pIsOnSet: True, if the cover describes where the output is high
+    void AddCover(const std::vector<uint32_t>& pInputs, uint32_t pOutput, const QStringList& pCubes, bool pIsOnSet);
+
+    /// \brief Adds a gate, gates with more inputs than supported are split into trees
+    /// \param pType: The gate type
+    /// \param pInputs: The input nets
+    /// \param pInversions: Input inversions, one per input
+    /// \param pOutput: The output net
+    /// \param pIsOutputInverted: Whether the output is inverted
+    void AddGate(NetlistCellType pType, std::vector<uint32_t> pInputs, std::vector<bool> pInversions, uint32_t pOutput, bool pIsOutputInverted);
+
+    /// \brief Adds a cell without inputs
+    /// \param pType: The cell type
+    /// \param pOutput: The net driven by the cell
+    /// \param pState: The state of constants
+    void AddSource(NetlistCellType pType, uint32_t pOutput, LogicState pState = LogicState::LOW);
+
+    /// \brief Returns the net with the given name, it is created if it doesn't exist yet
+    /// \param pName: The name of the net
+    /// \return The index of the net
+    uint32_t GetNet(const QString& pName);
+
+    /// \brief Creates an unnamed net, used between the gates of split cells
+    /// \return The index of the net
+    uint32_t CreateNet(void);
+
+    /// \brief Returns the net that is connected to the given net by assignments
+    /// \param pNet: The index of a net
+    /// \return The index of the representative net
+    uint32_t FindNet(uint32_t pNet);
+
+    /// \brief Resolves assigned nets, adds the outputs and collects the driver and sinks of every net
+    /// \return False, if a net has several drivers
+    bool FinishNetlist(void);
+
+    /// \brief Assigns every cell to a column and row
+    void Place(void);
+
+    /// \brief Returns the geometry of the component of the given cell
+    /// \param pCell: The cell
+    /// \return The geometry of the cell's component
+    const CellGeometry& GetGeometry(const Cell& pCell);
+
+    /// \brief Returns the prototype component of the given cell, which is moved and configured to create the cell's JSON representation
+    /// \param pCell: The cell
+    /// \return The prototype component
+    IBaseComponent& GetPrototype(const Cell& pCell);
+
+    /// \brief Sets the error message and returns false
+    /// \param pLine: The line of the netlist the error occured in
+    /// \param pMessage: The error message
+    /// \return Always false
+    bool SetError(int32_t pLine, const QString& pMessage);
+
+protected:
+    const CoreLogic* mCoreLogic;
+    QString mError;
+
+    // Netlist
+    std::vector<Cell> mCells;
+    std::vector<QString> mNetNames;
+    QHash<QString, uint32_t> mNetIndices;
+    std::vector<uint32_t> mNetParents; // Assignments join nets, see FindNet
+    QStringList mOutputNames;
+    std::optional<uint32_t> mImplicitClockNet;
+
+    std::vector<std::optional<Pin>> mNetDrivers;
+    std::vector<std::vector<Pin>> mNetSinks;
+    QStringList mUndrivenNets;
+
+    // Placement
+    std::vector<uint32_t> mCellColumns;
+    std::vector<uint32_t> mCellRows;
+    uint32_t mColumnCount = 0;
+    uint32_t mRowCount = 0;
+
+    std::map<std::pair<NetlistCellType, int32_t>, std::unique_ptr<IBaseComponent>> mPrototypes;
+    std::map<std::pair<NetlistCellType, int32_t>, CellGeometry> mGeometries;
+};
+
+#endif // NETLISTIMPORTER_H
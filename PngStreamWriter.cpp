@@ -0,0 +1,168 @@
+#include "PngStreamWriter.h"
+#include "Configuration.h"
+
+namespace
+{
+constexpr char PNG_SIGNATURE[] = "\x89PNG\r\n\x1a\n";
+
+constexpr uint8_t BYTES_PER_PIXEL = 3;
+constexpr uint8_t BIT_DEPTH = 8;
+constexpr uint8_t COLOR_TYPE_RGB = 2;
+constexpr uint8_t FILTER_TYPE_SUB = 1;
+
+void AppendBigEndian(QByteArray& pData, uint32_t pValue)
+{
+    pData.append(static_cast<char>((pValue >> 24) & 0xFF));
+    pData.append(static_cast<char>((pValue >> 16) & 0xFF));
+    pData.append(static_cast<char>((pValue >> 8) & 0xFF));
+    pData.append(static_cast<char>(pValue & 0xFF));
+}
+}
+
+PngStreamWriter::PngStreamWriter():
+    mStream{}
+{}
+
+PngStreamWriter::~PngStreamWriter()
+{
+    if (mIsStreamOpen)
+    {
+        deflateEnd(&mStream);
+    }
+}
+
+bool PngStreamWriter::Open(const QString& pFilePath, uint32_t pWidth, uint32_t pHeight)
+{
+    Q_ASSERT(pWidth > 0 && pHeight > 0);
+    Q_ASSERT(!mIsStreamOpen);
+
+    mFile.setFileName(pFilePath);
+    if (!mFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    mWidth = pWidth;
+    mHeight = pHeight;
+    mRowsWritten = 0;
+    mFilteredRow.resize(1 + static_cast<size_t>(pWidth) * BYTES_PER_PIXEL);
+
+    mStream = z_stream{};
+    if (deflateInit(&mStream, image_export::PNG_COMPRESSION_LEVEL) != Z_OK)
+    {
+        mFile.close();
+        return false;
+    }
+    mIsStreamOpen = true;
+
+    mFile.write(PNG_SIGNATURE, sizeof(PNG_SIGNATURE) - 1);
+
+    QByteArray header;
+    AppendBigEndian(header, pWidth);
+    AppendBigEndian(header, pHeight);
+    header.append(static_cast<char>(BIT_DEPTH));
+    header.append(static_cast<char>(COLOR_TYPE_RGB));
+    header.append(static_cast<char>(0)); // Deflate compression
+    header.append(static_cast<char>(0)); // Adaptive filtering
+    header.append(static_cast<char>(0)); // No interlacing
+    WriteChunk("IHDR", header);
+
+    mImageData.resize(image_export::PNG_CHUNK_SIZE);
+    mStream.next_out = reinterpret_cast<Bytef*>(mImageData.data());
+    mStream.avail_out = static_cast<uInt>(mImageData.size());
+
+    return (mFile.error() == QFileDevice::NoError);
+}
+
+bool PngStreamWriter::WriteRow(const QRgb* pPixels)
+{
+    Q_ASSERT(pPixels);
+    Q_ASSERT(mIsStreamOpen && mRowsWritten < mHeight);
+
+    // The sub filter stores the difference to the pixel on the left, which turns uniform areas into runs of zeros
+    mFilteredRow[0] = FILTER_TYPE_SUB;
+    QRgb previous = 0;
+
+    for (uint32_t x = 0; x < mWidth; x++)
+    {
+        auto pixel = &mFilteredRow[1 + static_cast<size_t>(x) * BYTES_PER_PIXEL];
+        pixel[0] = static_cast<uint8_t>(qRed(pPixels[x]) - qRed(previous));
+        pixel[1] = static_cast<uint8_t>(qGreen(pPixels[x]) - qGreen(previous));
+        pixel[2] = static_cast<uint8_t>(qBlue(pPixels[x]) - qBlue(previous));
+        previous = pPixels[x];
+    }
+
+    mRowsWritten++;
+
+    return Deflate(mFilteredRow.data(), mFilteredRow.size(), Z_NO_FLUSH) && (mFile.error() == QFileDevice::NoError);
+}
+
+bool PngStreamWriter::Finish()
+{
+    if (!mIsStreamOpen)
+    {
+        return false;
+    }
+
+    bool success = Deflate(nullptr, 0, Z_FINISH);
+
+    mImageData.truncate(mImageData.size() - mStream.avail_out);
+    if (!mImageData.isEmpty())
+    {
+        WriteChunk("IDAT", mImageData);
+    }
+    WriteChunk("IEND", QByteArray());
+    mImageData.clear();
+
+    deflateEnd(&mStream);
+    mIsStreamOpen = false;
+
+    success &= (mRowsWritten == mHeight && mFile.error() == QFileDevice::NoError);
+    mFile.close();
+
+    return success;
+}
+
+void PngStreamWriter::WriteChunk(const char* pType, const QByteArray& pData)
+{
+    QByteArray chunk;
+    chunk.reserve(pData.size() + 12);
+
+    AppendBigEndian(chunk, static_cast<uint32_t>(pData.size()));
+    chunk.append(pType, 4);
+    chunk.append(pData);
+
+    // The checksum covers the type and the data, but not the length
+    const auto crc = crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(chunk.constData()) + 4, chunk.size() - 4);
+
+    AppendBigEndian(chunk, static_cast<uint32_t>(crc));
+    mFile.write(chunk);
+}
+
+bool PngStreamWriter::Deflate(const uint8_t* pData, size_t pSize, int pFlush)
+{
+    mStream.next_in = const_cast<Bytef*>(pData);
+    mStream.avail_in = static_cast<uInt>(pSize);
+
+    while (true)
+    {
+        const auto result = deflate(&mStream, pFlush);
+
+        if (result == Z_STREAM_ERROR)
+        {
+            return false;
+        }
+
+        if (mStream.avail_out == 0)
+        {
+            // The chunk is full, deflate() may have more output pending
+            WriteChunk("IDAT", mImageData);
+            mStream.next_out = reinterpret_cast<Bytef*>(mImageData.data());
+            mStream.avail_out = static_cast<uInt>(mImageData.size());
+            continue;
+        }
+
+        // With output space left, deflate() has consumed all input, or has ended the stream
+        return (pFlush != Z_FINISH) || (result == Z_STREAM_END);
+    }
+}
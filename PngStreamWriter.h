@@ -0,0 +1,73 @@
+#ifndef PNGSTREAMWRITER_H
+#define PNGSTREAMWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QRgb>
+#include <QString>
+#include <vector>
+
+#if defined(Q_OS_WIN)
+#include <QtZlib/zlib.h>
+#else
+#include <zlib.h>
+#endif
+
+///
+/// \brief The PngStreamWriter class writes an RGB PNG image row by row, so that images larger than
+/// the available memory can be written. Every row is passed to a zlib deflate stream right away,
+/// the compressed data is written to the file whenever an image data chunk is full.
+///
+class PngStreamWriter
+{
+public:
+    /// \brief Constructor for the PngStreamWriter
+    PngStreamWriter(void);
+
+    /// \brief Destructor for the PngStreamWriter, releases the deflate stream of an unfinished image
+    ~PngStreamWriter(void);
+
+    /// \brief Creates the file and writes the image header
+    /// \param pFilePath: The path of the PNG file to write
+    /// \param pWidth: The width of the image in pixels
+    /// \param pHeight: The height of the image in pixels
+    /// \return False, if the file could not be created
+    bool Open(const QString& pFilePath, uint32_t pWidth, uint32_t pHeight);
+
+    /// \brief Compresses and writes the next row of the image
+    /// \param pPixels: The pixels of the row, the alpha channel is ignored
+    /// \return False, if the row could not be written
+    bool WriteRow(const QRgb* pPixels);
+
+    /// \brief Finishes the compressed image data and closes the file
+    /// \return False, if not all rows have been written or the file could not be written
+    bool Finish(void);
+
+protected:
+    /// \brief Writes a PNG chunk to the file
+    /// \param pType: The four character chunk type
+    /// \param pData: The data of the chunk
+    void WriteChunk(const char* pType, const QByteArray& pData);
+
+    /// \brief Passes the given bytes to the deflate stream and writes all full image data chunks
+    /// \param pData: Pointer to the bytes
+    /// \param pSize: The amount of bytes
+    /// \param pFlush: Z_NO_FLUSH while rows follow, Z_FINISH to end the stream
+    /// \return False, if zlib reported an error
+    bool Deflate(const uint8_t* pData, size_t pSize, int pFlush);
+
+protected:
+    QFile mFile;
+
+    uint32_t mWidth = 0;
+    uint32_t mHeight = 0;
+    uint32_t mRowsWritten = 0;
+
+    std::vector<uint8_t> mFilteredRow;
+    QByteArray mImageData;
+
+    z_stream mStream;
+    bool mIsStreamOpen = false;
+};
+
+#endif // PNGSTREAMWRITER_H
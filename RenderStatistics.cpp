@@ -0,0 +1,206 @@
+#include "RenderStatistics.h"
+#include "Configuration.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+
+uint32_t RenderStatistics::Frame::GetTotalPaintCalls() const
+{
+    uint32_t total = 0;
+
+    for (const auto& [metaObject, count] : paintCalls)
+    {
+        total += count;
+    }
+
+    return total;
+}
+
+RenderStatistics::RenderStatistics(QGraphicsScene* pScene):
+    QObject(pScene)
+{
+    Q_ASSERT(pScene);
+}
+
+void RenderStatistics::SetEnabled(bool pEnabled)
+{
+    mIsEnabled = pEnabled;
+
+    mCurrentFrame = Frame();
+    mFrames.clear();
+    mNextFrameIndex = 0;
+    mFrameCount = 0;
+    mLastSimulationTick = 0;
+
+    if (pEnabled)
+    {
+        mFrames.reserve(profiling::RENDER_STATISTICS_FRAME_COUNT);
+        mFrameIntervalTimer.start();
+    }
+    else
+    {
+        mFrames.shrink_to_fit();
+        mFrameIntervalTimer.invalidate();
+    }
+}
+
+bool RenderStatistics::IsEnabled() const
+{
+    return mIsEnabled;
+}
+
+void RenderStatistics::CountPaint(const QObject* pComponent)
+{
+    Q_ASSERT(pComponent);
+
+    if (!mIsEnabled)
+    {
+        return;
+    }
+
+    // Only a handful of component classes are painted per frame, so a linear search is faster than a map
+    const auto metaObject = pComponent->metaObject();
+    auto entry = std::find_if(mCurrentFrame.paintCalls.begin(), mCurrentFrame.paintCalls.end(), [&](const auto& pEntry)
+    {
+        return pEntry.first == metaObject;
+    });
+
+    if (entry == mCurrentFrame.paintCalls.end())
+    {
+        mCurrentFrame.paintCalls.emplace_back(metaObject, 1);
+    }
+    else
+    {
+        entry->second++;
+    }
+}
+
+void RenderStatistics::CountUpdateRequest()
+{
+    if (mIsEnabled)
+    {
+        mCurrentFrame.updateRequests++;
+    }
+}
+
+void RenderStatistics::AddSimulationTime(std::chrono::nanoseconds pDuration)
+{
+    if (mIsEnabled)
+    {
+        mCurrentFrame.simulationTime += std::chrono::duration_cast<std::chrono::microseconds>(pDuration);
+    }
+}
+
+void RenderStatistics::DiscardPaintCalls()
+{
+    mCurrentFrame.paintCalls.clear();
+}
+
+void RenderStatistics::FinishFrame(std::chrono::nanoseconds pPaintTime, uint64_t pDirtyArea, uint64_t pSimulationTick)
+{
+    if (!mIsEnabled)
+    {
+        return;
+    }
+
+    mCurrentFrame.frameInterval = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(mFrameIntervalTimer.nsecsElapsed()));
+    mCurrentFrame.paintTime = std::chrono::duration_cast<std::chrono::microseconds>(pPaintTime);
+    mCurrentFrame.dirtyArea = pDirtyArea;
+
+    if (mFrameCount > 0)
+    {
+        // The tick counter restarts with every simulation
+        mCurrentFrame.simulationTicks = (pSimulationTick >= mLastSimulationTick) ? (pSimulationTick - mLastSimulationTick) : pSimulationTick;
+    }
+    mLastSimulationTick = pSimulationTick;
+
+    if (mFrames.size() < profiling::RENDER_STATISTICS_FRAME_COUNT)
+    {
+        mFrames.push_back(std::move(mCurrentFrame));
+    }
+    else
+    {
+        mFrames[mNextFrameIndex] = std::move(mCurrentFrame); // Overwrite the oldest frame
+    }
+
+    mNextFrameIndex = (mNextFrameIndex + 1) % profiling::RENDER_STATISTICS_FRAME_COUNT;
+    mFrameCount++;
+
+    mCurrentFrame = Frame();
+    mFrameIntervalTimer.restart();
+}
+
+const RenderStatistics::Frame* RenderStatistics::GetLastFrame() const
+{
+    if (mFrames.empty())
+    {
+        return nullptr;
+    }
+
+    return &mFrames[(mNextFrameIndex + profiling::RENDER_STATISTICS_FRAME_COUNT - 1) % profiling::RENDER_STATISTICS_FRAME_COUNT];
+}
+
+bool RenderStatistics::ExportCsv(const QString& pFilePath) const
+{
+    // One column for every component class that has been painted in any of the recorded frames
+    std::vector<const QMetaObject*> componentClasses;
+
+    for (const auto& frame : mFrames)
+    {
+        for (const auto& [metaObject, count] : frame.paintCalls)
+        {
+            if (std::find(componentClasses.begin(), componentClasses.end(), metaObject) == componentClasses.end())
+            {
+                componentClasses.push_back(metaObject);
+            }
+        }
+    }
+
+    std::sort(componentClasses.begin(), componentClasses.end(), [](const QMetaObject* pA, const QMetaObject* pB)
+    {
+        return qstrcmp(pA->className(), pB->className()) < 0;
+    });
+
+    QFile file(pFilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << profiling::RENDER_STATISTICS_CSV_HEADER;
+
+    for (const auto& componentClass : componentClasses)
+    {
+        out << "," << componentClass->className();
+    }
+
+    out << "\n";
+
+    // Before the buffer has wrapped around, the oldest frame is the first one
+    const size_t firstIndex = (mFrames.size() < profiling::RENDER_STATISTICS_FRAME_COUNT) ? 0 : mNextFrameIndex;
+
+    for (size_t i = 0; i < mFrames.size(); i++)
+    {
+        const auto& frame = mFrames[(firstIndex + i) % mFrames.size()];
+
+        out << (mFrameCount - mFrames.size() + i) << "," << frame.frameInterval.count() << "," << frame.paintTime.count() << ","
+            << frame.dirtyArea << "," << frame.updateRequests << "," << frame.simulationTicks << ","
+            << frame.simulationTime.count() << "," << frame.GetTotalPaintCalls();
+
+        for (const auto& componentClass : componentClasses)
+        {
+            const auto entry = std::find_if(frame.paintCalls.begin(), frame.paintCalls.end(), [&](const auto& pEntry)
+            {
+                return pEntry.first == componentClass;
+            });
+
+            out << "," << ((entry != frame.paintCalls.end()) ? entry->second : 0);
+        }
+
+        out << "\n";
+    }
+
+    return (out.status() == QTextStream::Ok);
+}
@@ -0,0 +1,91 @@
+#ifndef RENDERSTATISTICS_H
+#define RENDERSTATISTICS_H
+
+#include "SceneHelper.h"
+
+#include <QElapsedTimer>
+#include <QGraphicsScene>
+#include <QObject>
+#include <chrono>
+#include <vector>
+
+///
+/// \brief The RenderStatistics class collects per-frame statistics of the view while enabled.
+/// Items count their paint calls and update requests, the view finishes every frame with its paint time and
+/// dirty region. The last frames are kept in a ring buffer that can be exported as CSV, so that stutter can be
+/// attributed to simulation, scene lookups or painting.
+///
+class RenderStatistics : public QObject, public SceneHelper<RenderStatistics>
+{
+    Q_OBJECT
+public:
+    /// \brief Frame contains the statistics of one painted frame
+    struct Frame
+    {
+        std::chrono::microseconds frameInterval{0};  // Time since the previous frame has been finished
+        std::chrono::microseconds paintTime{0};
+        std::chrono::microseconds simulationTime{0}; // Time spent advancing the simulation since the previous frame
+        uint64_t dirtyArea = 0;                      // Area of the dirty region in device pixels
+        uint32_t updateRequests = 0;                 // Item updates requested by logic state changes
+        uint64_t simulationTicks = 0;
+        std::vector<std::pair<const QMetaObject*, uint32_t>> paintCalls; // Paint calls per component class
+
+        /// \brief Returns the number of paint calls of all component classes
+        /// \return The total number of paint calls
+        uint32_t GetTotalPaintCalls(void) const;
+    };
+
+    /// \brief Constructor for the RenderStatistics
+    /// \param pScene: The scene whose rendering is measured, takes ownership of the statistics
+    RenderStatistics(QGraphicsScene* pScene);
+
+    /// \brief Enables or disables collecting statistics, disabling clears all recorded frames
+    /// \param pEnabled: If true, statistics are collected
+    void SetEnabled(bool pEnabled);
+
+    /// \brief Returns whether statistics are collected
+    /// \return True, if statistics are collected
+    bool IsEnabled(void) const;
+
+    /// \brief Counts a paint call of the given component
+    /// \param pComponent: The component that is painted
+    void CountPaint(const QObject* pComponent);
+
+    /// \brief Counts an item update requested by a logic state change
+    void CountUpdateRequest(void);
+
+    /// \brief Adds the duration of one simulation step to the current frame
+    /// \param pDuration: The duration of the simulation step
+    void AddSimulationTime(std::chrono::nanoseconds pDuration);
+
+    /// \brief Drops the paint calls counted since the last finished frame, for repaints that are not measured as frames
+    void DiscardPaintCalls(void);
+
+    /// \brief Finishes the current frame and stores it in the ring buffer
+    /// \param pPaintTime: The time it took to paint the frame
+    /// \param pDirtyArea: The area of the dirty region in device pixels
+    /// \param pSimulationTick: The current simulation tick
+    void FinishFrame(std::chrono::nanoseconds pPaintTime, uint64_t pDirtyArea, uint64_t pSimulationTick);
+
+    /// \brief Getter for the last finished frame
+    /// \return Pointer to the last frame, or nullptr if no frame has been recorded
+    const Frame* GetLastFrame(void) const;
+
+    /// \brief Writes all recorded frames, oldest first, to a CSV file with one paint call column per component class
+    /// \param pFilePath: The path of the CSV file
+    /// \return True, if the file was written successfully
+    bool ExportCsv(const QString& pFilePath) const;
+
+protected:
+    bool mIsEnabled = false;
+
+    Frame mCurrentFrame;
+    std::vector<Frame> mFrames;
+    size_t mNextFrameIndex = 0;
+    uint64_t mFrameCount = 0;
+
+    QElapsedTimer mFrameIntervalTimer;
+    uint64_t mLastSimulationTick = 0;
+};
+
+#endif // RENDERSTATISTICS_H
@@ -0,0 +1,54 @@
+#ifndef SCENEHELPER_H
+#define SCENEHELPER_H
+
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QTimer>
+
+///
+/// \brief The SceneHelper class template gives the helper objects that exist once per scene access to the instance of a scene.
+/// A helper derives from SceneHelper with its own type and is parented to the scene it belongs to.
+///
+template<typename T>
+class SceneHelper
+{
+public:
+    /// \brief Returns the helper of type T that belongs to the given scene
+    /// \param pScene: The scene
+    /// \return Pointer to the helper, or nullptr if the scene has none
+    static T* FromScene(const QGraphicsScene* pScene)
+    {
+        if (nullptr == pScene)
+        {
+            return nullptr;
+        }
+
+        return pScene->findChild<T*>(QString(), Qt::FindDirectChildrenOnly);
+    }
+};
+
+/// \brief Restores the direct update path from the items to the views of the given scene, after a connection to
+/// QGraphicsScene::changed has been removed. Once anything is connected to the signal, Qt connects every view to it
+/// and updates the views only through the signal, until the scene of the view is set again.
+/// The views are reset in the next event loop iteration, because this may be called while a view is painted.
+/// If another connection to the signal remains, the views are connected again with the next scene update.
+/// \param pScene: The scene whose views are reset
+inline void RestoreDirectViewUpdates(QGraphicsScene* pScene)
+{
+    Q_ASSERT(pScene);
+
+    QTimer::singleShot(0, pScene, [pScene]()
+    {
+        for (auto view : pScene->views())
+        {
+            // Setting the scene keeps the transformation, but centers the scene rect
+            const auto center = view->mapToScene(view->viewport()->rect().center());
+
+            view->setScene(nullptr);
+            view->setScene(pScene);
+            view->centerOn(center);
+        }
+    });
+}
+
+#endif // SCENEHELPER_H
@@ -0,0 +1,267 @@
+#include "SpatialIndex.h"
+#include "Configuration.h"
+#include "Components/IBaseComponent.h"
+#include "Components/LogicWire.h"
+#include "Components/ConPoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Column and row indices are stored with an offset, so that negative indices fit into the unsigned key
+constexpr int64_t KEY_INDEX_OFFSET = static_cast<int64_t>(1) << 31;
+
+// Inclusive test, so that components touching the rectangle are found like with the scene's shape collision
+bool Intersects(const QRectF& pA, const QRectF& pB)
+{
+    return (pA.left() <= pB.right() && pB.left() <= pA.right() && pA.top() <= pB.bottom() && pB.top() <= pA.bottom());
+}
+
+bool Contains(const QRectF& pOuter, const QRectF& pInner)
+{
+    return (pOuter.left() <= pInner.left() && pInner.right() <= pOuter.right()
+            && pOuter.top() <= pInner.top() && pInner.bottom() <= pOuter.bottom());
+}
+}
+
+SpatialIndex::SpatialIndex(QGraphicsScene* pScene):
+    QObject(pScene)
+{
+    Q_ASSERT(pScene);
+}
+
+void SpatialIndex::Update(IBaseComponent* pComponent)
+{
+    Q_ASSERT(pComponent);
+
+    Entry entry{GetPartition(pComponent), pComponent->mapRectToScene(pComponent->shape().boundingRect()).normalized()};
+    const auto oldEntry = mEntries.find(pComponent);
+
+    if (oldEntry != mEntries.end())
+    {
+        if (oldEntry->second.rect == entry.rect)
+        {
+            return;
+        }
+
+        UpdateCells(pComponent, oldEntry->second, false);
+        entry.insertion = oldEntry->second.insertion; // Moving a component doesn't change its stacking order
+        oldEntry->second = entry;
+    }
+    else
+    {
+        entry.insertion = ++mInsertionCount;
+        mEntries.emplace(pComponent, entry);
+    }
+
+    UpdateCells(pComponent, entry, true);
+}
+
+void SpatialIndex::Remove(IBaseComponent* pComponent)
+{
+    const auto entry = mEntries.find(pComponent);
+
+    if (entry == mEntries.end())
+    {
+        return;
+    }
+
+    UpdateCells(pComponent, entry->second, false);
+    mEntries.erase(entry);
+}
+
+std::vector<LogicWire*> SpatialIndex::GetWires(const QRectF& pRect, WireDirection pDirection, Qt::ItemSelectionMode pMode) const
+{
+    std::vector<LogicWire*> wires;
+
+    const bool contained = (pMode == Qt::ContainsItemShape || pMode == Qt::ContainsItemBoundingRect);
+    const auto collect = [&](IBaseComponent* pComponent)
+    {
+        wires.push_back(static_cast<LogicWire*>(pComponent));
+    };
+
+    if (pDirection != WireDirection::VERTICAL)
+    {
+        Query(Partition::HORIZONTAL_WIRES, pRect.normalized(), contained, collect);
+    }
+
+    if (pDirection != WireDirection::HORIZONTAL)
+    {
+        Query(Partition::VERTICAL_WIRES, pRect.normalized(), contained, collect);
+    }
+
+    return wires;
+}
+
+std::vector<LogicWire*> SpatialIndex::GetWires(QPointF pPos, WireDirection pDirection) const
+{
+    return GetWires(QRectF(pPos, QSizeF(0, 0)), pDirection);
+}
+
+std::vector<ConPoint*> SpatialIndex::GetConPoints(QPointF pPos) const
+{
+    std::vector<ConPoint*> conPoints;
+
+    Query(Partition::CONPOINTS, QRectF(pPos, QSizeF(0, 0)), false, [&](IBaseComponent* pComponent)
+    {
+        conPoints.push_back(static_cast<ConPoint*>(pComponent));
+    });
+
+    return conPoints;
+}
+
+std::vector<IBaseComponent*> SpatialIndex::GetComponents(const QRectF& pRect) const
+{
+    std::vector<IBaseComponent*> components;
+
+    Query(Partition::COMPONENTS, pRect.normalized(), false, [&](IBaseComponent* pComponent)
+    {
+        components.push_back(pComponent);
+    });
+
+    return components;
+}
+
+SpatialIndex::Partition SpatialIndex::GetPartition(const IBaseComponent* pComponent)
+{
+    if (auto wire = dynamic_cast<const LogicWire*>(pComponent))
+    {
+        return (wire->GetDirection() == WireDirection::HORIZONTAL) ? Partition::HORIZONTAL_WIRES : Partition::VERTICAL_WIRES;
+    }
+
+    if (nullptr != dynamic_cast<const ConPoint*>(pComponent))
+    {
+        return Partition::CONPOINTS;
+    }
+
+    return Partition::COMPONENTS;
+}
+
+quint64 SpatialIndex::GetKey(int32_t pColumn, int32_t pRow)
+{
+    return (static_cast<quint64>(pColumn + KEY_INDEX_OFFSET) << 32) | static_cast<quint64>(pRow + KEY_INDEX_OFFSET);
+}
+
+int32_t SpatialIndex::GetCellIndex(double pCoordinate)
+{
+    return static_cast<int32_t>(std::floor(pCoordinate / canvas::SPATIAL_INDEX_CELL_SIZE));
+}
+
+bool SpatialIndex::IsStackedAbove(const IBaseComponent* pA, const IBaseComponent* pB) const
+{
+    Q_ASSERT(pA && pB);
+
+    if (pA->zValue() != pB->zValue())
+    {
+        return (pA->zValue() > pB->zValue());
+    }
+
+    const auto entryA = mEntries.find(pA);
+    const auto entryB = mEntries.find(pB);
+    Q_ASSERT(entryA != mEntries.end() && entryB != mEntries.end());
+
+    return (entryA->second.insertion > entryB->second.insertion);
+}
+
+uint64_t SpatialIndex::GetGeneration() const
+{
+    return mGeneration;
+}
+
+void SpatialIndex::UpdateCells(IBaseComponent* pComponent, const Entry& pEntry, bool pInsert)
+{
+    mGeneration++;
+
+    auto& cells = mCells[static_cast<size_t>(pEntry.partition)];
+
+    for (int32_t row = GetCellIndex(pEntry.rect.top()); row <= GetCellIndex(pEntry.rect.bottom()); row++)
+    {
+        for (int32_t column = GetCellIndex(pEntry.rect.left()); column <= GetCellIndex(pEntry.rect.right()); column++)
+        {
+            if (pInsert)
+            {
+                cells[GetKey(column, row)].push_back(CellEntry{pComponent, pEntry.rect});
+                continue;
+            }
+
+            const auto cell = cells.find(GetKey(column, row));
+            Q_ASSERT(cell != cells.end());
+
+            auto& entries = cell->second;
+            const auto entry = std::find_if(entries.begin(), entries.end(), [&](const CellEntry& pCellEntry)
+            {
+                return pCellEntry.component == pComponent;
+            });
+            Q_ASSERT(entry != entries.end());
+
+            // Swap with the last entry, the order within a cell doesn't matter
+            *entry = entries.back();
+            entries.pop_back();
+
+            if (entries.empty())
+            {
+                cells.erase(cell);
+            }
+        }
+    }
+}
+
+template<typename Visitor>
+void SpatialIndex::Query(Partition pPartition, const QRectF& pRect, bool pContained, Visitor pVisitor) const
+{
+    const auto& cells = mCells[static_cast<size_t>(pPartition)];
+
+    if (cells.empty())
+    {
+        return;
+    }
+
+    const auto visitCell = [&](quint64 pKey, const std::vector<CellEntry>& pEntries)
+    {
+        for (const auto& entry : pEntries)
+        {
+            if (pContained ? !Contains(pRect, entry.rect) : !Intersects(pRect, entry.rect))
+            {
+                continue;
+            }
+
+            // Only the cell containing the top left corner of the intersection reports the component
+            const auto referenceColumn = GetCellIndex(std::max(entry.rect.left(), pRect.left()));
+            const auto referenceRow = GetCellIndex(std::max(entry.rect.top(), pRect.top()));
+
+            if (GetKey(referenceColumn, referenceRow) == pKey)
+            {
+                pVisitor(entry.component);
+            }
+        }
+    };
+
+    const auto firstColumn = GetCellIndex(pRect.left());
+    const auto lastColumn = GetCellIndex(pRect.right());
+    const auto firstRow = GetCellIndex(pRect.top());
+    const auto lastRow = GetCellIndex(pRect.bottom());
+
+    // Large rectangles cover more cells than are occupied, then the occupied cells are searched instead
+    if (static_cast<int64_t>(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) > static_cast<int64_t>(cells.size()))
+    {
+        for (const auto& [key, entries] : cells)
+        {
+            visitCell(key, entries);
+        }
+        return;
+    }
+
+    for (int32_t row = firstRow; row <= lastRow; row++)
+    {
+        for (int32_t column = firstColumn; column <= lastColumn; column++)
+        {
+            const auto cell = cells.find(GetKey(column, row));
+
+            if (cell != cells.end())
+            {
+                visitCell(cell->first, cell->second);
+            }
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "HelperStructures.h"
+#include "SceneHelper.h"
+
+#include <QGraphicsScene>
+#include <QObject>
+#include <QRectF>
+#include <unordered_map>
+#include <vector>
+
+class IBaseComponent;
+class LogicWire;
+class ConPoint;
+
+///
+/// \brief The SpatialIndex class is a uniform grid index over the components of a scene, used by the editing logic.
+/// Horizontal wires, vertical wires, ConPoints and all other components are kept in separate partitions,
+/// so that typed queries neither test nor cast items of other types. Every component is stored with the
+/// bounding rectangle of its shape in all grid cells that rectangle touches. Rendering still uses the BSP tree of the scene.
+///
+class SpatialIndex : public QObject, public SceneHelper<SpatialIndex>
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the SpatialIndex
+    /// \param pScene: The scene containing the components, takes ownership of the index
+    SpatialIndex(QGraphicsScene* pScene);
+
+    /// \brief Adds a component to the index, or moves it to its current position if it is already indexed
+    /// \param pComponent: The component that has been added to the scene, moved or resized
+    void Update(IBaseComponent* pComponent);
+
+    /// \brief Removes a component from the index
+    /// \param pComponent: The component that is removed from the scene
+    void Remove(IBaseComponent* pComponent);
+
+    /// \brief Returns all wires of the given direction within the given rectangle
+    /// \param pRect: The rectangle in scene coordinates
+    /// \param pDirection: The direction of the wires, UNSET for both directions
+    /// \param pMode: Qt::ContainsItemShape or Qt::ContainsItemBoundingRect for wires completely inside the rectangle,
+    /// otherwise wires that intersect the rectangle
+    /// \return Vector of wires in no particular order
+    std::vector<LogicWire*> GetWires(const QRectF& pRect, WireDirection pDirection = WireDirection::UNSET,
+                                     Qt::ItemSelectionMode pMode = Qt::IntersectsItemShape) const;
+
+    /// \brief Returns all wires of the given direction at the given position
+    /// \param pPos: The position in scene coordinates
+    /// \param pDirection: The direction of the wires, UNSET for both directions
+    /// \return Vector of wires in no particular order
+    std::vector<LogicWire*> GetWires(QPointF pPos, WireDirection pDirection = WireDirection::UNSET) const;
+
+    /// \brief Returns all ConPoints at the given position
+    /// \param pPos: The position in scene coordinates
+    /// \return Vector of ConPoints in no particular order
+    std::vector<ConPoint*> GetConPoints(QPointF pPos) const;
+
+    /// \brief Returns all components that are neither wires nor ConPoints and intersect the given rectangle
+    /// \param pRect: The rectangle in scene coordinates, touching edges count as intersecting
+    /// \return Vector of components in no particular order
+    std::vector<IBaseComponent*> GetComponents(const QRectF& pRect) const;
+
+    /// \brief Returns whether the first component is drawn above the second one, like the stacking order of the scene
+    /// Components with a higher Z value are above, components with the same Z value are ordered by the time they were added
+    /// \param pA: An indexed component
+    /// \param pB: Another indexed component
+    /// \return True, if pA is stacked above pB
+    bool IsStackedAbove(const IBaseComponent* pA, const IBaseComponent* pB) const;
+
+    /// \brief Returns a counter that is incremented whenever a component is added, moved, resized or removed
+    /// \return The current generation of the index
+    uint64_t GetGeneration(void) const;
+
+protected:
+    /// \brief Partition contains the grid cells of one type of component
+    enum class Partition : uint8_t
+    {
+        HORIZONTAL_WIRES = 0,
+        VERTICAL_WIRES,
+        CONPOINTS,
+        COMPONENTS,
+        COUNT
+    };
+
+    /// \brief Entry contains the partition, the indexed rectangle and the insertion order of one component
+    struct Entry
+    {
+        Partition partition;
+        QRectF rect;
+        uint64_t insertion = 0; // Higher for components added later, which the scene stacks above those with the same Z value
+    };
+
+    /// \brief CellEntry contains one component of a grid cell, the rectangle is stored with it to avoid a lookup per test
+    struct CellEntry
+    {
+        IBaseComponent* component;
+        QRectF rect;
+    };
+
+    /// \brief Returns the partition the given component belongs to
+    /// \param pComponent: The component
+    /// \return The partition
+    static Partition GetPartition(const IBaseComponent* pComponent);
+
+    /// \brief Returns the key of the grid cell containing the given cell coordinates
+    /// \param pColumn: The column of the cell
+    /// \param pRow: The row of the cell
+    /// \return The cell key
+    static quint64 GetKey(int32_t pColumn, int32_t pRow);
+
+    /// \brief Returns the column or row of the grid cell containing the given coordinate
+    /// \param pCoordinate: An x or y coordinate in scene coordinates
+    /// \return The column or row
+    static int32_t GetCellIndex(double pCoordinate);
+
+    /// \brief Adds or removes the component in all cells its rectangle touches
+    /// \param pComponent: The component
+    /// \param pEntry: The partition and rectangle of the component
+    /// \param pInsert: If true, the component is added, otherwise it is removed
+    void UpdateCells(IBaseComponent* pComponent, const Entry& pEntry, bool pInsert);
+
+    /// \brief Returns all components of the given partition that match the given rectangle
+    /// Components spanning several cells are reported once, in the cell containing the top left corner
+    /// of their intersection with the rectangle
+    /// \param pPartition: The partition to search
+    /// \param pRect: The rectangle in scene coordinates
+    /// \param pContained: If true, only components completely inside the rectangle are returned
+    /// \param pVisitor: Called for every matching component
+    template<typename Visitor>
+    void Query(Partition pPartition, const QRectF& pRect, bool pContained, Visitor pVisitor) const;
+
+protected:
+    std::unordered_map<quint64, std::vector<CellEntry>> mCells[static_cast<size_t>(Partition::COUNT)];
+    std::unordered_map<const IBaseComponent*, Entry> mEntries;
+    uint64_t mGeneration = 0;
+    uint64_t mInsertionCount = 0;
+};
+
+#endif // SPATIALINDEX_H
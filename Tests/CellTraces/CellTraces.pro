@@ -0,0 +1,81 @@
+# Verifies all logic cells against their truth tables and the golden traces in golden/, run it with "make check"
+# After an intended behaviour change, record the golden traces again with "Linkuit_Studio --record-cell-traces Tests/CellTraces/golden"
+
+QT += core gui widgets
+
+CONFIG += c++14 console testcase
+CONFIG -= app_bundle
+
+TARGET = CellTraces
+
+ROOT = $${PWD}/../..
+
+FULL_VERSION = "$$cat($${ROOT}/version.txt)"
+DEFINES += FULL_VERSION='\\"$$FULL_VERSION\\"'
+DEFINES += CELL_TRACE_DIRECTORY='\\"$${PWD}/golden\\"'
+
+INCLUDEPATH += $${ROOT}
+
+HEADERS += \
+    $${ROOT}/Components/LogicBaseCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicCounterCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDMsFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDecoderCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDemultiplexerCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicEncoderCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicFullAdderCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicHalfAdderCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicJKFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicJkMsFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicMultiplexerCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicRsClockedFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicRsFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicRsMsFlipFlopCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicShiftRegisterCell.h \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicTFlipFlopCell.h \
+    $${ROOT}/Components/Gates/LogicCells/LogicAndGateCell.h \
+    $${ROOT}/Components/Gates/LogicCells/LogicBufferGateCell.h \
+    $${ROOT}/Components/Gates/LogicCells/LogicNotGateCell.h \
+    $${ROOT}/Components/Gates/LogicCells/LogicOrGateCell.h \
+    $${ROOT}/Components/Gates/LogicCells/LogicXorGateCell.h \
+    $${ROOT}/Components/Inputs/LogicCells/LogicButtonCell.h \
+    $${ROOT}/Components/Inputs/LogicCells/LogicClockCell.h \
+    $${ROOT}/Components/Inputs/LogicCells/LogicConstantCell.h \
+    $${ROOT}/Components/Inputs/LogicCells/LogicInputCell.h \
+    $${ROOT}/Components/Outputs/LogicCells/LogicOutputCell.h \
+    $${ROOT}/LogicCellTracer.h \
+    $${ROOT}/Configuration.h \
+    $${ROOT}/HelperFunctions.h \
+    $${ROOT}/HelperStructures.h
+
+SOURCES += \
+    $${ROOT}/Components/LogicBaseCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicCounterCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDMsFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDecoderCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicDemultiplexerCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicEncoderCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicFullAdderCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicHalfAdderCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicJKFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicJkMsFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicMultiplexerCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicRsClockedFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicRsFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicRsMsFlipFlopCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicShiftRegisterCell.cpp \
+    $${ROOT}/Components/ComplexLogic/LogicCells/LogicTFlipFlopCell.cpp \
+    $${ROOT}/Components/Gates/LogicCells/LogicAndGateCell.cpp \
+    $${ROOT}/Components/Gates/LogicCells/LogicBufferGateCell.cpp \
+    $${ROOT}/Components/Gates/LogicCells/LogicNotGateCell.cpp \
+    $${ROOT}/Components/Gates/LogicCells/LogicOrGateCell.cpp \
+    $${ROOT}/Components/Gates/LogicCells/LogicXorGateCell.cpp \
+    $${ROOT}/Components/Inputs/LogicCells/LogicButtonCell.cpp \
+    $${ROOT}/Components/Inputs/LogicCells/LogicClockCell.cpp \
+    $${ROOT}/Components/Inputs/LogicCells/LogicConstantCell.cpp \
+    $${ROOT}/Components/Inputs/LogicCells/LogicInputCell.cpp \
+    $${ROOT}/Components/Outputs/LogicCells/LogicOutputCell.cpp \
+    $${ROOT}/LogicCellTracer.cpp \
+    $${PWD}/main.cpp
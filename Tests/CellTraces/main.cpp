@@ -0,0 +1,7 @@
+#include "LogicCellTracer.h"
+
+int main()
+{
+    // Reports the failing truth tables and the first divergence of every mismatching trace on stderr
+    return LogicCellTracer().VerifyTraces(CELL_TRACE_DIRECTORY) ? 0 : 1;
+}
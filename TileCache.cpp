@@ -0,0 +1,212 @@
+#include "TileCache.h"
+#include "Configuration.h"
+#include "WireLayer.h"
+
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Column and row indices are stored with an offset, so that negative indices fit into the unsigned key
+constexpr int32_t KEY_INDEX_OFFSET = 1 << 23;
+}
+
+TileCache::TileCache(QGraphicsScene* pScene):
+    QObject(pScene),
+    mScene(pScene),
+    mTiles(canvas::TILE_CACHE_MAX_TILES)
+{
+    Q_ASSERT(mScene);
+}
+
+bool TileCache::IsActive(double pScale)
+{
+    return (pScale < canvas::TILE_CACHE_MAX_LOD);
+}
+
+void TileCache::SetActive(bool pIsActive)
+{
+    if (pIsActive == mIsActive)
+    {
+        return;
+    }
+
+    mIsActive = pIsActive;
+
+    // Any connection to QGraphicsScene::changed routes all view updates through the signal, bypassing the
+    // dirty region tracking of the views, so changes are only tracked while the scene is drawn from the tiles
+    if (mIsActive)
+    {
+        MarkAllOutdated(); // Changes while inactive have not been tracked
+        QObject::connect(mScene, &QGraphicsScene::changed, this, &TileCache::OnSceneChanged);
+    }
+    else
+    {
+        QObject::disconnect(mScene, &QGraphicsScene::changed, this, &TileCache::OnSceneChanged);
+        RestoreDirectViewUpdates(mScene); // Disconnecting alone leaves the views connected to the signal
+    }
+}
+
+bool TileCache::Paint(QPainter* pPainter, const QRectF& pRect, double pScale)
+{
+    Q_ASSERT(pPainter);
+
+    const auto level = GetLevel(pScale);
+    const double tileSize = canvas::TILE_SIZE / GetLevelScale(level);
+    const auto rect = pRect.intersected(mScene->sceneRect());
+
+    if (rect.isEmpty())
+    {
+        return true;
+    }
+
+    const auto firstColumn = static_cast<int32_t>(std::floor(rect.left() / tileSize));
+    const auto lastColumn = static_cast<int32_t>(std::floor(rect.right() / tileSize));
+    const auto firstRow = static_cast<int32_t>(std::floor(rect.top() / tileSize));
+    const auto lastRow = static_cast<int32_t>(std::floor(rect.bottom() / tileSize));
+
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+
+    bool isComplete = true;
+
+    for (int32_t row = firstRow; row <= lastRow; row++)
+    {
+        for (int32_t column = firstColumn; column <= lastColumn; column++)
+        {
+            const auto key = GetKey(level, column, row);
+            auto tile = mTiles.object(key);
+
+            if (nullptr == tile || tile->isOutdated)
+            {
+                if (renderTimer.elapsed() < canvas::TILE_RENDER_BUDGET.count())
+                {
+                    if (nullptr == tile)
+                    {
+                        tile = new Tile();
+                        mTiles.insert(key, tile);
+                    }
+
+                    tile->image = RenderTile(level, column, row);
+                    tile->isOutdated = false;
+                }
+                else
+                {
+                    isComplete = false; // Outdated tiles are drawn until they are rendered in one of the next frames
+                }
+            }
+
+            if (nullptr != tile)
+            {
+                pPainter->drawImage(QRectF(column * tileSize, row * tileSize, tileSize, tileSize), tile->image);
+            }
+        }
+    }
+
+    return isComplete;
+}
+
+void TileCache::Clear()
+{
+    mTiles.clear();
+}
+
+void TileCache::MarkAllOutdated()
+{
+    for (const auto& key : mTiles.keys())
+    {
+        mTiles.object(key)->isOutdated = true;
+    }
+}
+
+void TileCache::OnSceneChanged(const QList<QRectF>& pRegion)
+{
+    if (mTiles.isEmpty())
+    {
+        return;
+    }
+
+    if (pRegion.isEmpty())
+    {
+        MarkAllOutdated();
+        return;
+    }
+
+    for (const auto& changedRect : pRegion)
+    {
+        for (uint8_t level = 0; level < canvas::TILE_CACHE_LEVEL_COUNT; level++)
+        {
+            const double tileSize = canvas::TILE_SIZE / GetLevelScale(level);
+            const double margin = 1 / GetLevelScale(level); // Antialiased edges reach into the neighboring pixel
+
+            const auto firstColumn = static_cast<int32_t>(std::floor((changedRect.left() - margin) / tileSize));
+            const auto lastColumn = static_cast<int32_t>(std::floor((changedRect.right() + margin) / tileSize));
+            const auto firstRow = static_cast<int32_t>(std::floor((changedRect.top() - margin) / tileSize));
+            const auto lastRow = static_cast<int32_t>(std::floor((changedRect.bottom() + margin) / tileSize));
+
+            // Large changes like loading a circuit touch more tiles than are cached
+            if (static_cast<int64_t>(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) > mTiles.count())
+            {
+                MarkAllOutdated();
+                return;
+            }
+
+            for (int32_t row = firstRow; row <= lastRow; row++)
+            {
+                for (int32_t column = firstColumn; column <= lastColumn; column++)
+                {
+                    if (auto tile = mTiles.object(GetKey(level, column, row)))
+                    {
+                        tile->isOutdated = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint8_t TileCache::GetLevel(double pScale)
+{
+    Q_ASSERT(pScale > 0);
+
+    const auto level = static_cast<int32_t>(std::floor(std::log2(canvas::TILE_CACHE_BASE_SCALE / pScale)));
+    return std::clamp(level, 0, canvas::TILE_CACHE_LEVEL_COUNT - 1);
+}
+
+double TileCache::GetLevelScale(uint8_t pLevel)
+{
+    return canvas::TILE_CACHE_BASE_SCALE / (1 << pLevel);
+}
+
+quint64 TileCache::GetKey(uint8_t pLevel, int32_t pColumn, int32_t pRow)
+{
+    return (static_cast<quint64>(pLevel) << 48)
+            | (static_cast<quint64>(pColumn + KEY_INDEX_OFFSET) << 24)
+            | static_cast<quint64>(pRow + KEY_INDEX_OFFSET);
+}
+
+QImage TileCache::RenderTile(uint8_t pLevel, int32_t pColumn, int32_t pRow) const
+{
+    const double scale = GetLevelScale(pLevel);
+    const double tileSize = canvas::TILE_SIZE / scale;
+    const QRectF sourceRect(pColumn * tileSize, pRow * tileSize, tileSize, tileSize);
+
+    QImage image(canvas::TILE_SIZE, canvas::TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    painter.scale(scale, scale);
+    painter.translate(-sourceRect.topLeft());
+
+    // Wires are drawn by the wire layer and not by their items, the layer only visits the wires within the tile
+    if (auto layer = WireLayer::FromScene(mScene))
+    {
+        layer->Paint(&painter, sourceRect);
+    }
+
+    mScene->render(&painter, sourceRect, sourceRect, Qt::IgnoreAspectRatio);
+
+    return image;
+}
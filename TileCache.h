@@ -0,0 +1,93 @@
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include "SceneHelper.h"
+
+#include <QCache>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QObject>
+#include <QPainter>
+
+///
+/// \brief The TileCache class draws the scene at coarse zoom levels from a pyramid of prerendered image tiles.
+/// Every level of the pyramid has half the scale of the previous one, the view draws from the finest level
+/// that is not coarser than its own scale. Tiles are rendered when they become visible and are marked as outdated
+/// when the scene changes within them, outdated tiles are drawn until they have been rendered again.
+/// Scene changes are only observed while the view draws from the cache.
+///
+class TileCache : public QObject, public SceneHelper<TileCache>
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the TileCache
+    /// \param pScene: The scene to render, takes ownership of the cache
+    TileCache(QGraphicsScene* pScene);
+
+    /// \brief Returns whether the scene should be drawn from the cache at the given scale
+    /// \param pScale: The scale of the view
+    /// \return True, if the scale is below the level of detail for tiles
+    static bool IsActive(double pScale);
+
+    /// \brief Starts or stops tracking scene changes, the view calls it with the result of IsActive() on every paint
+    /// While inactive, the scene is not observed, the views are updated directly and all tiles are marked as outdated on activation
+    /// \param pIsActive: True, if the scene is drawn from the cache
+    void SetActive(bool pIsActive);
+
+    /// \brief Draws the tiles that intersect the given rectangle, missing and outdated tiles are rendered within the time budget
+    /// \param pPainter: The painter to use, transformed to scene coordinates
+    /// \param pRect: The exposed rectangle in scene coordinates
+    /// \param pScale: The scale of the view
+    /// \return False, if some tiles are still missing or outdated and another paint is needed
+    bool Paint(QPainter* pPainter, const QRectF& pRect, double pScale);
+
+    /// \brief Removes all tiles
+    void Clear(void);
+
+protected slots:
+    /// \brief Marks all tiles within the changed areas as outdated
+    /// \param pRegion: The changed areas in scene coordinates
+    void OnSceneChanged(const QList<QRectF>& pRegion);
+
+protected:
+    /// \brief Tile contains the rendered image of one tile
+    struct Tile
+    {
+        QImage image;
+        bool isOutdated = false;
+    };
+
+    /// \brief Marks all cached tiles as outdated
+    void MarkAllOutdated(void);
+
+    /// \brief Returns the pyramid level to draw from at the given scale
+    /// \param pScale: The scale of the view
+    /// \return The level, 0 is the finest level
+    static uint8_t GetLevel(double pScale);
+
+    /// \brief Returns the scale of the given pyramid level
+    /// \param pLevel: The level
+    /// \return The scale of the tiles of that level
+    static double GetLevelScale(uint8_t pLevel);
+
+    /// \brief Returns the key of the given tile in the cache
+    /// \param pLevel: The pyramid level
+    /// \param pColumn: The column of the tile
+    /// \param pRow: The row of the tile
+    /// \return The cache key
+    static quint64 GetKey(uint8_t pLevel, int32_t pColumn, int32_t pRow);
+
+    /// \brief Renders the wires and items within the given tile
+    /// \param pLevel: The pyramid level
+    /// \param pColumn: The column of the tile
+    /// \param pRow: The row of the tile
+    /// \return The rendered tile image
+    QImage RenderTile(uint8_t pLevel, int32_t pColumn, int32_t pRow) const;
+
+protected:
+    QGraphicsScene* mScene;
+    QCache<quint64, Tile> mTiles;
+    bool mIsActive = false;
+};
+
+#endif // TILECACHE_H
@@ -4,6 +4,18 @@
 #include <QtWidgets>
 #include <QtMath>
 
+/// \brief Returns the profiled activity of the given component, shown by the heatmap
+/// \param pComponent: The component
+/// \return The sum of evaluations and input events, or 0 if the component isn't profiled
+static uint64_t GetActivity(IBaseComponent* pComponent)
+{
+    if (nullptr == pComponent->GetLogicCell() || nullptr == pComponent->GetLogicCell()->GetProfile())
+    {
+        return 0;
+    }
+    return pComponent->GetLogicCell()->GetProfile()->evaluations + pComponent->GetLogicCell()->GetProfile()->inputEvents;
+}
+
 GraphicsView::GraphicsView(View &pView, CoreLogic &pCoreLogic):
     QGraphicsView(),
     mView(pView),
@@ -192,6 +204,276 @@ void GraphicsView::mouseMoveEvent(QMouseEvent *pEvent)
     QGraphicsView::mouseMoveEvent(pEvent);
 }
 
+void GraphicsView::UpdateRenderStatisticsOverlay()
+{
+    if (!mRenderStatisticsRect.isEmpty())
+    {
+        mIsOverlayUpdateRequested = true;
+        viewport()->update(mRenderStatisticsRect);
+    }
+}
+
+void GraphicsView::SetRenderStatistics(RenderStatistics *pStatistics)
+{
+    mRenderStatistics = pStatistics;
+}
+
+void GraphicsView::UpdateVisibleRect()
+{
+    const auto visibleRect = mapToScene(viewport()->rect()).boundingRect();
+
+    if (auto tracker = ViewportTracker::FromScene(scene()))
+    {
+        tracker->SetVisibleRect(visibleRect);
+    }
+
+    if (auto minimap = mView.GetMinimap())
+    {
+        minimap->SetViewportRect(visibleRect);
+    }
+}
+
+void GraphicsView::UpdateHeatmapScale()
+{
+    mHeatmapMaxActivity = 0;
+
+    const auto tracker = ViewportTracker::FromScene(scene());
+    if (nullptr == tracker || tracker->GetVisibleRect().isNull())
+    {
+        return;
+    }
+
+    for (const auto& item : scene()->items(tracker->GetVisibleRect()))
+    {
+        if (nullptr != dynamic_cast<IBaseComponent*>(item))
+        {
+            mHeatmapMaxActivity = std::max(mHeatmapMaxActivity, GetActivity(static_cast<IBaseComponent*>(item)));
+        }
+    }
+}
+
+void GraphicsView::scrollContentsBy(int pDx, int pDy)
+{
+    QGraphicsView::scrollContentsBy(pDx, pDy);
+    UpdateVisibleRect();
+}
+
+void GraphicsView::resizeEvent(QResizeEvent *pEvent)
+{
+    QGraphicsView::resizeEvent(pEvent);
+    UpdateVisibleRect();
+}
+
+void GraphicsView::paintEvent(QPaintEvent *pEvent)
+{
+    const auto statistics = mRenderStatistics;
+
+    if (nullptr == statistics || !statistics->IsEnabled())
+    {
+        PaintScene(pEvent);
+        return;
+    }
+
+    // The periodic refresh of the overlay only repaints the overlay area, it would otherwise be recorded as a tiny frame
+    const bool isOverlayRefresh = mIsOverlayUpdateRequested && mRenderStatisticsRect.contains(pEvent->region().boundingRect());
+    mIsOverlayUpdateRequested = false;
+
+    if (isOverlayRefresh)
+    {
+        PaintScene(pEvent);
+        statistics->DiscardPaintCalls();
+        DrawRenderStatisticsOverlay(*statistics);
+        return;
+    }
+
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+
+    PaintScene(pEvent);
+
+    const std::chrono::nanoseconds paintTime(paintTimer.nsecsElapsed());
+
+    uint64_t dirtyArea = 0;
+    for (const auto &rect : pEvent->region())
+    {
+        dirtyArea += static_cast<uint64_t>(rect.width()) * rect.height();
+    }
+
+    DrawRenderStatisticsOverlay(*statistics); // Not part of the measured paint time
+    statistics->FinishFrame(paintTime, dirtyArea, mCoreLogic.GetSimulationTick());
+}
+
+void GraphicsView::PaintScene(QPaintEvent *pEvent)
+{
+    const auto tileCache = TileCache::FromScene(scene());
+    const double scale = transform().m11();
+
+    if (nullptr != tileCache)
+    {
+        tileCache->SetActive(TileCache::IsActive(scale));
+    }
+
+    if (nullptr == tileCache || !TileCache::IsActive(scale))
+    {
+        QGraphicsView::paintEvent(pEvent);
+        return;
+    }
+
+    QPainter painter(viewport());
+    painter.setRenderHints(renderHints());
+    painter.setClipRect(pEvent->rect());
+
+    const auto exposedRect = mapToScene(pEvent->rect()).boundingRect();
+    painter.setWorldTransform(viewportTransform());
+
+    QGraphicsView::drawBackground(&painter, exposedRect); // The tiles contain the wires
+
+    if (!tileCache->Paint(&painter, exposedRect, scale))
+    {
+        viewport()->update(); // Render the remaining tiles in the next frame
+    }
+
+    drawForeground(&painter, exposedRect);
+
+    if (dragMode() == QGraphicsView::RubberBandDrag && !rubberBandRect().isEmpty())
+    {
+        painter.resetTransform();
+
+        QStyleOptionRubberBand option;
+        option.initFrom(viewport());
+        option.rect = rubberBandRect();
+        option.shape = QRubberBand::Rectangle;
+
+        QStyleHintReturnMask mask;
+        if (viewport()->style()->styleHint(QStyle::SH_RubberBand_Mask, &option, viewport(), &mask))
+        {
+            painter.setClipRegion(mask.region, Qt::IntersectClip);
+        }
+
+        viewport()->style()->drawControl(QStyle::CE_RubberBand, &option, &painter, viewport());
+    }
+}
+
+void GraphicsView::DrawRenderStatisticsOverlay(const RenderStatistics &pStatistics)
+{
+    const auto frame = pStatistics.GetLastFrame();
+
+    if (nullptr == frame)
+    {
+        return;
+    }
+
+    // The component classes with the most paint calls, the remaining ones are summed up
+    auto paintCalls = frame->paintCalls;
+    std::sort(paintCalls.begin(), paintCalls.end(), [](const auto &pA, const auto &pB)
+    {
+        return pA.second > pB.second;
+    });
+
+    QStringList paintCallsPerClass;
+    uint32_t otherPaintCalls = 0;
+
+    for (size_t i = 0; i < paintCalls.size(); i++)
+    {
+        if (i < profiling::RENDER_STATISTICS_MAX_LISTED_CLASSES)
+        {
+            paintCallsPerClass << QString("  %0: %1").arg(paintCalls[i].first->className()).arg(paintCalls[i].second);
+        }
+        else
+        {
+            otherPaintCalls += paintCalls[i].second;
+        }
+    }
+
+    if (otherPaintCalls > 0)
+    {
+        paintCallsPerClass << QString("  Other: %0").arg(otherPaintCalls);
+    }
+
+    QStringList lines;
+    lines << QString("Paint time: %0 ms").arg(frame->paintTime.count() / 1000.0, 0, 'f', 2)
+          << QString("Frame interval: %0 ms").arg(frame->frameInterval.count() / 1000.0, 0, 'f', 2)
+          << QString("Dirty region: %0 px").arg(frame->dirtyArea)
+          << QString("Update requests: %0").arg(frame->updateRequests)
+          << QString("Simulation ticks: %0 (%1 ms)").arg(frame->simulationTicks).arg(frame->simulationTime.count() / 1000.0, 0, 'f', 2)
+          << QString("Paint calls: %0").arg(frame->GetTotalPaintCalls());
+    lines << paintCallsPerClass;
+
+    QPainter painter(viewport());
+
+    const QFontMetrics metrics(painter.font());
+    int32_t textWidth = 0;
+
+    for (const auto &line : lines)
+    {
+        textWidth = std::max(textWidth, metrics.horizontalAdvance(line));
+    }
+
+    constexpr int32_t margin = 8;
+    mRenderStatisticsRect = QRect(margin, margin, textWidth + 2 * margin, lines.size() * metrics.height() + 2 * margin);
+
+    painter.fillRect(mRenderStatisticsRect, profiling::RENDER_STATISTICS_BACKGROUND_COLOR);
+    painter.setPen(profiling::RENDER_STATISTICS_TEXT_COLOR);
+    painter.drawText(mRenderStatisticsRect.adjusted(margin, margin, -margin, -margin), Qt::AlignLeft | Qt::AlignTop, lines.join('\n'));
+}
+
+void GraphicsView::drawBackground(QPainter *pPainter, const QRectF &pRect)
+{
+    QGraphicsView::drawBackground(pPainter, pRect);
+    mView.DrawGrid(pPainter, pRect);
+
+    // Wires have the lowest stacking order, so drawing them with the background keeps them below all other components
+    if (auto layer = WireLayer::FromScene(scene()))
+    {
+        layer->Paint(pPainter, pRect);
+    }
+}
+
+void GraphicsView::drawForeground(QPainter *pPainter, const QRectF &pRect)
+{
+    QGraphicsView::drawForeground(pPainter, pRect);
+
+    if (!mCoreLogic.IsProfilingEnabled() || !mCoreLogic.IsSimulationRunning())
+    {
+        return;
+    }
+
+    if (mHeatmapMaxActivity == 0)
+    {
+        return;
+    }
+
+    pPainter->save();
+    pPainter->setPen(Qt::NoPen);
+
+    for (const auto& item : scene()->items(pRect))
+    {
+        if (nullptr == dynamic_cast<IBaseComponent*>(item))
+        {
+            continue;
+        }
+
+        const auto itemActivity = GetActivity(static_cast<IBaseComponent*>(item));
+        if (itemActivity == 0)
+        {
+            continue;
+        }
+
+        // Logarithmic scale, because a few hot cells would otherwise dominate the whole map
+        const double heat = std::min(1.0, std::log1p(itemActivity) / std::log1p(mHeatmapMaxActivity));
+        const QColor color = QColor::fromRgbF(
+            profiling::HEATMAP_COLD_COLOR.redF() + heat * (profiling::HEATMAP_HOT_COLOR.redF() - profiling::HEATMAP_COLD_COLOR.redF()),
+            profiling::HEATMAP_COLD_COLOR.greenF() + heat * (profiling::HEATMAP_HOT_COLOR.greenF() - profiling::HEATMAP_COLD_COLOR.greenF()),
+            profiling::HEATMAP_COLD_COLOR.blueF() + heat * (profiling::HEATMAP_HOT_COLOR.blueF() - profiling::HEATMAP_COLD_COLOR.blueF()),
+            profiling::HEATMAP_COLD_COLOR.alphaF() + heat * (profiling::HEATMAP_HOT_COLOR.alphaF() - profiling::HEATMAP_COLD_COLOR.alphaF()));
+
+        pPainter->setBrush(color);
+        pPainter->drawRect(item->sceneBoundingRect());
+    }
+
+    pPainter->restore();
+}
+
 void GraphicsView::mouseDoubleClickEvent(QMouseEvent *pEvent)
 {
     Q_UNUSED(pEvent);
@@ -211,7 +493,10 @@ void View::Init()
 {
     setFrameStyle(QFrame::Plain | QFrame::NoFrame);
 
+    // No CacheBackground, because the wire layer is drawn with the background and changes while simulating
     //mGraphicsView.setCacheMode(QGraphicsView::CacheBackground);
+    mGraphicsView.setBackgroundBrush(canvas::BACKGROUND_COLOR);
+    CreateGridPens();
 #warning assess if SmoothPixmapTransform is neccessary / impacts performance
     mGraphicsView.setRenderHints(QPainter::SmoothPixmapTransform | QPainter::Antialiasing);
     mGraphicsView.setDragMode(QGraphicsView::RubberBandDrag);
@@ -246,6 +531,9 @@ void View::Init()
 
     QObject::connect(mPieMenu, &PieMenu::ButtonClickedSignal, this, &View::OnPieMenuButtonClicked);
 
+    mMinimap = new Minimap(mGraphicsView);
+    mMinimap->hide();
+
     mMainLayout = new QGridLayout();
     mMainLayout->setContentsMargins(0, 0, 0, 0);
     mMainLayout->setSpacing(0);
@@ -263,15 +551,60 @@ void View::Init()
     QObject::connect(&mCoreLogic, &CoreLogic::SimulationStartSignal, this, &View::OnSimulationStart);
     QObject::connect(&mCoreLogic, &CoreLogic::SimulationStopSignal, this, &View::OnSimulationStop);
 
+    QObject::connect(&mHeatmapTimer, &QTimer::timeout, this, [&]()
+    {
+        if (mCoreLogic.IsProfilingEnabled())
+        {
+            mGraphicsView.UpdateHeatmapScale();
+            mGraphicsView.viewport()->update();
+        }
+    });
+
+    QObject::connect(&mRenderStatisticsTimer, &QTimer::timeout, &mGraphicsView, &GraphicsView::UpdateRenderStatisticsOverlay);
+
     SetupMatrix();
 }
 
 void View::SetScene(QGraphicsScene &pScene)
 {
     mScene = &pScene;
+
+    if (nullptr == WireLayer::FromScene(&pScene))
+    {
+        new WireLayer(&pScene); // Owned by the scene
+    }
+
+    if (nullptr == TileCache::FromScene(&pScene))
+    {
+        new TileCache(&pScene); // Owned by the scene
+    }
+
+    if (nullptr == RenderStatistics::FromScene(&pScene))
+    {
+        new RenderStatistics(&pScene); // Owned by the scene
+    }
+    mGraphicsView.SetRenderStatistics(RenderStatistics::FromScene(&pScene));
+
+    if (nullptr == ViewportTracker::FromScene(&pScene))
+    {
+        new ViewportTracker(&pScene); // Owned by the scene
+    }
+
+    if (nullptr == SpatialIndex::FromScene(&pScene))
+    {
+        new SpatialIndex(&pScene); // Owned by the scene
+    }
+
     mGraphicsView.setScene(&pScene);
     mGraphicsView.centerOn(0, 0);
 
+    if (nullptr != mMinimap)
+    {
+        mMinimap->SetScene(&pScene);
+    }
+
+    mGraphicsView.UpdateVisibleRect();
+
     QTimer::singleShot(0, &mGraphicsView, [&]()
     {
         mGraphicsView.setFocus();
@@ -290,14 +623,121 @@ QList<QGraphicsItem*> View::Components(void) const
     return mScene->items();
 }
 
+void View::BeginBulkUpdate()
+{
+    Q_ASSERT(mScene);
+
+    if (mBulkUpdateDepth++ > 0)
+    {
+        return;
+    }
+
+    // Without an index, adding and removing items does not update the BSP tree for every single item
+    mBulkUpdateIndexMethod = mScene->itemIndexMethod();
+    mBulkUpdateSelection = mScene->selectedItems();
+    mScene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    mScene->blockSignals(true);
+}
+
+void View::EndBulkUpdate()
+{
+    Q_ASSERT(mScene);
+    Q_ASSERT(mBulkUpdateDepth > 0);
+
+    if (--mBulkUpdateDepth > 0)
+    {
+        return;
+    }
+
+    mScene->blockSignals(false);
+    mScene->setItemIndexMethod(mBulkUpdateIndexMethod); // Rebuilds the index once for all items
+
+    // Signals during the bulk update have been suppressed, they are emitted once for all changes
+    if (mScene->selectedItems() != mBulkUpdateSelection)
+    {
+        emit mScene->selectionChanged();
+    }
+    mBulkUpdateSelection.clear();
+
+    mScene->update(); // Emits changed() for the whole scene
+}
+
+void View::RemoveAllComponents()
+{
+    Q_ASSERT(mScene);
+
+    BeginBulkUpdate();
+
+    // Ascending stacking order is the insertion order, so every item is found at the front of the scene's item lists
+    for (const auto& item : mScene->items(Qt::AscendingOrder))
+    {
+        if (nullptr == item->parentItem())
+        {
+            mScene->removeItem(item); // Removes the children as well
+        }
+    }
+
+    EndBulkUpdate();
+}
+
+void View::FitSceneRect()
+{
+    Q_ASSERT(mScene);
+
+    const auto itemsRect = mScene->itemsBoundingRect();
+
+    if (canvas::DIMENSIONS.contains(itemsRect))
+    {
+        mScene->setSceneRect(canvas::DIMENSIONS);
+        return;
+    }
+
+    const QMarginsF margins(canvas::SCENE_RECT_MARGIN, canvas::SCENE_RECT_MARGIN, canvas::SCENE_RECT_MARGIN, canvas::SCENE_RECT_MARGIN);
+    mScene->setSceneRect(canvas::DIMENSIONS.united(itemsRect.marginsAdded(margins)).intersected(canvas::MAX_DIMENSIONS));
+}
+
+void View::SetRenderStatisticsEnabled(bool pEnabled)
+{
+    const auto statistics = RenderStatistics::FromScene(mScene);
+    Q_ASSERT(statistics);
+
+    statistics->SetEnabled(pEnabled);
+
+    if (pEnabled)
+    {
+        mRenderStatisticsTimer.start(profiling::RENDER_STATISTICS_REFRESH_INTERVAL);
+    }
+    else
+    {
+        mRenderStatisticsTimer.stop();
+        mGraphicsView.UpdateRenderStatisticsOverlay(); // Remove the overlay
+    }
+}
+
+void View::SetMinimapVisible(bool pVisible)
+{
+    mMinimap->setVisible(pVisible);
+}
+
+void View::SetMinimapStateTinted(bool pTinted)
+{
+    mMinimap->SetStateTinted(pTinted);
+    mMinimap->SetSimulationRunning(mCoreLogic.IsSimulationRunning());
+}
+
 void View::OnSimulationStart()
 {
     mGraphicsView.setDragMode(QGraphicsView::NoDrag);
+    mHeatmapTimer.start(profiling::HEATMAP_REFRESH_INTERVAL);
+    mMinimap->SetSimulationRunning(true);
 }
 
 void View::OnSimulationStop()
 {
     mGraphicsView.setDragMode(QGraphicsView::RubberBandDrag);
+    mHeatmapTimer.stop();
+    mGraphicsView.viewport()->update(); // Remove the heatmap
+    mMinimap->SetSimulationRunning(false);
 }
 
 void View::SetupMatrix()
@@ -308,7 +748,7 @@ void View::SetupMatrix()
     matrix.scale(scale, scale);
 
     mGraphicsView.setTransform(matrix);
-    mGraphicsView.setBackgroundBrush(DrawGridPattern(mZoomLevel));
+    mGraphicsView.UpdateVisibleRect();
 
     emit ZoomLevelChangedSignal(scale * 100, mZoomLevel);
 }
@@ -332,6 +772,12 @@ int32_t View::GetZoomLevel()
     return mZoomLevel;
 }
 
+bool View::ExportRenderStatisticsCsv(const QString &pFilePath) const
+{
+    const auto statistics = RenderStatistics::FromScene(mScene);
+    return (nullptr != statistics && statistics->ExportCsv(pFilePath));
+}
+
 void View::UpdatePieMenuIcons()
 {
     mPieMenu->SetButtonIcon(0, mCoreLogic.GetControlMode() == ControlMode::WIRE ? QImage(":/images/icons/material_symbols/arrow_selector_tool_FILL1_wght400_GRAD0_opsz24.svg") :
@@ -406,6 +852,11 @@ PieMenu* View::GetPieMenu()
     return mPieMenu;
 }
 
+Minimap* View::GetMinimap()
+{
+    return mMinimap;
+}
+
 void View::ResetViewport()
 {
     SetZoom(canvas::DEFAULT_ZOOM_LEVEL);
@@ -432,35 +883,72 @@ void View::ZoomOut(int32_t pAmount)
     emit ZoomLevelChangedSignal(std::pow(2, (mZoomLevel - canvas::DEFAULT_ZOOM_LEVEL) / 50.0f) * 100, mZoomLevel);
 }
 
-QPixmap View::DrawGridPattern(int32_t pZoomLevel)
+void View::CreateGridPens()
 {
-    QPixmap pixmap(canvas::GRID_SIZE, canvas::GRID_SIZE);
-    QPainter painter;
-
-    pixmap.fill(canvas::BACKGROUND_COLOR);
+    mGridPens.clear();
+    mGridPens.reserve(canvas::MAX_ZOOM_LEVEL - canvas::MIN_ZOOM_LEVEL + 1);
 
-    if (pZoomLevel < canvas::MIN_GRID_ZOOM_LEVEL)
+    for (int32_t zoomLevel = canvas::MIN_ZOOM_LEVEL; zoomLevel <= canvas::MAX_ZOOM_LEVEL; zoomLevel++)
     {
-        return pixmap;
+        if (zoomLevel < canvas::MIN_GRID_ZOOM_LEVEL)
+        {
+            mGridPens.push_back(QPen(Qt::NoPen));
+            continue;
+        }
+
+        QColor color(canvas::GRID_COLOR);
+
+        if (zoomLevel < canvas::MIN_GRID_ZOOM_LEVEL + 20)
+        {
+            color.setAlpha(((zoomLevel - canvas::MIN_GRID_ZOOM_LEVEL) * 255) / 20.0f);
+        }
+
+        mGridPens.push_back(QPen(color, 1)); // Drawn in device pixels, so the width doesn't depend on the zoom level
     }
+}
+
+void View::DrawGrid(QPainter *pPainter, const QRectF &pRect)
+{
+    Q_ASSERT(pPainter);
+    Q_ASSERT(mZoomLevel >= canvas::MIN_ZOOM_LEVEL && mZoomLevel <= canvas::MAX_ZOOM_LEVEL);
+    Q_ASSERT(mGridPens.size() == static_cast<size_t>(canvas::MAX_ZOOM_LEVEL - canvas::MIN_ZOOM_LEVEL + 1));
 
-    painter.begin(&pixmap);
+    const auto &pen = mGridPens[mZoomLevel - canvas::MIN_ZOOM_LEVEL];
 
-    if (pZoomLevel < canvas::MIN_GRID_ZOOM_LEVEL + 20)
+    if (pen.style() == Qt::NoPen)
     {
-        QColor color(canvas::GRID_COLOR);
-        color.setAlpha(((pZoomLevel - canvas::MIN_GRID_ZOOM_LEVEL) * 255) / 20.0f);
+        return;
+    }
+
+    const auto transform = pPainter->worldTransform();
+    const auto deviceRect = transform.mapRect(pRect);
+
+    const auto firstColumn = static_cast<int64_t>(std::floor(pRect.left() / canvas::GRID_SIZE));
+    const auto lastColumn = static_cast<int64_t>(std::floor(pRect.right() / canvas::GRID_SIZE));
+    const auto firstRow = static_cast<int64_t>(std::floor(pRect.top() / canvas::GRID_SIZE));
+    const auto lastRow = static_cast<int64_t>(std::floor(pRect.bottom() / canvas::GRID_SIZE));
 
-        painter.setPen(QPen(color, 2 / std::pow(2, (mZoomLevel - canvas::DEFAULT_ZOOM_LEVEL) / 50.0f)));
+    mGridLines.clear();
+
+    // Line positions are rounded to whole pixels, so that the aliased lines stay sharp at every zoom level
+    for (auto column = firstColumn; column <= lastColumn; column++)
+    {
+        const double x = std::round(transform.map(QPointF(column * canvas::GRID_SIZE, 0)).x());
+        mGridLines.emplace_back(x, deviceRect.top(), x, deviceRect.bottom());
     }
-    else
+
+    for (auto row = firstRow; row <= lastRow; row++)
     {
-        painter.setPen(QPen(canvas::GRID_COLOR, 2 / std::pow(2, (mZoomLevel - canvas::DEFAULT_ZOOM_LEVEL) / 50.0f)));
+        const double y = std::round(transform.map(QPointF(0, row * canvas::GRID_SIZE)).y());
+        mGridLines.emplace_back(deviceRect.left(), y, deviceRect.right(), y);
     }
-    painter.drawLine(0, 0, canvas::GRID_SIZE - 1, 0);
-    painter.drawLine(0, 0, 0, canvas::GRID_SIZE - 1);
 
-    return pixmap;
+    pPainter->save();
+    pPainter->resetTransform();
+    pPainter->setRenderHint(QPainter::Antialiasing, false);
+    pPainter->setPen(pen);
+    pPainter->drawLines(mGridLines.data(), static_cast<int>(mGridLines.size()));
+    pPainter->restore();
 }
 
 void View::FadeInProcessingOverlay()
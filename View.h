@@ -4,7 +4,13 @@
 #include "CoreLogic.h"
 #include "Configuration.h"
 
+#include "WireLayer.h"
+#include "TileCache.h"
+#include "RenderStatistics.h"
+#include "ViewportTracker.h"
+#include "SpatialIndex.h"
 #include "Gui/PieMenu.h"
+#include "Gui/Minimap.h"
 #include "QtAwesome.h"
 
 #include <QFrame>
@@ -15,6 +21,8 @@
 #include <QButtonGroup>
 #include <QGroupBox>
 #include <QGridLayout>
+#include <QTimer>
+#include <vector>
 
 // forward declarations
 QT_BEGIN_NAMESPACE
@@ -37,6 +45,19 @@ public:
     /// \param pCoreLogic: Reference to the core logic
     GraphicsView(View &pView, CoreLogic &pCoreLogic);
 
+    /// \brief Repaints the area of the render statistics overlay, the repaint is not recorded as a frame
+    void UpdateRenderStatisticsOverlay(void);
+
+    /// \brief Setter for the render statistics of the scene, which are looked up once instead of on every paint
+    /// \param pStatistics: The render statistics of the scene, or nullptr
+    void SetRenderStatistics(RenderStatistics *pStatistics);
+
+    /// \brief Passes the area of the scene that is visible in the viewport to the viewport tracker of the scene
+    void UpdateVisibleRect(void);
+
+    /// \brief Determines the highest activity of the visible components, which the heatmap colors are normalized to
+    void UpdateHeatmapScale(void);
+
 signals:
     /// \brief Emitted when the left mouse button is pressed without the CTRL key being down
     /// \param pMappedPos: The mouse position mapped onto the scene
@@ -69,10 +90,47 @@ protected:
     /// \param pEvent: The associated double click event
     void mouseDoubleClickEvent(QMouseEvent *pEvent) override;
 
+    /// \brief Scrolls the viewport and updates the visible area of the scene
+    /// \param pDx: The horizontal scroll distance in pixels
+    /// \param pDy: The vertical scroll distance in pixels
+    void scrollContentsBy(int pDx, int pDy) override;
+
+    /// \brief Updates the visible area of the scene when the viewport is resized
+    /// \param pEvent: The resize event
+    void resizeEvent(QResizeEvent *pEvent) override;
+
+    /// \brief Paints the scene and measures the frame while render statistics are enabled
+    /// \param pEvent: The paint event
+    void paintEvent(QPaintEvent *pEvent) override;
+
+    /// \brief Draws the scene from the tile cache at coarse zoom levels, otherwise item by item
+    /// \param pEvent: The paint event
+    void PaintScene(QPaintEvent *pEvent);
+
+    /// \brief Draws the statistics of the last frame in the top left corner of the viewport
+    /// \param pStatistics: The render statistics of the scene
+    void DrawRenderStatisticsOverlay(const RenderStatistics &pStatistics);
+
+    /// \brief Draws the background, the grid and all wires of the scene's wire layer
+    /// \param pPainter: The painter to use
+    /// \param pRect: The exposed rectangle in scene coordinates
+    void drawBackground(QPainter *pPainter, const QRectF &pRect) override;
+
+    /// \brief Draws the activity heatmap over the components while profiling a running simulation
+    /// \param pPainter: The painter to use
+    /// \param pRect: The exposed rectangle in scene coordinates
+    void drawForeground(QPainter *pPainter, const QRectF &pRect) override;
+
 protected:
     View &mView;
     CoreLogic &mCoreLogic;
 
+    RenderStatistics *mRenderStatistics = nullptr;
+    QRect mRenderStatisticsRect; // The area of the overlay in viewport coordinates when it was drawn last
+    bool mIsOverlayUpdateRequested = false;
+
+    uint64_t mHeatmapMaxActivity = 0; // Updated with every heatmap refresh, so that partial repaints use the same scale
+
     QPoint mPanStart;
     bool mIsLeftMousePressed;
     bool mIsAddingWire;
@@ -106,6 +164,19 @@ public:
     /// \return A QList of all items in mScene
     QList<QGraphicsItem*> Components(void) const;
 
+    /// \brief Enters the bulk update mode for adding or removing many components at once
+    /// The scene index and scene signals are disabled until the matching EndBulkUpdate call, calls may be nested
+    void BeginBulkUpdate(void);
+
+    /// \brief Leaves the bulk update mode, the scene index is rebuilt once, the suppressed scene signals are emitted once and the scene is repainted
+    void EndBulkUpdate(void);
+
+    /// \brief Removes all items from the scene in bulk update mode, the items are not deleted
+    void RemoveAllComponents(void);
+
+    /// \brief Sets the scene rect to the default canvas, grown to contain all components if they don't fit
+    void FitSceneRect(void);
+
     /// \brief Fades out the overlay that indicates that the SW is loading
     void FadeOutProcessingOverlay(void);
 
@@ -118,12 +189,26 @@ public:
     /// \brief Getter for the current zoom level
     int32_t GetZoomLevel(void);
 
+    /// \brief Writes the recorded render statistics to a CSV file
+    /// \param pFilePath: The path of the CSV file
+    /// \return True, if the file was written successfully
+    bool ExportRenderStatisticsCsv(const QString &pFilePath) const;
+
+    /// \brief Draws the grid lines within the given rectangle in device pixels, using the pen of the current zoom level
+    /// \param pPainter: The painter to use, transformed to scene coordinates
+    /// \param pRect: The exposed rectangle in scene coordinates
+    void DrawGrid(QPainter *pPainter, const QRectF &pRect);
+
     void ShowPieMenu(const QPoint &pPos);
 
     void UpdatePieMenuIcons(void);
 
     PieMenu* GetPieMenu(void);
 
+    /// \brief Getter for the minimap
+    /// \return Pointer to the minimap, or nullptr before Init has been called
+    Minimap* GetMinimap(void);
+
 signals:
     /// \brief Emitted when the scene is zoomed in or out
     /// \param pPercentage: The new zoom percentage
@@ -146,6 +231,18 @@ public slots:
     /// \param pAmount: The amount to decrease the zoom by
     void ZoomOut(int32_t pAmount);
 
+    /// \brief Enables or disables the render statistics and their overlay
+    /// \param pEnabled: If true, render statistics are collected and shown
+    void SetRenderStatisticsEnabled(bool pEnabled);
+
+    /// \brief Shows or hides the minimap
+    /// \param pVisible: If true, the minimap is shown in the bottom right corner of the canvas
+    void SetMinimapVisible(bool pVisible);
+
+    /// \brief Enables or disables tinting the wires on the minimap by their logic state
+    /// \param pTinted: If true, the minimap shows the logic states of the wires
+    void SetMinimapStateTinted(bool pTinted);
+
     /// \brief Disables buttons not available in simulation and disables component selection
     void OnSimulationStart(void);
 
@@ -153,14 +250,12 @@ public slots:
     void OnSimulationStop(void);
 
 protected slots:
-    /// \brief Applies the current transform to the GraphicsView and sets the scene background
+    /// \brief Applies the current transform to the GraphicsView
     void SetupMatrix(void);
 
 protected:
-    /// \brief Creates a grid pattern for the canvas background
-    /// \param pZoomLevel: The zoom level decides whether to draw the grid or not
-    /// \return A pixel map containing a background grid tile
-    QPixmap DrawGridPattern(int32_t pZoomLevel);
+    /// \brief Creates the grid pens of all zoom levels between MIN_ZOOM_LEVEL and MAX_ZOOM_LEVEL
+    void CreateGridPens(void);
 
     void OnPieMenuButtonClicked(int8_t pButtonIndex);
 
@@ -183,7 +278,22 @@ protected:
 
     PieMenu *mPieMenu;
 
+    Minimap *mMinimap = nullptr;
+
+    QTimer mHeatmapTimer; // Repaints the viewport periodically to keep the profiling heatmap up to date
+    QTimer mRenderStatisticsTimer; // Repaints the render statistics overlay periodically
+
     int32_t mZoomLevel = canvas::DEFAULT_ZOOM_LEVEL;
+
+    // One grid pen per zoom level, starting at MIN_ZOOM_LEVEL, Qt::NoPen where the grid is hidden
+    std::vector<QPen> mGridPens;
+    // Kept between paint calls, so that the line buffer is not reallocated every frame
+    std::vector<QLineF> mGridLines;
+
+    // Variables for the bulk update mode
+    uint32_t mBulkUpdateDepth = 0;
+    QGraphicsScene::ItemIndexMethod mBulkUpdateIndexMethod = QGraphicsScene::BspTreeIndex;
+    QList<QGraphicsItem*> mBulkUpdateSelection;
 };
 
 #endif // VIEW_H
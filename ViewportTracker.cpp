@@ -0,0 +1,80 @@
+#include "ViewportTracker.h"
+#include "Components/IBaseComponent.h"
+
+#include <QMetaMethod>
+
+ViewportTracker::ViewportTracker(QGraphicsScene* pScene):
+    QObject(pScene),
+    mScene(pScene)
+{
+    Q_ASSERT(mScene);
+}
+
+bool ViewportTracker::IsVisible(const QRectF& pRect) const
+{
+    return (mVisibleRect.isNull() || mVisibleRect.intersects(pRect));
+}
+
+const QRectF& ViewportTracker::GetVisibleRect() const
+{
+    return mVisibleRect;
+}
+
+void ViewportTracker::SetVisibleRect(const QRectF& pRect)
+{
+    if (pRect == mVisibleRect)
+    {
+        return;
+    }
+
+    const auto oldRect = mVisibleRect;
+    mVisibleRect = pRect;
+
+    if (oldRect.isNull() || !oldRect.intersects(pRect))
+    {
+        ApplyDeferredUpdates(pRect);
+        return;
+    }
+
+    // Components that intersected the old area have never deferred a repaint, so only the exposed strips are searched
+    const auto overlap = oldRect.intersected(pRect);
+
+    if (pRect.top() < overlap.top())
+    {
+        ApplyDeferredUpdates(QRectF(QPointF(pRect.left(), pRect.top()), QPointF(pRect.right(), overlap.top())));
+    }
+    if (pRect.bottom() > overlap.bottom())
+    {
+        ApplyDeferredUpdates(QRectF(QPointF(pRect.left(), overlap.bottom()), QPointF(pRect.right(), pRect.bottom())));
+    }
+    if (pRect.left() < overlap.left())
+    {
+        ApplyDeferredUpdates(QRectF(QPointF(pRect.left(), overlap.top()), QPointF(overlap.left(), overlap.bottom())));
+    }
+    if (pRect.right() > overlap.right())
+    {
+        ApplyDeferredUpdates(QRectF(QPointF(overlap.right(), overlap.top()), QPointF(pRect.right(), overlap.bottom())));
+    }
+}
+
+void ViewportTracker::NotifyUpdateDeferred(const QRectF& pRect)
+{
+    static const auto updateDeferredSignal = QMetaMethod::fromSignal(&ViewportTracker::UpdateDeferredSignal);
+
+    // Deferred repaints happen on every logic state change outside of the view, but are only observed by a state-tinted minimap
+    if (isSignalConnected(updateDeferredSignal))
+    {
+        emit UpdateDeferredSignal(pRect);
+    }
+}
+
+void ViewportTracker::ApplyDeferredUpdates(const QRectF& pRect)
+{
+    for (const auto& item : mScene->items(pRect, Qt::IntersectsItemBoundingRect))
+    {
+        if (auto component = dynamic_cast<IBaseComponent*>(item))
+        {
+            component->ApplyDeferredUpdate();
+        }
+    }
+}
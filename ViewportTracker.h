@@ -0,0 +1,56 @@
+#ifndef VIEWPORTTRACKER_H
+#define VIEWPORTTRACKER_H
+
+#include "SceneHelper.h"
+
+#include <QGraphicsScene>
+#include <QObject>
+#include <QRectF>
+
+///
+/// \brief The ViewportTracker class keeps the area of a scene that is visible in the view.
+/// Components outside of that area defer the repaints of logic state changes, when the visible area changes,
+/// the components in the newly exposed area apply their deferred repaints.
+///
+class ViewportTracker : public QObject, public SceneHelper<ViewportTracker>
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the ViewportTracker
+    /// \param pScene: The scene shown in the view, takes ownership of the tracker
+    ViewportTracker(QGraphicsScene* pScene);
+
+    /// \brief Returns whether the given rectangle intersects the visible area
+    /// \param pRect: A rectangle in scene coordinates
+    /// \return True, if the rectangle is visible or no visible area has been set yet
+    bool IsVisible(const QRectF& pRect) const;
+
+    /// \brief Getter for the visible area
+    /// \return The visible area in scene coordinates, or a null rectangle if no visible area has been set yet
+    const QRectF& GetVisibleRect(void) const;
+
+    /// \brief Sets the visible area and applies the deferred repaints of all components in the newly exposed area
+    /// \param pRect: The visible area in scene coordinates
+    void SetVisibleRect(const QRectF& pRect);
+
+    /// \brief Notifies about a component that has deferred the repaint of a logic state change
+    /// The notification is only emitted while something is connected to UpdateDeferredSignal
+    /// \param pRect: The scene bounding rect of the component
+    void NotifyUpdateDeferred(const QRectF& pRect);
+
+signals:
+    /// \brief Emitted when a component outside of the visible area has deferred the repaint of a logic state change
+    /// \param pRect: The scene bounding rect of the component
+    void UpdateDeferredSignal(const QRectF& pRect);
+
+protected:
+    /// \brief Applies the deferred repaints of all components that intersect the given rectangle
+    /// \param pRect: A rectangle in scene coordinates
+    void ApplyDeferredUpdates(const QRectF& pRect);
+
+protected:
+    QGraphicsScene* mScene;
+    QRectF mVisibleRect;
+};
+
+#endif // VIEWPORTTRACKER_H
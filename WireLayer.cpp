@@ -0,0 +1,105 @@
+#include "WireLayer.h"
+#include "Configuration.h"
+#include "SpatialIndex.h"
+#include "Components/LogicWire.h"
+
+#include <algorithm>
+
+WireLayer::WireLayer(QGraphicsScene* pScene):
+    QObject(pScene),
+    mScene(pScene)
+{
+    Q_ASSERT(pScene);
+}
+
+void WireLayer::AddWire(LogicWire* pWire)
+{
+    Q_ASSERT(pWire);
+
+    if (mWireIndices.count(pWire) > 0)
+    {
+        return;
+    }
+
+    mWireIndices[pWire] = mWires.size();
+    mWires.push_back(pWire);
+}
+
+void WireLayer::RemoveWire(LogicWire* pWire)
+{
+    const auto index = mWireIndices.find(pWire);
+
+    if (index == mWireIndices.end())
+    {
+        return;
+    }
+
+    // Swap with the last wire, the drawing order of wires with the same color doesn't matter
+    mWires[index->second] = mWires.back();
+    mWireIndices[mWires.back()] = index->second;
+    mWires.pop_back();
+    mWireIndices.erase(pWire);
+}
+
+void WireLayer::Paint(QPainter* pPainter, const QRectF& pRect)
+{
+    Q_ASSERT(pPainter);
+
+    for (auto& bucket : mBuckets)
+    {
+        bucket.lines.clear();
+    }
+
+    // Wider than the exposed rect by the pen width, so that line caps at the border are drawn as well
+    const auto visibleRect = pRect.adjusted(-components::wires::WIRE_WIDTH, -components::wires::WIRE_WIDTH,
+                                            components::wires::WIRE_WIDTH, components::wires::WIRE_WIDTH);
+
+    // Only the wires in the exposed rect are visited, the full wire list is a fallback for scenes without a spatial index
+    const auto index = SpatialIndex::FromScene(mScene);
+    const auto wires = (nullptr != index) ? index->GetWires(visibleRect) : mWires;
+
+    for (const auto& wire : wires)
+    {
+        if (!wire->isVisible())
+        {
+            continue;
+        }
+
+        const auto line = wire->GetLine();
+
+        if (std::max(line.x1(), line.x2()) < visibleRect.left() || std::min(line.x1(), line.x2()) > visibleRect.right()
+                || std::max(line.y1(), line.y2()) < visibleRect.top() || std::min(line.y1(), line.y2()) > visibleRect.bottom())
+        {
+            continue;
+        }
+
+        const auto color = wire->GetColor().rgba();
+        auto bucket = std::find_if(mBuckets.begin(), mBuckets.end(), [&](const ColorBucket& pBucket)
+        {
+            return pBucket.color == color;
+        });
+
+        if (bucket == mBuckets.end())
+        {
+            mBuckets.push_back(ColorBucket{color, {}});
+            bucket = mBuckets.end() - 1;
+        }
+
+        bucket->lines.push_back(line);
+    }
+
+    pPainter->save();
+
+    for (const auto& bucket : mBuckets)
+    {
+        if (bucket.lines.empty())
+        {
+            continue;
+        }
+
+        pPainter->setPen(QPen(QColor::fromRgba(bucket.color), components::wires::WIRE_WIDTH, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        pPainter->drawLines(bucket.lines.data(), static_cast<int>(bucket.lines.size()));
+    }
+
+    pPainter->restore();
+}
@@ -0,0 +1,61 @@
+#ifndef WIRELAYER_H
+#define WIRELAYER_H
+
+#include "SceneHelper.h"
+
+#include <QColor>
+#include <QGraphicsScene>
+#include <QLineF>
+#include <QObject>
+#include <QPainter>
+#include <unordered_map>
+#include <vector>
+
+class LogicWire;
+
+///
+/// \brief The WireLayer class draws all wires of a scene below the other components.
+/// Wires are drawn with one drawLines call per wire color instead of one paint call per wire item,
+/// only the wires in the exposed rectangle are queried from the SpatialIndex of the scene.
+/// The wire items have no contents of their own, they are only kept for selection, hit-testing and the logic,
+/// and register with the layer of the scene they are added to.
+///
+class WireLayer : public QObject, public SceneHelper<WireLayer>
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the WireLayer
+    /// \param pScene: The scene containing the wires, takes ownership of the layer
+    WireLayer(QGraphicsScene* pScene);
+
+    /// \brief Adds a wire to the layer
+    /// \param pWire: The wire that has been added to the scene
+    void AddWire(LogicWire* pWire);
+
+    /// \brief Removes a wire from the layer
+    /// \param pWire: The wire that is removed from the scene
+    void RemoveWire(LogicWire* pWire);
+
+    /// \brief Draws all wires that intersect the given rectangle
+    /// \param pPainter: The painter to use, transformed to scene coordinates
+    /// \param pRect: The exposed rectangle in scene coordinates
+    void Paint(QPainter* pPainter, const QRectF& pRect);
+
+protected:
+    /// \brief ColorBucket contains the lines of all visible wires with the same color
+    struct ColorBucket
+    {
+        QRgb color;
+        std::vector<QLineF> lines;
+    };
+
+    QGraphicsScene* mScene;
+
+    std::vector<LogicWire*> mWires;
+    std::unordered_map<LogicWire*, size_t> mWireIndices;
+
+    // Kept between paint calls, so that the line buffers are not reallocated every frame
+    std::vector<ColorBucket> mBuckets;
+};
+
+#endif // WIRELAYER_H
@@ -1,6 +1,10 @@
 #include "Gui/MainWindow.h"
 #include "Configuration.h"
 #include "RuntimeConfigParser.h"
+#include "Benchmark.h"
+#include "LogicCellTracer.h"
+#include "CircuitTracer.h"
+#include "CircuitExporter.h"
 
 #include <QApplication>
 #include <QGraphicsScene>
@@ -8,6 +12,7 @@
 #include <QFileInfo>
 #include <QFontDatabase>
 #include <QCommandLineParser>
+#include <QTextStream>
 
 std::optional<QString> LoadStylesheet(const QString &pPath)
 {
@@ -31,10 +36,53 @@ int main(int argc, char *argv[])
 
     QCommandLineParser parser;
     parser.setApplicationDescription("Linkuit Studio");
-    parser.addPositionalArgument("file", QCoreApplication::translate("file", "Circuit file to open."));
+    parser.addPositionalArgument("file", QCoreApplication::translate("file", "Circuit file to open, or BLIF (.blif) or structural Verilog (.v) netlist to import."));
+
+    QCommandLineOption benchmarkOption("benchmark", QCoreApplication::translate("benchmark", "Run the benchmark on generated circuits and write the results as JSON to <output> (\"-\" for stdout)."), "output");
+    parser.addOption(benchmarkOption);
+
+    QCommandLineOption benchmarkScaleOption("benchmark-scale", QCoreApplication::translate("benchmark-scale", "Factor by which the benchmark circuit sizes are multiplied."), "scale", "1");
+    parser.addOption(benchmarkScaleOption);
+
+    QCommandLineOption recordCellTracesOption("record-cell-traces", QCoreApplication::translate("record-cell-traces", "Record golden traces of all logic cells into <directory>."), "directory");
+    parser.addOption(recordCellTracesOption);
+
+    QCommandLineOption verifyCellTracesOption("verify-cell-traces", QCoreApplication::translate("verify-cell-traces", "Verify the combinational logic cells against their truth tables and all logic cells against the golden traces in <directory>."), "directory");
+    parser.addOption(verifyCellTracesOption);
+
+    QCommandLineOption traceCircuitOption("trace-circuit", QCoreApplication::translate("trace-circuit", "Simulate <file> under random input stimulus and trace all net and output states."), "file");
+    parser.addOption(traceCircuitOption);
+
+    QCommandLineOption traceOutputOption("trace-output", QCoreApplication::translate("trace-output", "Write the circuit trace to <trace>."), "trace");
+    parser.addOption(traceOutputOption);
+
+    QCommandLineOption traceReferenceOption("trace-reference", QCoreApplication::translate("trace-reference", "Compare the circuit trace against the reference <trace> and report the first divergence."), "trace");
+    parser.addOption(traceReferenceOption);
+
+    QCommandLineOption traceTicksOption("trace-ticks", QCoreApplication::translate("trace-ticks", "Number of ticks to trace."), "ticks", QString::number(tracing::CIRCUIT_TRACE_DEFAULT_TICKS));
+    parser.addOption(traceTicksOption);
+
+    QCommandLineOption traceSeedOption("trace-seed", QCoreApplication::translate("trace-seed", "Seed of the random input stimulus."), "seed", QString::number(tracing::CIRCUIT_TRACE_DEFAULT_SEED));
+    parser.addOption(traceSeedOption);
+
+    QCommandLineOption exportImageOption("export-image", QCoreApplication::translate("export-image", "Render the circuit file to the PNG or SVG <image> and exit. Use \"-platform offscreen\" on machines without a display."), "image");
+    parser.addOption(exportImageOption);
+
+    QCommandLineOption exportScaleOption("export-scale", QCoreApplication::translate("export-scale", "Scale of the exported image."), "scale", QString::number(image_export::DEFAULT_SCALE));
+    parser.addOption(exportScaleOption);
 
     parser.process(app);
 
+    if (parser.isSet(recordCellTracesOption))
+    {
+        return LogicCellTracer().RecordTraces(parser.value(recordCellTracesOption)) ? 0 : 1;
+    }
+
+    if (parser.isSet(verifyCellTracesOption))
+    {
+        return LogicCellTracer().VerifyTraces(parser.value(verifyCellTracesOption)) ? 0 : 1;
+    }
+
     QString path = "";
 
     // Reassemble path from possibly multiple parts, split at the spaces
@@ -62,9 +110,91 @@ int main(int argc, char *argv[])
 
     MainWindow window;
 
+    if (parser.isSet(benchmarkOption))
+    {
+        const auto scale = std::max(parser.value(benchmarkScaleOption).toUInt(), 1u);
+        return Benchmark(window.GetCoreLogic()).Run(parser.value(benchmarkOption), scale) ? 0 : 1;
+    }
+
+    if (parser.isSet(traceCircuitOption))
+    {
+        CircuitTracer tracer(window.GetCoreLogic(), window.GetView());
+        const QFileInfo circuit(parser.value(traceCircuitOption));
+
+        if (parser.isSet(traceReferenceOption))
+        {
+            return tracer.Compare(circuit, parser.value(traceReferenceOption)) ? 0 : 1;
+        }
+
+        if (!parser.isSet(traceOutputOption))
+        {
+            QTextStream(stderr) << "Recording a circuit trace requires --trace-output <trace>" << Qt::endl;
+            return 1;
+        }
+
+        return tracer.Record(circuit, parser.value(traceOutputOption), parser.value(traceTicksOption).toUInt(), parser.value(traceSeedOption).toUInt()) ? 0 : 1;
+    }
+
+    if (parser.isSet(exportImageOption))
+    {
+        const QFileInfo circuit(path.trimmed().remove("\""));
+
+        if (!circuit.exists())
+        {
+            QTextStream(stderr) << "Could not find circuit " << circuit.absoluteFilePath() << Qt::endl;
+            return 1;
+        }
+
+        auto& coreLogic = window.GetCoreLogic();
+        QString loadError;
+
+        // Loading errors are reported on the console and end the export, instead of opening message boxes
+        QObject::disconnect(&coreLogic.GetCircuitFileParser(), &CircuitFileParser::LoadCircuitFileFailedSignal, &window, nullptr);
+        QObject::disconnect(&coreLogic, &CoreLogic::FileHasNewerIncompatibleVersionSignal, &window, nullptr);
+
+        QObject::connect(&coreLogic.GetCircuitFileParser(), &CircuitFileParser::LoadCircuitFileFailedSignal, &app, [&]()
+        {
+            loadError = QString("Could not load circuit %0").arg(circuit.absoluteFilePath());
+        });
+        QObject::connect(&coreLogic, &CoreLogic::FileHasNewerIncompatibleVersionSignal, &app, [&](const QString& pVersion)
+        {
+            loadError = QString("Could not load circuit %0, it requires version %1").arg(circuit.absoluteFilePath(), pVersion);
+        });
+
+        coreLogic.NewCircuit();
+        coreLogic.GetCircuitFileParser().LoadJson(circuit);
+
+        if (!loadError.isEmpty())
+        {
+            QTextStream(stderr) << loadError << Qt::endl;
+            return 1;
+        }
+
+        CircuitExporter exporter(*window.GetView().Scene());
+
+        if (!exporter.Export(parser.value(exportImageOption), parser.value(exportScaleOption).toDouble(), false))
+        {
+            QTextStream(stderr) << exporter.GetError() << Qt::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    window.GetCoreLogic().SetInteractive(true);
+
     if (parser.positionalArguments().size() > 0)
     {        
-		window.GetCoreLogic().GetCircuitFileParser().LoadJson(QFileInfo(path.trimmed().remove("\"")));
+        const QFileInfo fileInfo(path.trimmed().remove("\""));
+
+        if (fileInfo.suffix().toLower() == netlist_import::BLIF_SUFFIX || fileInfo.suffix().toLower() == netlist_import::VERILOG_SUFFIX)
+        {
+            window.GetCoreLogic().ImportNetlist(fileInfo);
+        }
+        else
+        {
+            window.GetCoreLogic().LoadCircuitAsync(fileInfo);
+        }
     }
     else
     {